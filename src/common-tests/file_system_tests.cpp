@@ -1,3 +1,93 @@
 #include "common/file_system.h"
+#include "common/path.h"
+#include <algorithm>
 #include <gtest/gtest.h>
 
+namespace {
+class FindFilesTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_root = Path::Combine(FileSystem::GetWorkingDirectory(), "find_files_test");
+    FileSystem::RecursiveDeleteDirectory(m_root.c_str());
+    ASSERT_TRUE(FileSystem::CreateDirectory(Path::Combine(m_root, "a/b").c_str(), true));
+    ASSERT_TRUE(FileSystem::CreateDirectory(Path::Combine(m_root, "c").c_str(), false));
+    for (const char* name : {"root.cue", "root.bin", "a/one.cue", "a/b/two.cue", "c/three.cue"})
+      ASSERT_TRUE(FileSystem::WriteStringToFile(Path::Combine(m_root, name).c_str(), name));
+  }
+
+  void TearDown() override { FileSystem::RecursiveDeleteDirectory(m_root.c_str()); }
+
+  template<typename T>
+  std::vector<std::string> GetSortedNames(const std::vector<T>& results)
+  {
+    std::vector<std::string> names;
+    for (const T& fd : results)
+      names.push_back(Path::ToNativePath(fd.FileName));
+    std::sort(names.begin(), names.end());
+    return names;
+  }
+
+  std::string m_root;
+};
+} // namespace
+
+TEST_F(FindFilesTest, Pattern)
+{
+  FileSystem::FindResultsArray results;
+  ASSERT_TRUE(FileSystem::FindFiles(m_root.c_str(), "*.cue", FILESYSTEM_FIND_FILES, &results));
+  ASSERT_EQ(results.size(), 1u);
+  ASSERT_EQ(results[0].FileName, Path::Combine(m_root, "root.cue"));
+  ASSERT_EQ(results[0].Size, 8);
+  ASSERT_EQ(results[0].Attributes, 0u);
+}
+
+TEST_F(FindFilesTest, Recursive)
+{
+  const std::vector<std::string> expected = {Path::ToNativePath("a/b/two.cue"), Path::ToNativePath("a/one.cue"),
+                                             Path::ToNativePath("c/three.cue"), "root.cue"};
+
+  FileSystem::FindResultsArray results;
+  ASSERT_TRUE(FileSystem::FindFiles(m_root.c_str(), "*.cue",
+                                    FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_RECURSIVE | FILESYSTEM_FIND_RELATIVE_PATHS,
+                                    &results));
+  ASSERT_EQ(GetSortedNames(results), expected);
+
+  ASSERT_TRUE(FileSystem::FindFiles(m_root.c_str(), "*.cue",
+                                    FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_RECURSIVE | FILESYSTEM_FIND_RELATIVE_PATHS |
+                                      FILESYSTEM_FIND_PARALLEL,
+                                    &results));
+  ASSERT_EQ(GetSortedNames(results), expected);
+
+  FileSystem::FindTimestampsArray timestamps;
+  ASSERT_TRUE(FileSystem::FindFileTimestamps(m_root.c_str(), "*.cue",
+                                             FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_RECURSIVE |
+                                               FILESYSTEM_FIND_RELATIVE_PATHS | FILESYSTEM_FIND_PARALLEL,
+                                             &timestamps));
+  ASSERT_EQ(GetSortedNames(timestamps), expected);
+  for (const FILESYSTEM_FIND_TIMESTAMP_DATA& fd : timestamps)
+    ASSERT_NE(fd.ModificationTime, 0);
+}
+
+TEST_F(FindFilesTest, Folders)
+{
+  FileSystem::FindResultsArray results;
+  ASSERT_TRUE(FileSystem::FindFiles(m_root.c_str(), "*",
+                                    FILESYSTEM_FIND_FOLDERS | FILESYSTEM_FIND_RECURSIVE | FILESYSTEM_FIND_RELATIVE_PATHS,
+                                    &results));
+  ASSERT_EQ(GetSortedNames(results),
+            (std::vector<std::string>{"a", Path::ToNativePath("a/b"), "c"}));
+  for (const FILESYSTEM_FIND_DATA& fd : results)
+    ASSERT_NE(fd.Attributes & FILESYSTEM_FILE_ATTRIBUTE_DIRECTORY, 0u);
+}
+
+TEST_F(FindFilesTest, TimestampsFilter)
+{
+  FileSystem::FindTimestampsArray timestamps;
+  ASSERT_TRUE(FileSystem::FindFileTimestamps(
+    m_root.c_str(), "*",
+    FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_RECURSIVE | FILESYSTEM_FIND_RELATIVE_PATHS | FILESYSTEM_FIND_PARALLEL,
+    &timestamps, [](const std::string_view& name) { return (name == "root.bin" || name == "two.cue"); }));
+  ASSERT_EQ(GetSortedNames(timestamps), (std::vector<std::string>{Path::ToNativePath("a/b/two.cue"), "root.bin"}));
+}
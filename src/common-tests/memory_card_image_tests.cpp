@@ -0,0 +1,114 @@
+#include "common/file_system.h"
+#include "common/path.h"
+#include "core/memory_card_image.h"
+#include <gtest/gtest.h>
+
+namespace {
+class MemoryCardFolderTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_root = Path::Combine(FileSystem::GetWorkingDirectory(), "memory_card_folder_test");
+    FileSystem::RecursiveDeleteDirectory(m_root.c_str());
+  }
+
+  void TearDown() override { FileSystem::RecursiveDeleteDirectory(m_root.c_str()); }
+
+  static std::vector<u8> MakeSave(u8 fill)
+  {
+    // Title frame with a single icon frame, followed by the save's data.
+    std::vector<u8> save(MemoryCardImage::BLOCK_SIZE, fill);
+    std::fill(save.begin(), save.begin() + MemoryCardImage::FRAME_SIZE, 0);
+    save[0] = 'S';
+    save[1] = 'C';
+    save[2] = 0x11;
+    return save;
+  }
+
+  static std::vector<u8> ReadSave(const MemoryCardImage::DataArray& card, const std::string_view& name)
+  {
+    std::vector<u8> data;
+    for (const MemoryCardImage::FileInfo& fi : MemoryCardImage::EnumerateFiles(card, false))
+    {
+      if (fi.filename == name)
+        MemoryCardImage::ReadFile(card, fi, &data);
+    }
+
+    return data;
+  }
+
+  std::string m_root;
+};
+} // namespace
+
+TEST_F(MemoryCardFolderTest, SaveAndLoad)
+{
+  MemoryCardImage::DataArray card;
+  MemoryCardImage::Format(&card);
+  ASSERT_TRUE(MemoryCardImage::WriteFile(&card, "BASCUS-94163FF7-S01", MakeSave(1)));
+  ASSERT_TRUE(MemoryCardImage::WriteFile(&card, "BASLUS-00571GAME", MakeSave(2)));
+
+  MemoryCardImage::FolderSaveMap saves;
+  ASSERT_TRUE(MemoryCardImage::SaveToFolder(&card, &saves, m_root.c_str()));
+  EXPECT_TRUE(FileSystem::FileExists(Path::Combine(m_root, "BASCUS-94163FF7-S01.mcs").c_str()));
+  EXPECT_TRUE(FileSystem::FileExists(Path::Combine(m_root, "BASLUS-00571GAME.mcs").c_str()));
+
+  // The second disc of a game finds the save made with the first disc, but not other games' saves.
+  MemoryCardImage::DataArray loaded;
+  MemoryCardImage::FolderSaveMap loaded_saves;
+  MemoryCardImage::LoadFromFolder(&loaded, &loaded_saves, m_root.c_str(), {"SCUS-94163", "SCUS-94164"});
+  ASSERT_EQ(MemoryCardImage::EnumerateFiles(loaded, false).size(), 1u);
+  EXPECT_EQ(ReadSave(loaded, "BASCUS-94163FF7-S01"), MakeSave(1));
+
+  MemoryCardImage::LoadFromFolder(&loaded, &loaded_saves, m_root.c_str(), {});
+  ASSERT_EQ(MemoryCardImage::EnumerateFiles(loaded, false).size(), 2u);
+  EXPECT_EQ(ReadSave(loaded, "BASCUS-94163FF7-S01"), MakeSave(1));
+  EXPECT_EQ(ReadSave(loaded, "BASLUS-00571GAME"), MakeSave(2));
+
+  // Changes to a loaded save go back to the file it came from.
+  for (const MemoryCardImage::FileInfo& fi : MemoryCardImage::EnumerateFiles(loaded, false))
+  {
+    if (fi.filename == "BASLUS-00571GAME")
+    {
+      ASSERT_TRUE(MemoryCardImage::DeleteFile(&loaded, fi, true));
+    }
+  }
+  ASSERT_TRUE(MemoryCardImage::WriteFile(&loaded, "BASLUS-00571GAME", MakeSave(3)));
+  ASSERT_TRUE(MemoryCardImage::SaveToFolder(&loaded, &loaded_saves, m_root.c_str()));
+
+  FileSystem::FindResultsArray files;
+  FileSystem::FindFiles(m_root.c_str(), "*", FILESYSTEM_FIND_FILES, &files);
+  EXPECT_EQ(files.size(), 2u);
+
+  MemoryCardImage::LoadFromFolder(&loaded, &loaded_saves, m_root.c_str(), {"SLUS-00571"});
+  EXPECT_EQ(ReadSave(loaded, "BASLUS-00571GAME"), MakeSave(3));
+}
+
+TEST_F(MemoryCardFolderTest, DoesNotOverwriteUnloadedSaves)
+{
+  MemoryCardImage::DataArray card;
+  MemoryCardImage::Format(&card);
+  ASSERT_TRUE(MemoryCardImage::WriteFile(&card, "BASLUS-00571GAME", MakeSave(1)));
+
+  MemoryCardImage::FolderSaveMap saves;
+  ASSERT_TRUE(MemoryCardImage::SaveToFolder(&card, &saves, m_root.c_str()));
+  const std::string path(Path::Combine(m_root, "BASLUS-00571GAME.mcs"));
+  const std::optional<std::vector<u8>> original(FileSystem::ReadBinaryFile(path.c_str()));
+  ASSERT_TRUE(original.has_value());
+
+  // Another card which didn't load the existing file, e.g. because it was full, creates a save with the same name.
+  MemoryCardImage::DataArray other_card;
+  MemoryCardImage::FolderSaveMap other_saves;
+  MemoryCardImage::LoadFromFolder(&other_card, &other_saves, m_root.c_str(), {"SCUS-94163"});
+  ASSERT_TRUE(MemoryCardImage::WriteFile(&other_card, "BASLUS-00571GAME", MakeSave(2)));
+  ASSERT_TRUE(MemoryCardImage::SaveToFolder(&other_card, &other_saves, m_root.c_str()));
+
+  EXPECT_EQ(FileSystem::ReadBinaryFile(path.c_str()), original);
+
+  const std::string other_path(Path::Combine(m_root, "BASLUS-00571GAME (1).mcs"));
+  ASSERT_TRUE(FileSystem::FileExists(other_path.c_str()));
+  MemoryCardImage::Format(&other_card);
+  ASSERT_TRUE(MemoryCardImage::ImportSave(&other_card, other_path.c_str()));
+  EXPECT_EQ(ReadSave(other_card, "BASLUS-00571GAME"), MakeSave(2));
+}
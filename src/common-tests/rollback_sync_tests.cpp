@@ -0,0 +1,281 @@
+#include "common/rollback_sync.h"
+#include <deque>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace {
+using InputFrame = RollbackSync::InputFrame;
+
+static constexpr u32 MAX_ROLLBACK_FRAMES = 7;
+static constexpr u32 HASH_INTERVAL = 30;
+static constexpr u32 INPUT_DELAY = 1;
+static constexpr u64 INITIAL_STATE = 0xCBF29CE484222325ULL;
+
+// Changes every few frames, so that predictions are sometimes right and sometimes wrong.
+static InputFrame GetLiveInput(u32 player, u32 frame)
+{
+  InputFrame input = {};
+  input[0] = static_cast<u8>(((frame / 4) * 2654435761u + player * 40503u) >> 13);
+  input[1] = static_cast<u8>(player);
+  return input;
+}
+
+static u64 StepState(u64 state, const InputFrame& p1_input, const InputFrame& p2_input)
+{
+  for (const InputFrame* input : {&p1_input, &p2_input})
+  {
+    for (const u8 value : *input)
+      state = (state ^ value) * 0x100000001B3ULL;
+  }
+
+  return state;
+}
+
+static u64 GetExpectedState(u32 frame)
+{
+  // Nothing is pressed for the first frames, because of the input delay.
+  u64 state = INITIAL_STATE;
+  for (u32 i = 0; i < frame; i++)
+  {
+    state = (i < INPUT_DELAY) ? StepState(state, InputFrame{}, InputFrame{}) :
+                                StepState(state, GetLiveInput(0, i), GetLiveInput(1, i));
+  }
+
+  return state;
+}
+
+struct Packet
+{
+  u32 deliver_tick;
+  bool is_hash;
+  u32 start_frame;
+  u32 ack_frame;
+  s32 frame_advantage;
+  std::vector<u8> frames;
+  u32 hash_frame;
+  u64 hash;
+};
+
+/// One side of a session, simulating a system whose state is a hash of every input it has been given.
+class Peer
+{
+public:
+  Peer(u32 player) : m_player(player), m_sync(MAX_ROLLBACK_FRAMES, HASH_INTERVAL)
+  {
+    m_sync.Reset(INPUT_DELAY);
+    m_states.push_back(INITIAL_STATE);
+  }
+
+  void Receive(const Packet& packet)
+  {
+    if (!packet.is_hash)
+    {
+      m_sync.AddRemoteInputs(packet.start_frame, packet.ack_frame, packet.frame_advantage,
+                             static_cast<u32>(packet.frames.size() / sizeof(InputFrame)), packet.frames.data());
+    }
+    else if (!m_sync.AddRemoteHash(packet.hash_frame, packet.hash))
+    {
+      num_desyncs++;
+    }
+  }
+
+  void RunFrame(std::vector<Packet>* outgoing)
+  {
+    if (m_sync.NeedsRollback())
+    {
+      const u32 current_frame = m_sync.GetCurrentFrame();
+      const u32 rollback_frame = m_sync.TakeRollbackFrame();
+      ASSERT_LE(current_frame - rollback_frame, MAX_ROLLBACK_FRAMES + 1);
+      for (u32 frame = rollback_frame; frame < current_frame; frame++)
+        SimulateFrame(frame);
+      num_rollbacks++;
+    }
+
+    const bool stalled = !m_sync.BeginFrame(GetLiveInput(m_player, m_sync.GetLocalFrameCount()));
+
+    Packet input_packet = {};
+    input_packet.start_frame = m_sync.GetUnacknowledgedStartFrame();
+    input_packet.ack_frame = m_sync.GetRemoteFrameCount();
+    input_packet.frame_advantage = m_sync.GetLocalFrameAdvantage();
+    for (u32 i = 0; i < m_sync.GetUnacknowledgedFrameCount(); i++)
+    {
+      const InputFrame& input = m_sync.GetLocalInput(input_packet.start_frame + i);
+      input_packet.frames.insert(input_packet.frames.end(), input.begin(), input.end());
+    }
+    outgoing->push_back(std::move(input_packet));
+
+    if (stalled)
+    {
+      num_stalls++;
+      return;
+    }
+
+    SimulateFrame(m_sync.GetCurrentFrame());
+    m_sync.EndFrame();
+
+    u32 hash_frame;
+    while (m_sync.GetNextHashFrame(&hash_frame))
+    {
+      Packet hash_packet = {};
+      hash_packet.is_hash = true;
+      hash_packet.hash_frame = hash_frame;
+      hash_packet.hash = m_states[hash_frame];
+      outgoing->push_back(std::move(hash_packet));
+      num_hashes++;
+      if (!m_sync.AddLocalHash(hash_frame, m_states[hash_frame]))
+        num_desyncs++;
+    }
+  }
+
+  const RollbackSync& GetSync() const { return m_sync; }
+  u64 GetState(u32 frame) const { return m_states[frame]; }
+
+  u32 corrupt_frame = UINT32_MAX;
+  u32 num_rollbacks = 0;
+  u32 num_stalls = 0;
+  u32 num_hashes = 0;
+  u32 num_desyncs = 0;
+
+private:
+  void SimulateFrame(u32 frame)
+  {
+    const InputFrame& local_input = m_sync.GetLocalInput(frame);
+    const InputFrame& remote_input = m_sync.PredictRemoteInput(frame);
+    u64 state = (m_player == 0) ? StepState(m_states[frame], local_input, remote_input) :
+                                  StepState(m_states[frame], remote_input, local_input);
+    if (frame == corrupt_frame)
+      state ^= 1;
+
+    m_states.resize(frame + 2);
+    m_states[frame + 1] = state;
+  }
+
+  u32 m_player;
+  RollbackSync m_sync;
+  std::vector<u64> m_states;
+};
+
+/// Runs both sides in lockstep, over a link which delays and drops packets.
+class Loopback
+{
+public:
+  Loopback(u32 latency, u32 loss_percent) : m_latency(latency), m_loss_percent(loss_percent) {}
+
+  void Run(u32 num_ticks)
+  {
+    for (u32 i = 0; i < num_ticks; i++, m_tick++)
+    {
+      for (u32 player = 0; player < 2; player++)
+      {
+        std::deque<Packet>& queue = m_queues[player];
+        while (!queue.empty() && queue.front().deliver_tick <= m_tick)
+        {
+          peers[player].Receive(queue.front());
+          queue.pop_front();
+        }
+      }
+
+      for (u32 player = 0; player < 2; player++)
+      {
+        std::vector<Packet> outgoing;
+        peers[player].RunFrame(&outgoing);
+        for (Packet& packet : outgoing)
+        {
+          if ((m_rng() % 100) < m_loss_percent)
+            continue;
+
+          packet.deliver_tick = m_tick + m_latency;
+          m_queues[player ^ 1u].push_back(std::move(packet));
+        }
+      }
+    }
+  }
+
+  void SetLossPercent(u32 loss_percent) { m_loss_percent = loss_percent; }
+
+  Peer peers[2] = {Peer(0), Peer(1)};
+
+private:
+  std::deque<Packet> m_queues[2];
+  std::mt19937 m_rng{1234};
+  u32 m_tick = 0;
+  u32 m_latency;
+  u32 m_loss_percent;
+};
+} // namespace
+
+TEST(RollbackSync, LoopbackConvergesWithLatencyAndLoss)
+{
+  Loopback loopback(3, 20);
+  loopback.Run(600);
+
+  // Let everything in flight arrive, so all of the input is confirmed.
+  loopback.SetLossPercent(0);
+  loopback.Run(60);
+
+  for (const Peer& peer : loopback.peers)
+  {
+    const RollbackSync& sync = peer.GetSync();
+    EXPECT_GT(sync.GetCurrentFrame(), 500u);
+    EXPECT_FALSE(sync.NeedsRollback());
+    EXPECT_GT(peer.num_rollbacks, 0u);
+    EXPECT_GT(peer.num_hashes, 0u);
+    EXPECT_EQ(peer.num_desyncs, 0u);
+
+    const u32 confirmed_frames = std::min(sync.GetCurrentFrame(), sync.GetRemoteFrameCount());
+    for (u32 frame = 0; frame <= confirmed_frames; frame++)
+      ASSERT_EQ(peer.GetState(frame), GetExpectedState(frame)) << "frame " << frame;
+  }
+}
+
+TEST(RollbackSync, StallsWithoutRemoteInput)
+{
+  Peer peer(0);
+  std::vector<Packet> outgoing;
+  for (u32 i = 0; i < 20; i++)
+    peer.RunFrame(&outgoing);
+
+  // Can't predict further than the rollback window.
+  EXPECT_EQ(peer.GetSync().GetCurrentFrame(), MAX_ROLLBACK_FRAMES);
+  EXPECT_EQ(peer.num_stalls, 20 - MAX_ROLLBACK_FRAMES);
+
+  // Unacknowledged input keeps being resent.
+  EXPECT_EQ(outgoing.back().start_frame, 0u);
+  EXPECT_EQ(outgoing.back().frames.size(), (MAX_ROLLBACK_FRAMES + INPUT_DELAY) * sizeof(InputFrame));
+}
+
+TEST(RollbackSync, RollsBackToFirstMispredictedFrame)
+{
+  RollbackSync sync(MAX_ROLLBACK_FRAMES, HASH_INTERVAL);
+  sync.Reset(INPUT_DELAY);
+  for (u32 frame = 0; frame < 4; frame++)
+  {
+    ASSERT_TRUE(sync.BeginFrame(InputFrame{}));
+    sync.PredictRemoteInput(frame);
+    sync.EndFrame();
+  }
+
+  // Nothing was pressed on frame 0, matching the prediction, but frames 1 and 2 differ.
+  std::vector<InputFrame> remote_inputs(3);
+  remote_inputs[1][0] = 1;
+  remote_inputs[2][0] = 1;
+  sync.AddRemoteInputs(0, 0, 0, static_cast<u32>(remote_inputs.size()),
+                       reinterpret_cast<const u8*>(remote_inputs.data()));
+  ASSERT_TRUE(sync.NeedsRollback());
+  EXPECT_EQ(sync.TakeRollbackFrame(), 1u);
+  EXPECT_FALSE(sync.NeedsRollback());
+
+  // Frame 3 is now predicted from the last confirmed input.
+  EXPECT_EQ(sync.PredictRemoteInput(3)[0], 1);
+}
+
+TEST(RollbackSync, LoopbackDetectsDesync)
+{
+  Loopback loopback(2, 0);
+  loopback.peers[1].corrupt_frame = 45;
+  loopback.Run(200);
+
+  EXPECT_GT(loopback.peers[0].num_desyncs, 0u);
+  EXPECT_GT(loopback.peers[1].num_desyncs, 0u);
+}
@@ -6,7 +6,9 @@
 #include <algorithm>
 #include <cstdlib>
 #include <cstring>
+#include <iterator>
 #include <limits>
+#include <type_traits>
 
 #ifdef __APPLE__
 #include <mach-o/dyld.h>
@@ -37,6 +39,7 @@
 #endif
 
 #else
+#include "thirdparty/thread_pool.h"
 #include <dirent.h>
 #include <errno.h>
 #include <fcntl.h>
@@ -1185,6 +1188,32 @@ bool FileSystem::FindFiles(const char* path, const char* pattern, u32 flags, Fin
   return (RecursiveFindFiles(path, nullptr, nullptr, pattern, flags, results) > 0);
 }
 
+bool FileSystem::FindFileTimestamps(const char* path, const char* pattern, u32 flags, FindTimestampsArray* results,
+                                    FindNameFilter filter)
+{
+  // FindFirstFile() returns everything at once, so there's nothing to save by skipping fields or filtering early.
+  FindResultsArray files;
+  if (!FindFiles(path, pattern, flags & ~FILESYSTEM_FIND_KEEP_ARRAY, &files))
+  {
+    if (!(flags & FILESYSTEM_FIND_KEEP_ARRAY))
+      results->clear();
+
+    return false;
+  }
+
+  if (!(flags & FILESYSTEM_FIND_KEEP_ARRAY))
+    results->clear();
+
+  results->reserve(results->size() + files.size());
+  for (FILESYSTEM_FIND_DATA& fd : files)
+  {
+    if (!filter || filter(Path::GetFileName(fd.FileName)))
+      results->push_back(FILESYSTEM_FIND_TIMESTAMP_DATA{fd.ModificationTime, std::move(fd.FileName)});
+  }
+
+  return true;
+}
+
 static void TranslateStat64(struct stat* st, const struct _stat64& st64)
 {
   static constexpr __int64 MAX_SIZE = static_cast<__int64>(std::numeric_limits<decltype(st->st_size)>::max());
@@ -1631,36 +1660,69 @@ bool FileSystem::SetPathCompression(const char* path, bool enable)
 
 #elif !defined(__ANDROID__)
 
-static u32 RecursiveFindFiles(const char* OriginPath, const char* ParentPath, const char* Path, const char* Pattern,
-                              u32 Flags, FileSystem::FindResultsArray* pResults)
+#if defined(__HAIKU__) || defined(__APPLE__) || defined(__FreeBSD__)
+using FindStatData = struct stat;
+#else
+using FindStatData = struct stat64;
+#endif
+
+namespace {
+struct FindParameters
 {
-  std::string tempStr;
-  if (Path)
-  {
-    if (ParentPath)
-      tempStr = StringUtil::StdStringFromFormat("%s/%s/%s", OriginPath, ParentPath, Path);
-    else
-      tempStr = StringUtil::StdStringFromFormat("%s/%s", OriginPath, Path);
-  }
-  else
-  {
-    tempStr = StringUtil::StdStringFromFormat("%s", OriginPath);
-  }
+  const char* origin_path;
+  const char* pattern;
+  FileSystem::FindNameFilter filter;
+  u32 flags;
+  bool has_wildcards;
+  bool wildcard_match_all;
+};
+} // namespace
 
-  DIR* pDir = opendir(tempStr.c_str());
-  if (pDir == nullptr)
+static bool FindStatAt(int dirfd, const char* name, FindStatData* st)
+{
+#if defined(__HAIKU__) || defined(__APPLE__) || defined(__FreeBSD__)
+  return (fstatat(dirfd, name, st, 0) == 0);
+#else
+  return (fstatat64(dirfd, name, st, 0) == 0);
+#endif
+}
+
+static void FillFindData(FILESYSTEM_FIND_DATA* data, const FindStatData& st)
+{
+  data->Size = static_cast<u64>(st.st_size);
+  data->CreationTime = st.st_ctime;
+  data->ModificationTime = st.st_mtime;
+}
+
+static void FillFindData(FILESYSTEM_FIND_TIMESTAMP_DATA* data, const FindStatData& st)
+{
+  data->ModificationTime = st.st_mtime;
+}
+
+// Directories are opened relative to their parent, and entries are stat'ed relative to the directory, so the kernel
+// doesn't have to walk the full path for every file. If deferred_directories is set, subdirectories are returned to
+// the caller instead of being searched.
+template<typename T>
+static u32 RecursiveFindFiles(const FindParameters& params, int parent_fd, const std::string& path,
+                              std::vector<T>* results, std::vector<std::string>* deferred_directories)
+{
+  // path is relative to the origin, but only the last component is needed when opening relative to the parent
+  const char* name = path.c_str() + (path.rfind('/') + 1);
+  const int fd = (parent_fd < 0) ? open(params.origin_path, O_RDONLY | O_DIRECTORY | O_CLOEXEC) :
+                                   openat(parent_fd, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (fd < 0)
     return 0;
 
-  // small speed optimization for '*' case
-  bool hasWildCards = false;
-  bool wildCardMatchAll = false;
-  u32 nFiles = 0;
-  if (std::strpbrk(Pattern, "*?"))
+  DIR* pDir = fdopendir(fd);
+  if (pDir == nullptr)
   {
-    hasWildCards = true;
-    wildCardMatchAll = (std::strcmp(Pattern, "*") == 0);
+    close(fd);
+    return 0;
   }
 
+  u32 nFiles = 0;
+  std::string subdirectory;
+
   // iterate results
   struct dirent* pDirEnt;
   while ((pDirEnt = readdir(pDir)) != nullptr)
@@ -1670,111 +1732,173 @@ static u32 RecursiveFindFiles(const char* OriginPath, const char* ParentPath, co
       if (pDirEnt->d_name[1] == '\0' || (pDirEnt->d_name[1] == '.' && pDirEnt->d_name[2] == '\0'))
         continue;
 
-      if (!(Flags & FILESYSTEM_FIND_HIDDEN_FILES))
+      if (!(params.flags & FILESYSTEM_FIND_HIDDEN_FILES))
         continue;
     }
 
-    std::string full_path;
-    if (ParentPath != nullptr)
-      full_path = StringUtil::StdStringFromFormat("%s/%s/%s/%s", OriginPath, ParentPath, Path, pDirEnt->d_name);
-    else if (Path != nullptr)
-      full_path = StringUtil::StdStringFromFormat("%s/%s/%s", OriginPath, Path, pDirEnt->d_name);
+    // d_type saves a stat() for directories and for files which don't match, but not all filesystems provide it.
+    FindStatData sDir;
+    bool has_stat = false;
+    bool is_directory;
+#ifndef __HAIKU__
+    if (pDirEnt->d_type == DT_DIR || pDirEnt->d_type == DT_REG)
+    {
+      is_directory = (pDirEnt->d_type == DT_DIR);
+    }
     else
-      full_path = StringUtil::StdStringFromFormat("%s/%s", OriginPath, pDirEnt->d_name);
-
-    FILESYSTEM_FIND_DATA outData;
-    outData.Attributes = 0;
-
-#if defined(__HAIKU__) || defined(__APPLE__) || defined(__FreeBSD__)
-    struct stat sDir;
-    if (stat(full_path.c_str(), &sDir) < 0)
-      continue;
-
-#else
-    struct stat64 sDir;
-    if (stat64(full_path.c_str(), &sDir) < 0)
-      continue;
 #endif
+    {
+      // symlinks are followed, same as stat()
+      if (!FindStatAt(fd, pDirEnt->d_name, &sDir))
+        continue;
+
+      has_stat = true;
+      is_directory = S_ISDIR(sDir.st_mode);
+    }
 
-    if (S_ISDIR(sDir.st_mode))
+    if (is_directory)
     {
-      if (Flags & FILESYSTEM_FIND_RECURSIVE)
+      if (params.flags & FILESYSTEM_FIND_RECURSIVE)
       {
         // recurse into this directory
-        if (ParentPath != nullptr)
-        {
-          std::string recursiveDir = StringUtil::StdStringFromFormat("%s/%s", ParentPath, Path);
-          nFiles += RecursiveFindFiles(OriginPath, recursiveDir.c_str(), pDirEnt->d_name, Pattern, Flags, pResults);
-        }
+        if (path.empty())
+          subdirectory = pDirEnt->d_name;
         else
-        {
-          nFiles += RecursiveFindFiles(OriginPath, Path, pDirEnt->d_name, Pattern, Flags, pResults);
-        }
+          subdirectory = StringUtil::StdStringFromFormat("%s/%s", path.c_str(), pDirEnt->d_name);
+
+        if (deferred_directories)
+          deferred_directories->push_back(std::move(subdirectory));
+        else
+          nFiles += RecursiveFindFiles(params, fd, subdirectory, results, nullptr);
       }
 
-      if (!(Flags & FILESYSTEM_FIND_FOLDERS))
+      if (!(params.flags & FILESYSTEM_FIND_FOLDERS))
         continue;
-
-      outData.Attributes |= FILESYSTEM_FILE_ATTRIBUTE_DIRECTORY;
     }
     else
     {
-      if (!(Flags & FILESYSTEM_FIND_FILES))
+      if (!(params.flags & FILESYSTEM_FIND_FILES))
         continue;
     }
 
-    outData.Size = static_cast<u64>(sDir.st_size);
-    outData.CreationTime = sDir.st_ctime;
-    outData.ModificationTime = sDir.st_mtime;
-
     // match the filename
-    if (hasWildCards)
+    if (params.has_wildcards)
     {
-      if (!wildCardMatchAll && !StringUtil::WildcardMatch(pDirEnt->d_name, Pattern))
+      if (!params.wildcard_match_all && !StringUtil::WildcardMatch(pDirEnt->d_name, params.pattern))
         continue;
     }
     else
     {
-      if (std::strcmp(pDirEnt->d_name, Pattern) != 0)
+      if (std::strcmp(pDirEnt->d_name, params.pattern) != 0)
         continue;
     }
 
+    if (params.filter && !is_directory && !params.filter(pDirEnt->d_name))
+      continue;
+
+    if (!has_stat && !FindStatAt(fd, pDirEnt->d_name, &sDir))
+      continue;
+
+    T outData = {};
+    if constexpr (std::is_same_v<T, FILESYSTEM_FIND_DATA>)
+    {
+      if (is_directory)
+        outData.Attributes |= FILESYSTEM_FILE_ATTRIBUTE_DIRECTORY;
+    }
+
+    FillFindData(&outData, sDir);
+
     // add file to list
-    // TODO string formatter, clean this mess..
-    if (!(Flags & FILESYSTEM_FIND_RELATIVE_PATHS))
+    if (!(params.flags & FILESYSTEM_FIND_RELATIVE_PATHS))
     {
-      outData.FileName = std::move(full_path);
+      if (!path.empty())
+        outData.FileName =
+          StringUtil::StdStringFromFormat("%s/%s/%s", params.origin_path, path.c_str(), pDirEnt->d_name);
+      else
+        outData.FileName = StringUtil::StdStringFromFormat("%s/%s", params.origin_path, pDirEnt->d_name);
     }
     else
     {
-      if (ParentPath != nullptr)
-        outData.FileName = StringUtil::StdStringFromFormat("%s/%s/%s", ParentPath, Path, pDirEnt->d_name);
-      else if (Path != nullptr)
-        outData.FileName = StringUtil::StdStringFromFormat("%s/%s", Path, pDirEnt->d_name);
+      if (!path.empty())
+        outData.FileName = StringUtil::StdStringFromFormat("%s/%s", path.c_str(), pDirEnt->d_name);
       else
         outData.FileName = pDirEnt->d_name;
     }
 
     nFiles++;
-    pResults->push_back(std::move(outData));
+    results->push_back(std::move(outData));
   }
 
   closedir(pDir);
   return nFiles;
 }
 
-bool FileSystem::FindFiles(const char* Path, const char* Pattern, u32 Flags, FindResultsArray* pResults)
+template<typename T>
+static bool FindFilesImpl(const char* path, const char* pattern, u32 flags, std::vector<T>* results,
+                          FileSystem::FindNameFilter filter)
 {
   // has a path
-  if (Path[0] == '\0')
+  if (path[0] == '\0')
     return false;
 
   // clear result array
-  if (!(Flags & FILESYSTEM_FIND_KEEP_ARRAY))
-    pResults->clear();
+  if (!(flags & FILESYSTEM_FIND_KEEP_ARRAY))
+    results->clear();
 
-  // enter the recursive function
-  return (RecursiveFindFiles(Path, nullptr, nullptr, Pattern, Flags, pResults) > 0);
+  // small speed optimization for '*' case
+  FindParameters params = {path, pattern, filter, flags, false, false};
+  if (std::strpbrk(pattern, "*?"))
+  {
+    params.has_wildcards = true;
+    params.wildcard_match_all = (std::strcmp(pattern, "*") == 0);
+  }
+
+  if (!(flags & FILESYSTEM_FIND_PARALLEL) || !(flags & FILESYSTEM_FIND_RECURSIVE))
+    return (RecursiveFindFiles(params, -1, std::string(), results, nullptr) > 0);
+
+  // Search each top-level directory on a worker, which helps most when the latency of each call is high (e.g. NFS).
+  std::vector<std::string> directories;
+  u32 nFiles = RecursiveFindFiles(params, -1, std::string(), results, &directories);
+  if (directories.empty())
+    return (nFiles > 0);
+
+  // The top-level directory was closed after the first pass, so each worker reopens it.
+  const std::string origin_path(path);
+  std::vector<std::vector<T>> directory_results(directories.size());
+  {
+    cb::ThreadPool pool(static_cast<int>(
+      std::min<size_t>(directories.size(), std::max(cb::ThreadPool::GetNumLogicalCores(), 1u))));
+    for (size_t i = 0; i < directories.size(); i++)
+    {
+      pool.Schedule([&params, &origin_path, &directories, &directory_results, i]() {
+        const int fd = open(origin_path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0)
+          return;
+
+        RecursiveFindFiles(params, fd, directories[i], &directory_results[i], nullptr);
+        close(fd);
+      });
+    }
+  }
+
+  for (std::vector<T>& dr : directory_results)
+  {
+    nFiles += static_cast<u32>(dr.size());
+    std::move(dr.begin(), dr.end(), std::back_inserter(*results));
+  }
+
+  return (nFiles > 0);
+}
+
+bool FileSystem::FindFiles(const char* Path, const char* Pattern, u32 Flags, FindResultsArray* pResults)
+{
+  return FindFilesImpl(Path, Pattern, Flags, pResults, nullptr);
+}
+
+bool FileSystem::FindFileTimestamps(const char* path, const char* pattern, u32 flags, FindTimestampsArray* results,
+                                    FindNameFilter filter)
+{
+  return FindFilesImpl(path, pattern, flags, results, filter);
 }
 
 bool FileSystem::StatFile(const char* path, struct stat* st)
@@ -2029,7 +2153,7 @@ bool FileSystem::DeleteDirectory(const char* path)
   if (stat(path, &sysStatData) != 0 || !S_ISDIR(sysStatData.st_mode))
     return false;
 
-  return (unlink(path) == 0);
+  return (rmdir(path) == 0);
 }
 
 std::string FileSystem::GetProgramPath()
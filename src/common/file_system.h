@@ -31,6 +31,7 @@ enum FILESYSTEM_FIND_FLAGS
   FILESYSTEM_FIND_FOLDERS = (1 << 3),
   FILESYSTEM_FIND_FILES = (1 << 4),
   FILESYSTEM_FIND_KEEP_ARRAY = (1 << 5),
+  FILESYSTEM_FIND_PARALLEL = (1 << 6), // recurse into subdirectories on worker threads, results are unordered
 };
 
 struct FILESYSTEM_STAT_DATA
@@ -50,8 +51,18 @@ struct FILESYSTEM_FIND_DATA
   u32 Attributes;
 };
 
+struct FILESYSTEM_FIND_TIMESTAMP_DATA
+{
+  std::time_t ModificationTime;
+  std::string FileName;
+};
+
 namespace FileSystem {
 using FindResultsArray = std::vector<FILESYSTEM_FIND_DATA>;
+using FindTimestampsArray = std::vector<FILESYSTEM_FIND_TIMESTAMP_DATA>;
+
+/// Called with the name of each file, without its directory, to decide whether it should be returned.
+using FindNameFilter = bool (*)(const std::string_view& name);
 
 /// Returns the display name of a filename. Usually this is the same as the path.
 std::string GetDisplayNameFromPath(const std::string_view& path);
@@ -62,6 +73,11 @@ std::vector<std::string> GetRootDirectoryList();
 /// Search for files
 bool FindFiles(const char* path, const char* pattern, u32 flags, FindResultsArray* results);
 
+/// Search for files, only returning names and modification times. Cheaper than FindFiles() when used for detecting
+/// changes to a directory. Files rejected by the filter are skipped before they're stat'ed.
+bool FindFileTimestamps(const char* path, const char* pattern, u32 flags, FindTimestampsArray* results,
+                        FindNameFilter filter = nullptr);
+
 /// Stat file
 bool StatFile(const char* path, struct stat* st);
 bool StatFile(std::FILE* fp, struct stat* st);
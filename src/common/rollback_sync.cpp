@@ -0,0 +1,161 @@
+#include "rollback_sync.h"
+#include "assert.h"
+#include <algorithm>
+#include <cstring>
+
+RollbackSync::RollbackSync(u32 max_rollback_frames, u32 hash_interval)
+  : m_max_rollback_frames(max_rollback_frames), m_hash_interval(hash_interval)
+{
+  static_assert((INPUT_RING_SIZE & (INPUT_RING_SIZE - 1)) == 0, "Input ring size is a power of two");
+}
+
+void RollbackSync::Reset(u32 input_delay)
+{
+  m_current_frame = 0;
+  m_local_inputs = {};
+  m_remote_inputs = {};
+  m_remote_used_inputs = {};
+  m_remote_ack = 0;
+  m_remote_frame_count = 0;
+  m_rollback_frame = UINT32_MAX;
+  m_remote_frame_advantage = 0;
+  m_last_time_sync_frame = 0;
+  m_next_hash_frame = m_hash_interval;
+  m_local_hashes = {};
+  m_remote_hashes = {};
+
+  // The first frames of local input are empty, because of the delay.
+  m_local_frame_count = input_delay;
+}
+
+s32 RollbackSync::GetLocalFrameAdvantage() const
+{
+  // Includes the latency and input delay, but that's the same for both sides, so it cancels out when compared.
+  return std::clamp(static_cast<s32>(m_current_frame) - static_cast<s32>(m_remote_frame_count), -127, 127);
+}
+
+u32 RollbackSync::GetUnacknowledgedFrameCount() const
+{
+  return std::min<u32>(m_local_frame_count - m_remote_ack, MAX_FRAMES_PER_PACKET);
+}
+
+const RollbackSync::InputFrame& RollbackSync::GetLocalInput(u32 frame) const
+{
+  return m_local_inputs[frame % INPUT_RING_SIZE];
+}
+
+const RollbackSync::InputFrame& RollbackSync::GetRemoteUsedInput(u32 frame) const
+{
+  return m_remote_used_inputs[frame % INPUT_RING_SIZE];
+}
+
+void RollbackSync::AddRemoteInputs(u32 start_frame, u32 ack_frame, s32 frame_advantage, u32 num_frames,
+                                   const u8* frames)
+{
+  m_remote_ack = std::min(std::max(m_remote_ack, ack_frame), m_local_frame_count);
+  m_remote_frame_advantage = frame_advantage;
+
+  for (u32 i = 0; i < num_frames; i++)
+  {
+    const u32 frame = start_frame + i;
+    if (frame < m_remote_frame_count)
+      continue;
+    else if (frame > m_remote_frame_count)
+      break;
+
+    InputFrame& input = m_remote_inputs[frame % INPUT_RING_SIZE];
+    std::memcpy(input.data(), frames + i * sizeof(InputFrame), sizeof(InputFrame));
+    m_remote_frame_count++;
+
+    // Did we guess wrong?
+    if (frame < m_current_frame && input != m_remote_used_inputs[frame % INPUT_RING_SIZE])
+      m_rollback_frame = std::min(m_rollback_frame, frame);
+  }
+}
+
+u32 RollbackSync::TakeRollbackFrame()
+{
+  const u32 frame = m_rollback_frame;
+  m_rollback_frame = UINT32_MAX;
+  return frame;
+}
+
+bool RollbackSync::BeginFrame(const InputFrame& live_input)
+{
+  // Don't run too far ahead of the other player, otherwise we wouldn't be able to roll back.
+  bool stalled = (m_current_frame >= (m_remote_frame_count + m_max_rollback_frames) ||
+                  (m_local_frame_count - m_remote_ack) >= (INPUT_RING_SIZE - 1));
+
+  // If we're running faster than the other player, wait a frame every so often for them to catch up. Otherwise we'd
+  // be constantly predicting and rolling back.
+  if (!stalled && (m_current_frame - m_last_time_sync_frame) >= TIME_SYNC_INTERVAL &&
+      ((GetLocalFrameAdvantage() - m_remote_frame_advantage) / 2) >= 1)
+  {
+    m_last_time_sync_frame = m_current_frame;
+    stalled = true;
+  }
+  if (stalled)
+    return false;
+
+  m_local_inputs[m_local_frame_count % INPUT_RING_SIZE] = live_input;
+  m_local_frame_count++;
+  DebugAssert(m_local_frame_count > m_current_frame);
+  return true;
+}
+
+const RollbackSync::InputFrame& RollbackSync::PredictRemoteInput(u32 frame)
+{
+  // Predict that the remote player is still holding whatever they were last.
+  InputFrame& used = m_remote_used_inputs[frame % INPUT_RING_SIZE];
+  if (frame < m_remote_frame_count)
+    used = m_remote_inputs[frame % INPUT_RING_SIZE];
+  else if (m_remote_frame_count > 0)
+    used = m_remote_inputs[(m_remote_frame_count - 1) % INPUT_RING_SIZE];
+  else
+    used = {};
+
+  return used;
+}
+
+void RollbackSync::EndFrame()
+{
+  m_current_frame++;
+}
+
+bool RollbackSync::GetNextHashFrame(u32* frame)
+{
+  while (m_next_hash_frame < m_current_frame && m_next_hash_frame <= m_remote_frame_count)
+  {
+    const u32 next_frame = m_next_hash_frame;
+    m_next_hash_frame += m_hash_interval;
+
+    // Fell out of the rollback window?
+    if ((m_current_frame - next_frame) > (m_max_rollback_frames + 1))
+      continue;
+
+    *frame = next_frame;
+    return true;
+  }
+
+  return false;
+}
+
+bool RollbackSync::AddLocalHash(u32 frame, u64 hash)
+{
+  m_local_hashes[(frame / m_hash_interval) % NUM_STATE_HASHES] = {frame, hash, true};
+  return CompareStateHashes(frame);
+}
+
+bool RollbackSync::AddRemoteHash(u32 frame, u64 hash)
+{
+  m_remote_hashes[(frame / m_hash_interval) % NUM_STATE_HASHES] = {frame, hash, true};
+  return CompareStateHashes(frame);
+}
+
+bool RollbackSync::CompareStateHashes(u32 frame) const
+{
+  const u32 index = (frame / m_hash_interval) % NUM_STATE_HASHES;
+  const StateHash& local = m_local_hashes[index];
+  const StateHash& remote = m_remote_hashes[index];
+  return (!local.valid || !remote.valid || local.frame != frame || remote.frame != frame || local.hash == remote.hash);
+}
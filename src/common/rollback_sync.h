@@ -0,0 +1,119 @@
+#pragma once
+#include "types.h"
+#include <array>
+
+/// Frame and input bookkeeping for two-player rollback netplay, independent of the transport and the emulated system.
+/// Local input is delayed by a fixed number of frames, and remote input which hasn't arrived yet is predicted by
+/// repeating the last confirmed input. When the real input contradicts a prediction, the caller restores the state from
+/// before the first mispredicted frame, and re-simulates up to the current frame.
+class RollbackSync
+{
+public:
+  enum : u32
+  {
+    INPUT_FRAME_SIZE = 32,
+
+    // Must be a power of two, and larger than the number of frames which can be in flight.
+    INPUT_RING_SIZE = 128,
+
+    MAX_FRAMES_PER_PACKET = 16,
+
+    // Minimum number of frames between waits for the other player to catch up.
+    TIME_SYNC_INTERVAL = 10,
+
+    NUM_STATE_HASHES = 8,
+  };
+
+  using InputFrame = std::array<u8, INPUT_FRAME_SIZE>;
+
+  /// States must be kept for the last max_rollback_frames + 1 frames. Confirmed states are hashed every hash_interval
+  /// frames.
+  RollbackSync(u32 max_rollback_frames, u32 hash_interval);
+
+  /// Starts a new session from frame zero. Both sides must use the same input delay.
+  void Reset(u32 input_delay);
+
+  ALWAYS_INLINE u32 GetCurrentFrame() const { return m_current_frame; }
+  ALWAYS_INLINE u32 GetLocalFrameCount() const { return m_local_frame_count; }
+  ALWAYS_INLINE u32 GetRemoteFrameCount() const { return m_remote_frame_count; }
+
+  /// Returns how far ahead of the other player we are, to be sent along with input.
+  s32 GetLocalFrameAdvantage() const;
+
+  /// Returns the local input frames which the other side hasn't acknowledged yet, capped to what fits in a packet.
+  /// Input is resent until it is acknowledged, since packets can be lost.
+  ALWAYS_INLINE u32 GetUnacknowledgedStartFrame() const { return m_remote_ack; }
+  u32 GetUnacknowledgedFrameCount() const;
+
+  const InputFrame& GetLocalInput(u32 frame) const;
+  const InputFrame& GetRemoteUsedInput(u32 frame) const;
+
+  /// Handles input received from the other side. ack_frame is the number of our frames they have received.
+  void AddRemoteInputs(u32 start_frame, u32 ack_frame, s32 frame_advantage, u32 num_frames, const u8* frames);
+
+  /// Returns true if a prediction was wrong, and the frames from TakeRollbackFrame() need to be re-simulated.
+  ALWAYS_INLINE bool NeedsRollback() const { return (m_rollback_frame < m_current_frame); }
+
+  /// Returns the earliest mispredicted frame, and forgets it. The state from before that frame should be restored.
+  u32 TakeRollbackFrame();
+
+  /// Decides whether the current frame can be run. If so, live_input is queued as the local input for the frame which
+  /// is input delay frames ahead. Returns false if we're too far ahead of the other player, and should wait.
+  bool BeginFrame(const InputFrame& live_input);
+
+  /// Returns the remote input to simulate a frame with, either the real input or a prediction. Also used when
+  /// re-simulating.
+  const InputFrame& PredictRemoteInput(u32 frame);
+
+  /// Moves on to the next frame, once the current frame has been simulated.
+  void EndFrame();
+
+  /// Returns the next frame whose state is confirmed, i.e. all of the input before it is known and it has been
+  /// re-simulated, and which should be hashed and sent to the other side. Call until it returns false.
+  bool GetNextHashFrame(u32* frame);
+
+  /// Records the hash of a confirmed state from either side. Returns false if both sides' hashes for the frame are
+  /// known and differ, i.e. the sessions have desynced.
+  bool AddLocalHash(u32 frame, u64 hash);
+  bool AddRemoteHash(u32 frame, u64 hash);
+
+private:
+  struct StateHash
+  {
+    u32 frame;
+    u64 hash;
+    bool valid;
+  };
+
+  bool CompareStateHashes(u32 frame) const;
+
+  u32 m_max_rollback_frames;
+  u32 m_hash_interval;
+
+  // Frame to be simulated next.
+  u32 m_current_frame = 0;
+
+  // Local input is generated ahead of the current frame by the input delay.
+  std::array<InputFrame, INPUT_RING_SIZE> m_local_inputs = {};
+  u32 m_local_frame_count = 0;
+
+  // Number of local frames the other side has confirmed receiving.
+  u32 m_remote_ack = 0;
+
+  // Remote inputs are contiguous from zero to m_remote_frame_count, and what we used for each simulated frame is kept
+  // so mispredictions can be detected when the real input arrives.
+  std::array<InputFrame, INPUT_RING_SIZE> m_remote_inputs = {};
+  std::array<InputFrame, INPUT_RING_SIZE> m_remote_used_inputs = {};
+  u32 m_remote_frame_count = 0;
+
+  // Earliest frame which was simulated with a wrong prediction.
+  u32 m_rollback_frame = UINT32_MAX;
+
+  // How far ahead the other player thinks they are of us, and when we last waited for them.
+  s32 m_remote_frame_advantage = 0;
+  u32 m_last_time_sync_frame = 0;
+
+  u32 m_next_hash_frame = 0;
+  std::array<StateHash, NUM_STATE_HASHES> m_local_hashes = {};
+  std::array<StateHash, NUM_STATE_HASHES> m_remote_hashes = {};
+};
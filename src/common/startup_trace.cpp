@@ -0,0 +1,142 @@
+#include "startup_trace.h"
+#include "file_system.h"
+#include "log.h"
+#include "fmt/format.h"
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <mutex>
+#include <vector>
+Log_SetChannel(StartupTrace);
+
+namespace StartupTrace {
+
+namespace {
+struct Event
+{
+  const char* name;
+  Common::Timer::Value start_time;
+  Common::Timer::Value end_time;
+  u32 thread_index;
+  bool instant;
+};
+} // namespace
+
+static u32 GetThreadIndex();
+static void AddEvent(const char* name, Common::Timer::Value start_time, Common::Timer::Value end_time, bool instant);
+
+static std::atomic_bool s_active{false};
+static std::mutex s_mutex;
+static std::string s_filename;
+static Common::Timer::Value s_start_time = 0;
+static std::vector<Event> s_events;
+static std::atomic<u32> s_next_thread_index{0};
+
+} // namespace StartupTrace
+
+u32 StartupTrace::GetThreadIndex()
+{
+  // Small sequential IDs are easier to read in the viewer than native thread IDs.
+  static thread_local u32 index = s_next_thread_index.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+void StartupTrace::AddEvent(const char* name, Common::Timer::Value start_time, Common::Timer::Value end_time,
+                            bool instant)
+{
+  const u32 thread_index = GetThreadIndex();
+
+  std::unique_lock lock(s_mutex);
+  if (!s_active.load(std::memory_order_relaxed))
+    return;
+
+  s_events.push_back(Event{name, start_time, end_time, thread_index, instant});
+}
+
+void StartupTrace::Start(std::string filename)
+{
+  std::unique_lock lock(s_mutex);
+  s_filename = std::move(filename);
+  s_start_time = Common::Timer::GetCurrentValue();
+  s_events.clear();
+  s_active.store(true, std::memory_order_release);
+  Log_InfoPrintf("Recording startup trace to '%s'", s_filename.c_str());
+}
+
+bool StartupTrace::IsActive()
+{
+  return s_active.load(std::memory_order_acquire);
+}
+
+void StartupTrace::Mark(const char* name)
+{
+  if (!IsActive())
+    return;
+
+  const Common::Timer::Value time = Common::Timer::GetCurrentValue();
+  AddEvent(name, time, time, true);
+}
+
+void StartupTrace::Finish()
+{
+  std::unique_lock lock(s_mutex);
+  if (!s_active.load(std::memory_order_relaxed))
+    return;
+
+  s_active.store(false, std::memory_order_release);
+
+  const auto to_us = [](Common::Timer::Value value) {
+    return Common::Timer::ConvertValueToNanoseconds(value - s_start_time) / 1000.0;
+  };
+
+  std::string json("{\"traceEvents\":[\n");
+  for (const Event& ev : s_events)
+  {
+    if (ev.instant)
+    {
+      fmt::format_to(std::back_inserter(json),
+                     "{{\"name\":\"{}\",\"ph\":\"i\",\"s\":\"g\",\"ts\":{:.1f},\"pid\":1,\"tid\":{}}},\n", ev.name,
+                     to_us(ev.start_time), ev.thread_index);
+    }
+    else
+    {
+      fmt::format_to(std::back_inserter(json),
+                     "{{\"name\":\"{}\",\"ph\":\"X\",\"ts\":{:.1f},\"dur\":{:.1f},\"pid\":1,\"tid\":{}}},\n", ev.name,
+                     to_us(ev.start_time), to_us(ev.end_time) - to_us(ev.start_time), ev.thread_index);
+    }
+  }
+  if (!s_events.empty())
+    json.erase(json.size() - 2, 1);
+  json += "]}\n";
+
+  if (!FileSystem::WriteStringToFile(s_filename.c_str(), json))
+    Log_ErrorPrintf("Failed to write startup trace to '%s'", s_filename.c_str());
+
+  // Summarize the slowest phases in the log as well, so a trace viewer isn't needed for a quick look.
+  std::sort(s_events.begin(), s_events.end(), [](const Event& lhs, const Event& rhs) {
+    return (lhs.end_time - lhs.start_time) > (rhs.end_time - rhs.start_time);
+  });
+  for (const Event& ev : s_events)
+  {
+    if (ev.instant)
+      continue;
+
+    Log_InfoPrintf("%-24s %8.2f ms (thread %u, started at %.2f ms)", ev.name,
+                   Common::Timer::ConvertValueToMilliseconds(ev.end_time - ev.start_time), ev.thread_index,
+                   to_us(ev.start_time) / 1000.0);
+  }
+
+  s_events = {};
+  s_filename = {};
+}
+
+StartupTrace::Phase::Phase(const char* name)
+  : m_name(IsActive() ? name : nullptr), m_start_time(m_name ? Common::Timer::GetCurrentValue() : 0)
+{
+}
+
+StartupTrace::Phase::~Phase()
+{
+  if (m_name)
+    AddEvent(m_name, m_start_time, Common::Timer::GetCurrentValue(), false);
+}
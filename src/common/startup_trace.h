@@ -0,0 +1,38 @@
+#pragma once
+#include "timer.h"
+#include "types.h"
+#include <string>
+
+/// Records how long each phase of startup takes, up to the first emulated frame and the deferred work after it.
+/// Phases can run on any thread, and are written as a Chrome trace event file (chrome://tracing or Perfetto).
+namespace StartupTrace {
+
+/// Starts recording phases. The trace is written to filename when Finish() is called.
+void Start(std::string filename);
+
+/// Returns true if phases are being recorded.
+bool IsActive();
+
+/// Records a single point in time, e.g. the first frame.
+void Mark(const char* name);
+
+/// Writes the trace file, and stops recording. Phases which are still running are not included.
+void Finish();
+
+/// Records a phase for the lifetime of the object. Does nothing when not recording. Names are not copied, so they
+/// should be string literals.
+class Phase
+{
+public:
+  Phase(const char* name);
+  ~Phase();
+
+  Phase(const Phase&) = delete;
+  Phase& operator=(const Phase&) = delete;
+
+private:
+  const char* m_name;
+  Common::Timer::Value m_start_time;
+};
+
+} // namespace StartupTrace
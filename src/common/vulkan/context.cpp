@@ -290,7 +290,8 @@ Context::GPUNameList Context::EnumerateGPUNames(VkInstance instance)
 }
 
 bool Context::Create(std::string_view gpu_name, const WindowInfo* wi, std::unique_ptr<SwapChain>* out_swap_chain,
-                     bool threaded_presentation, bool enable_debug_utils, bool enable_validation_layer)
+                     bool threaded_presentation, bool enable_debug_utils, bool enable_validation_layer,
+                     u32 frames_in_flight /* = DEFAULT_FRAMES_IN_FLIGHT */)
 {
   AssertMsg(!g_vulkan_context, "Has no current context");
 
@@ -361,6 +362,8 @@ bool Context::Create(std::string_view gpu_name, const WindowInfo* wi, std::uniqu
   }
 
   g_vulkan_context.reset(new Context(instance, gpus[gpu_index], true));
+  g_vulkan_context->m_frames_in_flight = std::clamp<u32>(frames_in_flight, MIN_FRAMES_IN_FLIGHT, MAX_FRAMES_IN_FLIGHT);
+  Log_InfoPrintf("Using %u frames in flight", g_vulkan_context->m_frames_in_flight);
 
   // Enable debug reports if the "Host GPU" log category is enabled.
   if (enable_debug_utils)
@@ -632,9 +635,9 @@ bool Context::CreateCommandBuffers()
 {
   VkResult res;
 
-  uint32_t frame_index = 0;
-  for (FrameResources& resources : m_frame_resources)
+  for (u32 frame_index = 0; frame_index < m_frames_in_flight; frame_index++)
   {
+    FrameResources& resources = m_frame_resources[frame_index];
     resources.needs_fence_wait = false;
 
     VkCommandPoolCreateInfo pool_info = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO, nullptr, 0,
@@ -690,8 +693,6 @@ bool Context::CreateCommandBuffers()
     }
     Vulkan::Util::SetObjectName(g_vulkan_context->GetDevice(), resources.descriptor_pool, "Frame Descriptor Pool %u",
                                 frame_index);
-
-    ++frame_index;
   }
 
   ActivateCommandBuffer(0);
@@ -812,13 +813,13 @@ void Context::WaitForFenceCounter(u64 fence_counter)
     return;
 
   // Find the first command buffer which covers this counter value.
-  u32 index = (m_current_frame + 1) % NUM_COMMAND_BUFFERS;
+  u32 index = (m_current_frame + 1) % m_frames_in_flight;
   while (index != m_current_frame)
   {
     if (m_frame_resources[index].fence_counter >= fence_counter)
       break;
 
-    index = (index + 1) % NUM_COMMAND_BUFFERS;
+    index = (index + 1) % m_frames_in_flight;
   }
 
   Assert(index != m_current_frame);
@@ -839,9 +840,9 @@ void Context::WaitForCommandBufferCompletion(u32 index)
     LOG_VULKAN_ERROR(res, "vkWaitForFences failed: ");
 
   // Clean up any resources for command buffers between the last known completed buffer and this
-  // now-completed command buffer. If we use >2 buffers, this may be more than one buffer.
+  // now-completed command buffer. With more than two frames in flight, this may be more than one buffer.
   const u64 now_completed_counter = m_frame_resources[index].fence_counter;
-  u32 cleanup_index = (m_current_frame + 1) % NUM_COMMAND_BUFFERS;
+  u32 cleanup_index = (m_current_frame + 1) % m_frames_in_flight;
   while (cleanup_index != m_current_frame)
   {
     FrameResources& resources = m_frame_resources[cleanup_index];
@@ -855,7 +856,7 @@ void Context::WaitForCommandBufferCompletion(u32 index)
       resources.cleanup_resources.clear();
     }
 
-    cleanup_index = (cleanup_index + 1) % NUM_COMMAND_BUFFERS;
+    cleanup_index = (cleanup_index + 1) % m_frames_in_flight;
   }
 
   m_completed_fence_counter = now_completed_counter;
@@ -1012,7 +1013,7 @@ void Context::StopPresentThread()
 
 void Context::MoveToNextCommandBuffer()
 {
-  ActivateCommandBuffer((m_current_frame + 1) % NUM_COMMAND_BUFFERS);
+  ActivateCommandBuffer((m_current_frame + 1) % m_frames_in_flight);
 }
 
 void Context::ActivateCommandBuffer(u32 index)
@@ -29,7 +29,9 @@ class Context
 public:
   enum : u32
   {
-    NUM_COMMAND_BUFFERS = 2
+    MIN_FRAMES_IN_FLIGHT = 2,
+    MAX_FRAMES_IN_FLIGHT = 4,
+    DEFAULT_FRAMES_IN_FLIGHT = 2
   };
 
   ~Context();
@@ -48,7 +50,8 @@ public:
 
   // Creates a new context and sets it up as global.
   static bool Create(std::string_view gpu_name, const WindowInfo* wi, std::unique_ptr<SwapChain>* out_swap_chain,
-                     bool threaded_presentation, bool enable_debug_utils, bool enable_validation_layer);
+                     bool threaded_presentation, bool enable_debug_utils, bool enable_validation_layer,
+                     u32 frames_in_flight = DEFAULT_FRAMES_IN_FLIGHT);
 
   // Creates a new context from a pre-existing instance.
   static bool CreateFromExistingInstance(VkInstance instance, VkPhysicalDevice gpu, VkSurfaceKHR surface,
@@ -62,6 +65,9 @@ public:
   // Destroys context.
   static void Destroy();
 
+  // Number of command buffers which can be queued to the GPU before the CPU has to wait for the oldest one.
+  ALWAYS_INLINE u32 GetFramesInFlight() const { return m_frames_in_flight; }
+
   // Enable/disable debug message runtime.
   bool EnableDebugUtils();
   void DisableDebugUtils();
@@ -161,6 +167,9 @@ public:
   void ExecuteCommandBuffer(bool wait_for_completion);
   void WaitForPresentComplete();
 
+  // Is a frame queued on the present thread, which hasn't been presented yet?
+  ALWAYS_INLINE bool IsPresentPending() const { return !m_present_done.load(); }
+
   // Was the last present submitted to the queue a failure? If so, we must recreate our swapchain.
   bool CheckLastPresentFail();
 
@@ -233,10 +242,11 @@ private:
   VkQueue m_present_queue = VK_NULL_HANDLE;
   u32 m_present_queue_family_index = 0;
 
-  std::array<FrameResources, NUM_COMMAND_BUFFERS> m_frame_resources;
+  std::array<FrameResources, MAX_FRAMES_IN_FLIGHT> m_frame_resources;
   u64 m_next_fence_counter = 1;
   u64 m_completed_fence_counter = 0;
   u32 m_current_frame;
+  u32 m_frames_in_flight = DEFAULT_FRAMES_IN_FLIGHT;
 
   bool m_owns_device = false;
 
@@ -751,13 +751,13 @@ void SwapChain::DestroySwapChain()
   m_swap_chain = VK_NULL_HANDLE;
 }
 
-VkResult SwapChain::AcquireNextImage()
+VkResult SwapChain::AcquireNextImage(bool wait /* = true */)
 {
   if (!m_swap_chain)
     return VK_ERROR_SURFACE_LOST_KHR;
 
-  return vkAcquireNextImageKHR(g_vulkan_context->GetDevice(), m_swap_chain, UINT64_MAX, m_image_available_semaphore,
-                               VK_NULL_HANDLE, &m_current_image);
+  return vkAcquireNextImageKHR(g_vulkan_context->GetDevice(), m_swap_chain, wait ? UINT64_MAX : 0,
+                               m_image_available_semaphore, VK_NULL_HANDLE, &m_current_image);
 }
 
 bool SwapChain::ResizeSwapChain(u32 new_width /* = 0 */, u32 new_height /* = 0 */)
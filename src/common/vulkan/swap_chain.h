@@ -57,7 +57,8 @@ public:
   ALWAYS_INLINE VkRenderPass GetClearRenderPass() const { return m_clear_render_pass; }
   ALWAYS_INLINE VkSemaphore GetImageAvailableSemaphore() const { return m_image_available_semaphore; }
   ALWAYS_INLINE VkSemaphore GetRenderingFinishedSemaphore() const { return m_rendering_finished_semaphore; }
-  VkResult AcquireNextImage();
+  /// If wait is false and no image is available, VK_NOT_READY is returned instead of blocking.
+  VkResult AcquireNextImage(bool wait = true);
 
   bool RecreateSurface(const WindowInfo& new_wi);
   bool ResizeSwapChain(u32 new_width = 0, u32 new_height = 0);
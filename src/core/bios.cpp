@@ -4,6 +4,7 @@
 #include "common/log.h"
 #include "common/md5_digest.h"
 #include "common/path.h"
+#include "common/startup_trace.h"
 #include "cpu_disasm.h"
 #include "host.h"
 #include "host_settings.h"
@@ -279,6 +280,8 @@ DiscRegion GetPSExeDiscRegion(const PSEXEHeader& header)
 
 std::optional<std::vector<u8>> BIOS::GetBIOSImage(ConsoleRegion region)
 {
+  StartupTrace::Phase trace_phase("Load BIOS");
+
   std::string bios_name;
   switch (region)
   {
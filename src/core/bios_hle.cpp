@@ -0,0 +1,363 @@
+#include "bios_hle.h"
+#include "bios.h"
+#include "bus.h"
+#include "common/log.h"
+#include "common/string_util.h"
+#include "cpu_core.h"
+#include "cpu_core_private.h"
+#include "settings.h"
+#include <algorithm>
+#include <array>
+#include <optional>
+Log_SetChannel(BIOS::HLE);
+
+namespace BIOS::HLE {
+
+namespace {
+enum class Table : u8
+{
+  A,
+  B,
+  C,
+  Count
+};
+
+struct FunctionInfo
+{
+  Table table;
+  u8 index;
+  const char* name;
+
+  // Returns false if the call can't be handled natively, e.g. pointers outside of RAM.
+  // instructions is set to an estimate of how many instructions the kernel's implementation would have executed.
+  bool (*handler)(const CPU::Registers& regs, u32* return_value, u32* instructions);
+};
+} // namespace
+
+// Vector, dispatcher, table lookup, and the jump back to the caller.
+static constexpr u32 CALL_OVERHEAD_INSTRUCTIONS = 12;
+
+// Strings longer than this are left to the BIOS, so a missing terminator doesn't scan all of RAM.
+static constexpr u32 MAX_STRING_LENGTH = 64 * 1024;
+
+static constexpr std::array<u32, static_cast<size_t>(Table::Count)> s_table_addresses = {
+  {TABLE_A_ADDRESS, TABLE_B_ADDRESS, TABLE_C_ADDRESS}};
+
+static std::array<std::array<const FunctionInfo*, MAX_FUNCTIONS_PER_TABLE>, static_cast<size_t>(Table::Count)>
+  s_handlers = {};
+static bool s_active = false;
+
+static bool IsBIOSAddress(VirtualMemoryAddress address)
+{
+  const PhysicalMemoryAddress paddr = address & CPU::PHYSICAL_MEMORY_ADDRESS_MASK;
+  return (paddr >= BIOS_BASE && paddr < (BIOS_BASE + BIOS_SIZE));
+}
+
+/// Returns true if the whole range can be accessed without side effects, i.e. RAM or scratchpad.
+static bool IsDirectAccessRange(VirtualMemoryAddress address, u32 length)
+{
+  const u32 segment = address >> 29;
+  if (segment != 0 && segment != 4 && segment != 5)
+    return false;
+
+  const PhysicalMemoryAddress start = address & CPU::PHYSICAL_MEMORY_ADDRESS_MASK;
+  const PhysicalMemoryAddress end = start + length;
+  if (length > Bus::RAM_MIRROR_END || end < start)
+    return false;
+
+  if (end <= Bus::RAM_MIRROR_END)
+    return true;
+
+  // scratchpad isn't accessible through KSEG1
+  return (segment != 5 && (start & CPU::DCACHE_LOCATION_MASK) == CPU::DCACHE_LOCATION &&
+          end <= (CPU::DCACHE_LOCATION + CPU::DCACHE_SIZE));
+}
+
+/// Returns the length of the string at address, excluding the terminator.
+static std::optional<u32> GetStringLength(VirtualMemoryAddress address, u32 max_length = MAX_STRING_LENGTH)
+{
+  for (u32 length = 0; length < max_length; length++)
+  {
+    u8 ch;
+    if (!IsDirectAccessRange(address + length, 1) || !CPU::SafeReadMemoryByte(address + length, &ch))
+      return std::nullopt;
+    if (ch == 0)
+      return length;
+  }
+
+  return std::nullopt;
+}
+
+static u8 ReadByte(VirtualMemoryAddress address)
+{
+  u8 value = 0;
+  CPU::SafeReadMemoryByte(address, &value);
+  return value;
+}
+
+static void WriteByte(VirtualMemoryAddress address, u8 value)
+{
+  CPU::SafeWriteMemoryByte(address, value);
+}
+
+// A(17h) strcmp(str1, str2)
+static bool HLE_strcmp(const CPU::Registers& regs, u32* return_value, u32* instructions)
+{
+  const u32 str1 = regs.a0;
+  const u32 str2 = regs.a1;
+  if (str1 == 0 || str2 == 0)
+    return false;
+
+  const std::optional<u32> len1 = GetStringLength(str1);
+  const std::optional<u32> len2 = GetStringLength(str2);
+  if (!len1.has_value() || !len2.has_value())
+    return false;
+
+  const u32 count = std::min(len1.value(), len2.value()) + 1;
+  u32 i = 0;
+  s32 result = 0;
+  for (; i < count; i++)
+  {
+    const u8 ch1 = ReadByte(str1 + i);
+    const u8 ch2 = ReadByte(str2 + i);
+    if (ch1 != ch2)
+    {
+      result = static_cast<s32>(ch1) - static_cast<s32>(ch2);
+      break;
+    }
+  }
+
+  *return_value = static_cast<u32>(result);
+  *instructions = CALL_OVERHEAD_INSTRUCTIONS + (i * 8);
+  return true;
+}
+
+// A(18h) strncmp(str1, str2, maxlen)
+static bool HLE_strncmp(const CPU::Registers& regs, u32* return_value, u32* instructions)
+{
+  const u32 str1 = regs.a0;
+  const u32 str2 = regs.a1;
+  const s32 maxlen = static_cast<s32>(regs.a2);
+  if (str1 == 0 || str2 == 0 || maxlen <= 0)
+    return false;
+
+  const std::optional<u32> len1 = GetStringLength(str1);
+  const std::optional<u32> len2 = GetStringLength(str2);
+  if (!len1.has_value() || !len2.has_value())
+    return false;
+
+  const u32 count = std::min(std::min(len1.value(), len2.value()) + 1, static_cast<u32>(maxlen));
+  u32 i = 0;
+  s32 result = 0;
+  for (; i < count; i++)
+  {
+    const u8 ch1 = ReadByte(str1 + i);
+    const u8 ch2 = ReadByte(str2 + i);
+    if (ch1 != ch2)
+    {
+      result = static_cast<s32>(ch1) - static_cast<s32>(ch2);
+      break;
+    }
+  }
+
+  *return_value = static_cast<u32>(result);
+  *instructions = CALL_OVERHEAD_INSTRUCTIONS + (i * 9);
+  return true;
+}
+
+// A(19h) strcpy(dst, src)
+static bool HLE_strcpy(const CPU::Registers& regs, u32* return_value, u32* instructions)
+{
+  const u32 dst = regs.a0;
+  const u32 src = regs.a1;
+  if (dst == 0 || src == 0)
+    return false;
+
+  const std::optional<u32> len = GetStringLength(src);
+  if (!len.has_value())
+    return false;
+
+  // overlapping copies depend on the order the kernel writes in, leave them alone
+  const u32 size = len.value() + 1;
+  if (!IsDirectAccessRange(dst, size) || (dst < (src + size) && src < (dst + size)))
+    return false;
+
+  for (u32 i = 0; i < size; i++)
+    WriteByte(dst + i, ReadByte(src + i));
+
+  *return_value = dst;
+  *instructions = CALL_OVERHEAD_INSTRUCTIONS + (size * 5);
+  return true;
+}
+
+// A(1Bh) strlen(src)
+static bool HLE_strlen(const CPU::Registers& regs, u32* return_value, u32* instructions)
+{
+  const u32 src = regs.a0;
+  if (src == 0)
+    return false;
+
+  const std::optional<u32> len = GetStringLength(src);
+  if (!len.has_value())
+    return false;
+
+  *return_value = len.value();
+  *instructions = CALL_OVERHEAD_INSTRUCTIONS + (len.value() * 4);
+  return true;
+}
+
+// A(28h) bzero(dst, len)
+static bool HLE_bzero(const CPU::Registers& regs, u32* return_value, u32* instructions)
+{
+  const u32 dst = regs.a0;
+  const s32 len = static_cast<s32>(regs.a1);
+  if (dst == 0 || len <= 0 || !IsDirectAccessRange(dst, static_cast<u32>(len)))
+    return false;
+
+  for (s32 i = 0; i < len; i++)
+    WriteByte(dst + static_cast<u32>(i), 0);
+
+  *return_value = dst;
+  *instructions = CALL_OVERHEAD_INSTRUCTIONS + (static_cast<u32>(len) * 5);
+  return true;
+}
+
+// A(2Ah) memcpy(dst, src, len)
+static bool HLE_memcpy(const CPU::Registers& regs, u32* return_value, u32* instructions)
+{
+  const u32 dst = regs.a0;
+  const u32 src = regs.a1;
+  const s32 len = static_cast<s32>(regs.a2);
+  if (dst == 0 || src == 0 || len <= 0 || !IsDirectAccessRange(dst, static_cast<u32>(len)) ||
+      !IsDirectAccessRange(src, static_cast<u32>(len)))
+  {
+    return false;
+  }
+
+  // byte-wise forwards like the kernel, so overlapping copies behave the same
+  for (s32 i = 0; i < len; i++)
+    WriteByte(dst + static_cast<u32>(i), ReadByte(src + static_cast<u32>(i)));
+
+  *return_value = dst;
+  *instructions = CALL_OVERHEAD_INSTRUCTIONS + (static_cast<u32>(len) * 6);
+  return true;
+}
+
+// A(2Bh) memset(dst, fillbyte, len)
+static bool HLE_memset(const CPU::Registers& regs, u32* return_value, u32* instructions)
+{
+  const u32 dst = regs.a0;
+  const u8 fill = Truncate8(regs.a1);
+  const s32 len = static_cast<s32>(regs.a2);
+  if (dst == 0 || len <= 0 || !IsDirectAccessRange(dst, static_cast<u32>(len)))
+    return false;
+
+  for (s32 i = 0; i < len; i++)
+    WriteByte(dst + static_cast<u32>(i), fill);
+
+  *return_value = dst;
+  *instructions = CALL_OVERHEAD_INSTRUCTIONS + (static_cast<u32>(len) * 5);
+  return true;
+}
+
+static constexpr std::array<FunctionInfo, 7> s_functions = {{
+  {Table::A, 0x17, "strcmp", &HLE_strcmp},
+  {Table::A, 0x18, "strncmp", &HLE_strncmp},
+  {Table::A, 0x19, "strcpy", &HLE_strcpy},
+  {Table::A, 0x1B, "strlen", &HLE_strlen},
+  {Table::A, 0x28, "bzero", &HLE_bzero},
+  {Table::A, 0x2A, "memcpy", &HLE_memcpy},
+  {Table::A, 0x2B, "memset", &HLE_memset},
+}};
+
+static const FunctionInfo* FindFunction(const std::string_view& name)
+{
+  for (const FunctionInfo& fi : s_functions)
+  {
+    if (name == fi.name)
+      return &fi;
+  }
+
+  return nullptr;
+}
+
+static void EnableFunction(const FunctionInfo* fi)
+{
+  s_handlers[static_cast<size_t>(fi->table)][fi->index] = fi;
+  s_active = true;
+}
+
+void UpdateSettings()
+{
+  for (auto& table : s_handlers)
+    table.fill(nullptr);
+  s_active = false;
+
+  if (!g_settings.bios_hle_enable)
+    return;
+
+  if (g_settings.bios_hle_functions.empty())
+  {
+    for (const FunctionInfo& fi : s_functions)
+      EnableFunction(&fi);
+  }
+  else
+  {
+    for (const std::string_view& name : StringUtil::SplitString(g_settings.bios_hle_functions, ','))
+    {
+      const FunctionInfo* fi = FindFunction(StringUtil::StripWhitespace(name));
+      if (!fi)
+      {
+        Log_WarningPrintf("Unknown HLE BIOS function '%.*s'", static_cast<int>(name.size()), name.data());
+        continue;
+      }
+
+      EnableFunction(fi);
+    }
+  }
+
+  for (const auto& table : s_handlers)
+  {
+    for (const FunctionInfo* fi : table)
+    {
+      if (fi)
+        Log_DevPrintf("Intercepting %c(%02Xh) %s()", 'A' + static_cast<char>(fi->table), fi->index, fi->name);
+    }
+  }
+}
+
+bool IsActive()
+{
+  return s_active;
+}
+
+bool Execute(VirtualMemoryAddress vector_address, const CPU::Registers& regs, u32* return_value, TickCount* ticks)
+{
+  const u32 table = ((vector_address & CPU::PHYSICAL_MEMORY_ADDRESS_MASK) - VECTOR_A) >> 4;
+  const u32 index = regs.t1;
+  if (index >= MAX_FUNCTIONS_PER_TABLE)
+    return false;
+
+  const FunctionInfo* fi = s_handlers[table][index];
+  if (!fi)
+    return false;
+
+  // Games can install their own implementations in the kernel's tables, we only want to replace the ROM's.
+  u32 function_address;
+  if (!CPU::SafeReadMemoryWord(s_table_addresses[table] + (index * sizeof(u32)), &function_address) ||
+      !IsBIOSAddress(function_address))
+  {
+    return false;
+  }
+
+  u32 instructions;
+  if (!fi->handler(regs, return_value, &instructions))
+    return false;
+
+  // Kernel code runs uncached from ROM, so each instruction pays for its fetch.
+  *ticks = static_cast<TickCount>(instructions) * (1 + CPU::GetInstructionReadTicks(function_address));
+  Log_TracePrintf("HLE %s() -> 0x%08X (%d ticks)", fi->name, *return_value, *ticks);
+  return true;
+}
+
+} // namespace BIOS::HLE
@@ -0,0 +1,41 @@
+#pragma once
+#include "cpu_types.h"
+#include "types.h"
+
+// High-level emulation of frequently-called kernel functions.
+// Calls through the A0/B0/C0 vectors are intercepted and run natively instead of being executed from the BIOS ROM,
+// as long as the game hasn't replaced the kernel's implementation of the function in the dispatch table.
+namespace BIOS::HLE {
+
+enum : u32
+{
+  VECTOR_A = 0xA0,
+  VECTOR_B = 0xB0,
+  VECTOR_C = 0xC0,
+
+  // Kernel dispatch tables in RAM, filled in by the BIOS during boot.
+  TABLE_A_ADDRESS = 0x200,
+  TABLE_B_ADDRESS = 0x874,
+  TABLE_C_ADDRESS = 0x674,
+
+  MAX_FUNCTIONS_PER_TABLE = 0x100,
+};
+
+/// Returns true if the address is one of the kernel call vectors, in any segment.
+ALWAYS_INLINE static bool IsVectorAddress(VirtualMemoryAddress address)
+{
+  const PhysicalMemoryAddress paddr = address & CPU::PHYSICAL_MEMORY_ADDRESS_MASK;
+  return (paddr == VECTOR_A || paddr == VECTOR_B || paddr == VECTOR_C);
+}
+
+/// Rebuilds the list of intercepted functions from the current settings.
+void UpdateSettings();
+
+/// Returns true if any function is intercepted.
+bool IsActive();
+
+/// Attempts to run the kernel call at the specified vector address natively. regs should have any pending load delay
+/// applied. When false is returned, no side effects have occurred and the call should be executed by the guest BIOS.
+bool Execute(VirtualMemoryAddress vector_address, const CPU::Registers& regs, u32* return_value, TickCount* ticks);
+
+} // namespace BIOS::HLE
@@ -1,5 +1,7 @@
 #include "cpu_code_cache.h"
+#include "bios_hle.h"
 #include "bus.h"
+#include "common/align.h"
 #include "common/assert.h"
 #include "common/log.h"
 #include "cpu_core.h"
@@ -554,6 +556,13 @@ CodeBlock* LookupBlock(CodeBlockKey key)
       return nullptr;
   }
 
+  if (BIOS::HLE::IsActive() && BIOS::HLE::IsVectorAddress(key.GetPC()))
+  {
+    // Leave kernel call vectors to the interpreter, which gives the HLE layer a chance to intercept them.
+    s_blocks.emplace(key.bits, nullptr);
+    return nullptr;
+  }
+
   CodeBlock* block = new CodeBlock(key);
   block->recompile_frame_number = System::GetFrameNumber();
 
@@ -1236,6 +1245,164 @@ void CPU::Recompiler::Thunks::ResolveBranch(CodeBlock* block, void* host_pc, voi
   }
 }
 
+/// Returns the offset into RAM for a bulk access, if the whole range is aligned and in a single mirror of RAM.
+static bool GetBulkMemoryLoopRAMOffset(VirtualMemoryAddress address, u32 length, u32 alignment, u32* offset)
+{
+  // KUSEG (lower 512MB), KSEG0 and KSEG1. Everything else, including scratchpad and MMIO, goes through the guest code.
+  const u32 segment = address >> 29;
+  if ((segment != 0x00 && segment != 0x04 && segment != 0x05) || !Common::IsAlignedPow2(address, alignment))
+    return false;
+
+  const PhysicalMemoryAddress paddr = address & CPU::PHYSICAL_MEMORY_ADDRESS_MASK;
+  if (!Bus::IsRAMAddress(paddr))
+    return false;
+
+  *offset = paddr & Bus::g_ram_mask;
+  return ((*offset + length) <= Bus::g_ram_size);
+}
+
+bool CPU::Recompiler::Thunks::ExecuteBulkMemoryLoop(const BulkMemoryLoop* loop)
+{
+  // Leave load delays from the previous block and isolated cache writes to the guest code.
+  if (g_state.load_delay_reg != Reg::count || g_state.next_load_delay_reg != Reg::count || g_state.cop0_regs.sr.Isc)
+    return false;
+
+  u32* const regs = g_state.regs.r;
+
+  // Work out how many times the branch will be taken.
+  u64 iterations;
+  const u32 lhs = regs[static_cast<u8>(loop->branch_lhs)] + static_cast<u32>(loop->branch_lhs_offset);
+  if (loop->branch_is_bgtz)
+  {
+    const s32 value = static_cast<s32>(lhs);
+    const s64 step = loop->GetIncrement(loop->branch_lhs);
+    if (value <= 0)
+      iterations = 1;
+    else if (step >= 0)
+      return false;
+    else
+      iterations = static_cast<u64>((value - step - 1) / -step) + 1;
+  }
+  else
+  {
+    // bne: solve distance + step * n == 0, wrapping is fine as long as the step is a power of two.
+    const u32 rhs = regs[static_cast<u8>(loop->branch_rhs)] + static_cast<u32>(loop->branch_rhs_offset);
+    const u32 distance = lhs - rhs;
+    const s32 step = loop->GetIncrement(loop->branch_lhs) - loop->GetIncrement(loop->branch_rhs);
+    const u32 step_magnitude = (step < 0) ? (0u - static_cast<u32>(step)) : static_cast<u32>(step);
+    const u32 remaining = (step < 0) ? distance : (0u - distance);
+    if (step_magnitude == 0 || !Common::IsPow2(step_magnitude) || (remaining % step_magnitude) != 0)
+      return false;
+
+    iterations = static_cast<u64>(remaining / step_magnitude) + 1;
+  }
+
+  // Don't run past the next event. Short loops aren't worth the setup.
+  const TickCount ticks_available = g_state.downcount - g_state.pending_ticks;
+  const u32 access_size = 1u << static_cast<u32>(loop->size);
+  if (ticks_available <= 0)
+    return false;
+  const u32 count = static_cast<u32>(std::min<u64>(
+    iterations, std::min<u32>(static_cast<u32>(ticks_available / loop->ticks_per_iteration), Bus::g_ram_size)));
+  if (count < 2)
+    return false;
+
+  const u32 length = count * access_size;
+  const VirtualMemoryAddress dst_address = regs[static_cast<u8>(loop->dst_reg)] + static_cast<u32>(loop->dst_offset);
+  u32 dst_offset;
+  if (!GetBulkMemoryLoopRAMOffset(dst_address, length, access_size, &dst_offset))
+    return false;
+
+  u8* const ram = Bus::g_ram;
+  if (loop->is_copy)
+  {
+    const VirtualMemoryAddress src_address =
+      regs[static_cast<u8>(loop->src_reg)] + static_cast<u32>(loop->src_offset);
+    u32 src_offset;
+    if (!GetBulkMemoryLoopRAMOffset(src_address, length, access_size, &src_offset))
+      return false;
+
+    if (dst_offset > src_offset && dst_offset < (src_offset + length))
+    {
+      // Destination is just ahead of the source, so later loads pick up earlier stores.
+      for (u32 i = 0; i < length; i += access_size)
+        std::memcpy(&ram[dst_offset + i], &ram[src_offset + i], access_size);
+    }
+    else
+    {
+      std::memmove(&ram[dst_offset], &ram[src_offset], length);
+    }
+
+    // No store can hit the last element loaded after it was read.
+    const u32 last_offset = src_offset + length - access_size;
+    u32 value;
+    switch (loop->size)
+    {
+      case MemoryAccessSize::Byte:
+        value = loop->load_signed ? SignExtend32(ram[last_offset]) : ZeroExtend32(ram[last_offset]);
+        break;
+
+      case MemoryAccessSize::HalfWord:
+      {
+        u16 temp;
+        std::memcpy(&temp, &ram[last_offset], sizeof(temp));
+        value = loop->load_signed ? SignExtend32(temp) : ZeroExtend32(temp);
+      }
+      break;
+
+      case MemoryAccessSize::Word:
+      default:
+        std::memcpy(&value, &ram[last_offset], sizeof(value));
+        break;
+    }
+
+    regs[static_cast<u8>(loop->load_reg)] = value;
+  }
+  else
+  {
+    const u32 value = regs[static_cast<u8>(loop->value_reg)];
+    switch (loop->size)
+    {
+      case MemoryAccessSize::Byte:
+        std::memset(&ram[dst_offset], static_cast<u8>(value), length);
+        break;
+
+      case MemoryAccessSize::HalfWord:
+      {
+        const u16 temp = Truncate16(value);
+        for (u32 i = 0; i < length; i += sizeof(temp))
+          std::memcpy(&ram[dst_offset + i], &temp, sizeof(temp));
+      }
+      break;
+
+      case MemoryAccessSize::Word:
+      default:
+      {
+        for (u32 i = 0; i < length; i += sizeof(value))
+          std::memcpy(&ram[dst_offset + i], &value, sizeof(value));
+      }
+      break;
+    }
+  }
+
+  for (u32 i = 0; i < loop->num_increments; i++)
+    regs[static_cast<u8>(loop->increments[i].reg)] += static_cast<u32>(loop->increments[i].value) * count;
+
+  g_state.regs.pc = (count == iterations) ? loop->exit_pc : loop->loop_pc;
+  g_state.pending_ticks += static_cast<TickCount>(count) * loop->ticks_per_iteration;
+
+  // This can invalidate the block containing the loop, so it has to come last.
+  const u32 start_page = dst_offset / HOST_PAGE_SIZE;
+  const u32 end_page = (dst_offset + length - 1) / HOST_PAGE_SIZE;
+  for (u32 page = start_page; page <= end_page; page++)
+  {
+    if (Bus::m_ram_code_bits[page])
+      CPU::CodeCache::InvalidateBlocksWithPageIndex(page);
+  }
+
+  return true;
+}
+
 void CPU::Recompiler::Thunks::LogPC(u32 pc)
 {
 #if 0
@@ -83,6 +83,7 @@ struct CodeBlock
 
 #ifdef WITH_RECOMPILER
   std::vector<Recompiler::LoadStoreBackpatchInfo> loadstore_backpatch_info;
+  std::unique_ptr<Recompiler::BulkMemoryLoop> bulk_memory_loop;
 #endif
 
   bool contains_loadstore_instructions = false;
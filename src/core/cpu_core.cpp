@@ -1,4 +1,5 @@
 #include "cpu_core.h"
+#include "bios_hle.h"
 #include "bus.h"
 #include "common/align.h"
 #include "common/file_system.h"
@@ -1874,6 +1875,35 @@ ALWAYS_INLINE_RELEASE static bool BreakpointCheck()
   return System::IsPaused();
 }
 
+/// Runs the kernel call at the current pc natively, if the HLE layer handles it.
+/// On success, the return value and cycles are applied, but the caller is responsible for jumping back to ra.
+static bool TryExecuteBIOSHLECall()
+{
+  if (!BIOS::HLE::IsActive())
+    return false;
+
+  // the kernel reads its arguments well after the vector is entered, so any load from the delay slot has landed
+  Registers regs = g_state.regs;
+  if (g_state.load_delay_reg != Reg::count)
+    regs.r[static_cast<u8>(g_state.load_delay_reg)] = g_state.load_delay_value;
+
+  u32 return_value;
+  TickCount ticks;
+  if (!BIOS::HLE::Execute(g_state.regs.pc, regs, &return_value, &ticks))
+    return false;
+
+  if (g_state.load_delay_reg != Reg::count)
+  {
+    g_state.regs.r[static_cast<u8>(g_state.load_delay_reg)] = g_state.load_delay_value;
+    g_state.load_delay_reg = Reg::count;
+  }
+  g_state.next_load_delay_reg = Reg::count;
+
+  g_state.regs.v0 = return_value;
+  g_state.pending_ticks += ticks;
+  return true;
+}
+
 template<PGXPMode pgxp_mode, bool debug>
 static void ExecuteImpl()
 {
@@ -1899,6 +1929,13 @@ static void ExecuteImpl()
         }
       }
 
+      if (BIOS::HLE::IsVectorAddress(g_state.regs.pc) && !g_state.next_instruction_is_branch_delay_slot &&
+          TryExecuteBIOSHLECall())
+      {
+        SetPC(g_state.regs.ra);
+        continue;
+      }
+
       g_state.interrupt_delay = false;
       g_state.pending_ticks++;
 
@@ -2024,6 +2061,14 @@ template void InterpretCachedBlock<PGXPMode::CPU>(const CodeBlock& block);
 template<PGXPMode pgxp_mode>
 void InterpretUncachedBlock()
 {
+  // kernel call vectors are never compiled while HLE is active, so they end up here
+  if (BIOS::HLE::IsVectorAddress(g_state.regs.pc) && TryExecuteBIOSHLECall())
+  {
+    g_state.regs.pc = g_state.regs.ra;
+    g_state.regs.npc = g_state.regs.ra;
+    return;
+  }
+
   g_state.regs.npc = g_state.regs.pc;
   if (!FetchInstructionForInterpreterFallback())
     return;
@@ -30,6 +30,7 @@ bool CodeGenerator::CompileBlock(CodeBlock* block, CodeBlock::HostCodePointer* o
 
   EmitBeginBlock(true);
   BlockPrologue();
+  EmitBulkMemoryLoop();
 
   m_current_instruction = m_block_start;
   while (m_current_instruction != m_block_end)
@@ -1128,6 +1129,166 @@ void CodeGenerator::StallUntilGTEComplete()
   m_gte_busy_cycles_dirty = false;
 }
 
+bool CodeGenerator::AnalyzeBulkMemoryLoop(BulkMemoryLoop* loop) const
+{
+  // PGXP tracks values through memory, and icache simulation needs the fetch ticks per iteration.
+  if (g_settings.gpu_pgxp_enable || m_block->uncached_fetch_ticks > 0 || m_block->icache_line_count > 0)
+    return false;
+
+  // loop body, conditional branch back to the start of the block, delay slot
+  const u32 count = static_cast<u32>(m_block->instructions.size());
+  if (count < 3 || count > 16)
+    return false;
+
+  const u32 branch_index = count - 2;
+  const CodeBlockInstruction& branch_cbi = m_block->instructions[branch_index];
+  const Instruction branch = branch_cbi.instruction;
+  if ((branch.op != InstructionOp::bne && branch.op != InstructionOp::bgtz) ||
+      GetDirectBranchTarget(branch, branch_cbi.pc) != m_block->GetPC())
+  {
+    return false;
+  }
+
+  std::array<u32, static_cast<u8>(Reg::count)> increment_index;
+  increment_index.fill(count);
+
+  *loop = {};
+  u32 load_index = count;
+  u32 store_index = count;
+  for (u32 i = 0; i < count; i++)
+  {
+    const Instruction inst = m_block->instructions[i].instruction;
+    if (i == branch_index || IsNopInstruction(inst))
+      continue;
+
+    switch (inst.op)
+    {
+      case InstructionOp::addiu:
+      {
+        const Reg reg = inst.i.rt;
+        if (inst.i.rs != reg || reg == Reg::zero || increment_index[static_cast<u8>(reg)] != count ||
+            loop->num_increments == loop->increments.size())
+        {
+          return false;
+        }
+
+        increment_index[static_cast<u8>(reg)] = i;
+        loop->increments[loop->num_increments++] = {reg, static_cast<s32>(inst.i.imm_sext32())};
+      }
+      break;
+
+      case InstructionOp::lb:
+      case InstructionOp::lbu:
+      case InstructionOp::lh:
+      case InstructionOp::lhu:
+      case InstructionOp::lw:
+      {
+        if (load_index != count)
+          return false;
+
+        load_index = i;
+      }
+      break;
+
+      case InstructionOp::sb:
+      case InstructionOp::sh:
+      case InstructionOp::sw:
+      {
+        if (store_index != count)
+          return false;
+
+        store_index = i;
+      }
+      break;
+
+      default:
+        return false;
+    }
+  }
+
+  if (store_index == count)
+    return false;
+
+  // register value at the specified instruction, relative to the value on entry
+  const auto offset_at = [loop, &increment_index](Reg reg, u32 index) {
+    return (increment_index[static_cast<u8>(reg)] < index) ? loop->GetIncrement(reg) : 0;
+  };
+
+  const Instruction store = m_block->instructions[store_index].instruction;
+  loop->size = (store.op == InstructionOp::sb) ?
+                 MemoryAccessSize::Byte :
+                 ((store.op == InstructionOp::sh) ? MemoryAccessSize::HalfWord : MemoryAccessSize::Word);
+  const s32 access_size = static_cast<s32>(1u << static_cast<u32>(loop->size));
+  loop->dst_reg = store.i.rs;
+  loop->dst_offset = static_cast<s32>(store.i.imm_sext32()) + offset_at(loop->dst_reg, store_index);
+  loop->value_reg = store.i.rt;
+  if (loop->GetIncrement(loop->dst_reg) != access_size)
+    return false;
+
+  loop->load_reg = Reg::count;
+  loop->src_reg = Reg::count;
+  if (load_index != count)
+  {
+    // the loaded value has to get through the load delay before it's stored
+    const Instruction load = m_block->instructions[load_index].instruction;
+    const MemoryAccessSize load_size =
+      (load.op == InstructionOp::lb || load.op == InstructionOp::lbu) ?
+        MemoryAccessSize::Byte :
+        ((load.op == InstructionOp::lh || load.op == InstructionOp::lhu) ? MemoryAccessSize::HalfWord :
+                                                                           MemoryAccessSize::Word);
+    loop->is_copy = true;
+    loop->load_signed = (load.op == InstructionOp::lb || load.op == InstructionOp::lh);
+    loop->load_reg = load.i.rt;
+    loop->src_reg = load.i.rs;
+    loop->src_offset = static_cast<s32>(load.i.imm_sext32()) + offset_at(loop->src_reg, load_index);
+    if (load_size != loop->size || store_index < (load_index + 2) || loop->value_reg != loop->load_reg ||
+        loop->load_reg == Reg::zero || loop->load_reg == loop->src_reg || loop->load_reg == loop->dst_reg ||
+        increment_index[static_cast<u8>(loop->load_reg)] != count || loop->GetIncrement(loop->src_reg) != access_size)
+    {
+      return false;
+    }
+  }
+  else
+  {
+    if (increment_index[static_cast<u8>(loop->value_reg)] != count)
+      return false;
+  }
+
+  loop->branch_is_bgtz = (branch.op == InstructionOp::bgtz);
+  loop->branch_lhs = branch.i.rs;
+  loop->branch_rhs = loop->branch_is_bgtz ? Reg::zero : branch.i.rt;
+  loop->branch_lhs_offset = offset_at(loop->branch_lhs, branch_index);
+  loop->branch_rhs_offset = offset_at(loop->branch_rhs, branch_index);
+  if ((loop->is_copy && (loop->branch_lhs == loop->load_reg || loop->branch_rhs == loop->load_reg)) ||
+      (loop->GetIncrement(loop->branch_lhs) == loop->GetIncrement(loop->branch_rhs)))
+  {
+    return false;
+  }
+
+  loop->loop_pc = m_block->GetPC();
+  loop->exit_pc = branch_cbi.pc + (INSTRUCTION_SIZE * 2);
+  loop->ticks_per_iteration = static_cast<TickCount>(count) + (loop->is_copy ? Bus::RAM_READ_TICKS : 0);
+  return true;
+}
+
+void CodeGenerator::EmitBulkMemoryLoop()
+{
+  BulkMemoryLoop loop;
+  if (!AnalyzeBulkMemoryLoop(&loop))
+  {
+    m_block->bulk_memory_loop.reset();
+    return;
+  }
+
+  Log_DebugPrintf("Block 0x%08X is a bulk %s loop", m_block->GetPC(), loop.is_copy ? "copy" : "fill");
+  m_block->bulk_memory_loop = std::make_unique<BulkMemoryLoop>(loop);
+
+  // if the loop was run on the host, the registers and pc are already up to date
+  Value executed = m_register_cache.AllocateScratch(RegSize_8);
+  EmitFunctionCall(&executed, &Thunks::ExecuteBulkMemoryLoop, Value::FromConstantPtr(m_block->bulk_memory_loop.get()));
+  EmitExceptionExitOnBool(executed);
+}
+
 Value CodeGenerator::CalculatePC(u32 offset /* = 0 */)
 {
   if (!m_pc_valid)
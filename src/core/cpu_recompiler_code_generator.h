@@ -207,6 +207,8 @@ private:
   void AddPendingCycles(bool commit);
   void AddGTETicks(TickCount ticks);
   void StallUntilGTEComplete();
+  bool AnalyzeBulkMemoryLoop(BulkMemoryLoop* loop) const;
+  void EmitBulkMemoryLoop();
 
   Value CalculatePC(u32 offset = 0);
   Value GetCurrentInstructionPC(u32 offset = 0);
@@ -33,6 +33,10 @@ void UncheckedWriteMemoryByte(u32 address, u32 value);
 void UncheckedWriteMemoryHalfWord(u32 address, u32 value);
 void UncheckedWriteMemoryWord(u32 address, u32 value);
 
+// Runs as many iterations of a copy/fill loop as the timeslice allows. Returns true if the loop was executed, in
+// which case the block should be exited, as the registers and pc have been updated.
+bool ExecuteBulkMemoryLoop(const BulkMemoryLoop* loop);
+
 void ResolveBranch(CodeBlock* block, void* host_pc, void* host_resolve_pc, u32 host_pc_size);
 void LogPC(u32 pc);
 
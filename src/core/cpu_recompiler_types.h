@@ -1,6 +1,7 @@
 #pragma once
 #include "common/platform.h"
 #include "cpu_types.h"
+#include <array>
 
 #if defined(CPU_X64)
 
@@ -157,6 +158,52 @@ struct LoadStoreBackpatchInfo
   u32 fault_count;
 };
 
+/// Guest copy/fill loop which is executed on the host in bulk, e.g.
+///   loop: lw t0, 0(a0); addiu a0, a0, 4; sw t0, 0(a1); bne a0, a2, loop; addiu a1, a1, 4
+/// Offsets are relative to the register values on entry to the loop, and include any increment which takes place
+/// earlier in the iteration than the instruction using the register.
+struct BulkMemoryLoop
+{
+  struct Increment
+  {
+    Reg reg;
+    s32 value;
+  };
+
+  VirtualMemoryAddress loop_pc; // first instruction, also the branch target
+  VirtualMemoryAddress exit_pc; // instruction after the branch delay slot
+  TickCount ticks_per_iteration;
+
+  MemoryAccessSize size;
+  bool is_copy; // load + store, otherwise store of a loop-invariant register
+  bool load_signed;
+  Reg load_reg;
+  Reg src_reg;
+  Reg dst_reg;
+  Reg value_reg;
+  s32 src_offset;
+  s32 dst_offset;
+
+  bool branch_is_bgtz; // otherwise bne
+  Reg branch_lhs;
+  Reg branch_rhs;
+  s32 branch_lhs_offset;
+  s32 branch_rhs_offset;
+
+  std::array<Increment, 4> increments;
+  u32 num_increments;
+
+  s32 GetIncrement(Reg reg) const
+  {
+    for (u32 i = 0; i < num_increments; i++)
+    {
+      if (increments[i].reg == reg)
+        return increments[i].value;
+    }
+    return 0;
+  }
+};
+
 } // namespace Recompiler
 
 } // namespace CPU
@@ -4,6 +4,7 @@
 #include "common/heterogeneous_containers.h"
 #include "common/log.h"
 #include "common/path.h"
+#include "common/startup_trace.h"
 #include "common/string_util.h"
 #include "common/timer.h"
 #include "host.h"
@@ -12,8 +13,11 @@
 #include "system.h"
 #include "tinyxml2.h"
 #include "util/cd_image.h"
+#include <atomic>
+#include <future>
 #include <iomanip>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <sstream>
 Log_SetChannel(GameDatabase);
@@ -65,23 +69,30 @@ std::array<std::pair<const char*, const char*>, static_cast<u32>(GameDatabase::T
   {"ForceRecompilerLUTFastmem", TRANSLATABLE("GameSettingsTrait", "Force Recompiler LUT Fastmem")},
 }};
 
-static bool s_loaded = false;
+static std::atomic_bool s_loaded{false};
 static bool s_track_hashes_loaded = false;
 
 static std::vector<GameDatabase::Entry> s_entries;
 static UnorderedStringMap<u32> s_code_lookup;
 
 static TrackHashesMap s_track_hashes_map;
+
+// Held while loading, so lookups from other threads wait for the database instead of seeing a partial one.
+static std::mutex s_load_mutex;
+static std::future<void> s_load_future;
 } // namespace GameDatabase
 
 void GameDatabase::EnsureLoaded()
 {
-  if (s_loaded)
+  if (s_loaded.load(std::memory_order_acquire))
     return;
 
-  Common::Timer timer;
+  std::unique_lock lock(s_load_mutex);
+  if (s_loaded.load(std::memory_order_relaxed))
+    return;
 
-  s_loaded = true;
+  StartupTrace::Phase trace_phase("Load game database");
+  Common::Timer timer;
 
   if (!LoadFromCache())
   {
@@ -94,14 +105,27 @@ void GameDatabase::EnsureLoaded()
     SaveToCache();
   }
 
+  s_loaded.store(true, std::memory_order_release);
   Log_InfoPrintf("Database load took %.2f ms", timer.GetTimeMilliseconds());
 }
 
 void GameDatabase::Unload()
 {
+  // Releasing the future waits for a background load to finish.
+  s_load_future = {};
+
+  std::unique_lock lock(s_load_mutex);
   s_entries = {};
   s_code_lookup = {};
-  s_loaded = false;
+  s_loaded.store(false, std::memory_order_release);
+}
+
+void GameDatabase::LoadAsync()
+{
+  if (s_loaded.load(std::memory_order_acquire) || s_load_future.valid())
+    return;
+
+  s_load_future = std::async(std::launch::async, &GameDatabase::EnsureLoaded);
 }
 
 const GameDatabase::Entry* GameDatabase::GetEntryForCode(const std::string_view& code)
@@ -123,6 +147,32 @@ std::string GameDatabase::GetSerialForDisc(CDImage* image)
   return ret;
 }
 
+std::vector<std::string> GameDatabase::GetDiscSetSerials(const std::string_view& serial)
+{
+  // Discs of the same game share a title, up to the disc number, e.g. "Final Fantasy VII (USA) (Disc 2)".
+  const auto get_disc_set_title = [](const std::string_view& title) {
+    const std::string_view::size_type pos = title.find(" (Disc ");
+    return (pos != std::string_view::npos) ? title.substr(0, pos) : std::string_view();
+  };
+
+  std::vector<std::string> ret;
+  const Entry* entry = GetEntryForSerial(serial);
+  const std::string_view disc_set_title(entry ? get_disc_set_title(entry->title) : std::string_view());
+  if (!disc_set_title.empty())
+  {
+    for (const Entry& other : s_entries)
+    {
+      if (get_disc_set_title(other.title) == disc_set_title)
+        ret.push_back(other.serial);
+    }
+  }
+
+  if (ret.empty())
+    ret.emplace_back(serial);
+
+  return ret;
+}
+
 std::string GameDatabase::GetSerialForPath(const char* path)
 {
   std::string ret;
@@ -83,12 +83,20 @@ struct Entry
 void EnsureLoaded();
 void Unload();
 
+/// Starts loading the database on a worker thread, so it is (hopefully) ready by the time a game is booted or listed.
+/// Lookups made before then wait for the load to complete.
+void LoadAsync();
+
 const Entry* GetEntryForDisc(CDImage* image);
 const Entry* GetEntryForSerial(const std::string_view& serial);
 const Entry* GetEntryForCode(const std::string_view& code);
 std::string GetSerialForDisc(CDImage* image);
 std::string GetSerialForPath(const char* path);
 
+/// Returns the serials of every disc of a multi-disc game, or just the serial itself for single-disc games and serials
+/// which aren't in the database.
+std::vector<std::string> GetDiscSetSerials(const std::string_view& serial);
+
 const char* GetTraitName(Trait trait);
 const char* GetTraitDisplayName(Trait trait);
 
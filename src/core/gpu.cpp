@@ -810,7 +810,11 @@ void GPU::UpdateCRTCTickEvent()
     (m_crtc_state.horizontal_display_end - m_crtc_state.current_tick_in_scanline);
 #endif
 
-  m_crtc_tick_event->Schedule(CRTCTicksToSystemTicks(ticks_until_event, m_crtc_state.fractional_ticks));
+  // the CRTC state may not have been brought up to date yet if we're called from a timer register write
+  const TickCount ticks_since_sync =
+    m_crtc_tick_event->IsActive() ? m_crtc_tick_event->GetTicksSinceLastExecution() : 0;
+  m_crtc_tick_event->Schedule(std::max<TickCount>(
+    CRTCTicksToSystemTicks(ticks_until_event, m_crtc_state.fractional_ticks) - ticks_since_sync, 0));
 }
 
 bool GPU::IsCRTCScanlinePending() const
@@ -140,6 +140,9 @@ public:
   /// Synchronizes the CRTC, updating the hblank timer.
   void SynchronizeCRTC();
 
+  /// Reschedules the CRTC event for the next vblank transition or armed timer interrupt.
+  void UpdateCRTCTickEvent();
+
   /// Recompile shaders/recreate framebuffers when needed.
   virtual void UpdateSettings();
 
@@ -216,9 +219,6 @@ protected:
   // Sets dots per scanline
   void UpdateCRTCConfig();
   void UpdateCRTCDisplayParameters();
-
-  // Update ticks for this execution slice
-  void UpdateCRTCTickEvent();
   void UpdateCommandTickEvent();
 
   // Updates dynamic bits in GPUSTAT (ready to send VRAM/ready to receive DMA)
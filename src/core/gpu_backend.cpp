@@ -4,10 +4,42 @@
 #include "common/timer.h"
 #include "settings.h"
 #include "util/state_wrapper.h"
+#include <algorithm>
+#include <cstring>
 Log_SetChannel(GPUBackend);
 
 std::unique_ptr<GPUBackend> g_gpu_backend;
 
+template<u32 CELL_SHIFT, u32 CELLS_X, u32 CELLS_Y, typename T>
+static void ForEachVRAMCell(u32 x, u32 y, u32 width, u32 height, const T& callback)
+{
+  // Regions wrap around VRAM, so the cells do too.
+  const u32 first_cell_x = x >> CELL_SHIFT;
+  const u32 first_cell_y = y >> CELL_SHIFT;
+  const u32 num_cells_x = std::min<u32>(((x + width - 1) >> CELL_SHIFT) - first_cell_x + 1, CELLS_X);
+  const u32 num_cells_y = std::min<u32>(((y + height - 1) >> CELL_SHIFT) - first_cell_y + 1, CELLS_Y);
+  for (u32 cy = 0; cy < num_cells_y; cy++)
+  {
+    const u32 row = ((first_cell_y + cy) % CELLS_Y) * CELLS_X;
+    for (u32 cx = 0; cx < num_cells_x; cx++)
+      callback(row + ((first_cell_x + cx) % CELLS_X));
+  }
+}
+
+template<typename T>
+static void GetVertexBounds(const T* vertices, u32 num_vertices, s32* min_x, s32* min_y, s32* max_x, s32* max_y)
+{
+  *min_x = *max_x = vertices[0].x;
+  *min_y = *max_y = vertices[0].y;
+  for (u32 i = 1; i < num_vertices; i++)
+  {
+    *min_x = std::min(*min_x, vertices[i].x);
+    *min_y = std::min(*min_y, vertices[i].y);
+    *max_x = std::max(*max_x, vertices[i].x);
+    *max_y = std::max(*max_y, vertices[i].y);
+  }
+}
+
 GPUBackend::GPUBackend() = default;
 
 GPUBackend::~GPUBackend() = default;
@@ -24,6 +56,14 @@ void GPUBackend::Reset(bool clear_vram)
 {
   Sync(true);
   m_drawing_area = {};
+  m_queued_drawing_area = {};
+
+  if (clear_vram && m_has_stale_cells)
+  {
+    for (u8& flags : m_vram_cell_flags)
+      flags &= ~VRAM_CELL_STALE;
+    m_has_stale_cells = false;
+  }
 }
 
 void GPUBackend::UpdateSettings()
@@ -79,6 +119,16 @@ GPUBackendDrawPolygonCommand* GPUBackend::NewDrawPolygonCommand(u32 num_vertices
   return cmd;
 }
 
+GPUBackendDrawPolygonPacketCommand* GPUBackend::NewDrawPolygonPacketCommand(GPURenderCommand rc)
+{
+  const u32 size =
+    sizeof(GPUBackendDrawPolygonPacketCommand) + (GPUBackendDrawPolygonPacketCommand::GetWordCount(rc) * sizeof(u32));
+  GPUBackendDrawPolygonPacketCommand* cmd = static_cast<GPUBackendDrawPolygonPacketCommand*>(
+    AllocateCommand(GPUBackendCommandType::DrawPolygonPacket, size));
+  cmd->num_vertices = rc.quad_polygon ? 4 : 3;
+  return cmd;
+}
+
 GPUBackendDrawRectangleCommand* GPUBackend::NewDrawRectangleCommand()
 {
   return static_cast<GPUBackendDrawRectangleCommand*>(
@@ -144,6 +194,12 @@ u32 GPUBackend::GetPendingCommandSize() const
 
 void GPUBackend::PushCommand(GPUBackendCommand* cmd)
 {
+  if (cmd->type == GPUBackendCommandType::SetDrawingArea)
+    m_queued_drawing_area = static_cast<const GPUBackendSetDrawingAreaCommand*>(cmd)->new_area;
+
+  if ((m_skip_unread_draws || m_has_stale_cells) && UpdateVRAMCellState(cmd))
+    return;
+
   if (!m_use_gpu_thread)
   {
     // single-thread mode
@@ -152,6 +208,8 @@ void GPUBackend::PushCommand(GPUBackendCommand* cmd)
   }
   else
   {
+    MarkPendingWrites(cmd, ++m_queued_command_count);
+
     const u32 new_write_ptr = m_command_fifo_write_ptr.fetch_add(cmd->size) + cmd->size;
     DebugAssert(new_write_ptr <= COMMAND_QUEUE_SIZE);
     UNREFERENCED_VARIABLE(new_write_ptr);
@@ -186,6 +244,7 @@ void GPUBackend::StopGPUThread()
   WakeGPUThread();
   m_gpu_thread.Join();
   m_use_gpu_thread = false;
+  m_completed_command_count.store(m_queued_command_count);
   Log_InfoPrint("GPU thread stopped.");
 }
 
@@ -203,6 +262,298 @@ void GPUBackend::Sync(bool allow_sleep)
   m_sync_semaphore.Wait();
 }
 
+void GPUBackend::SyncRegion(u32 x, u32 y, u32 width, u32 height)
+{
+  if (!m_use_gpu_thread || width == 0 || height == 0)
+    return;
+
+  // Find the most recently queued command which writes to the region.
+  u64 last_command_index = 0;
+  ForEachVRAMCell<VRAM_CELL_SHIFT, VRAM_CELLS_X, VRAM_CELLS_Y>(
+    x, y, width, height, [this, &last_command_index](u32 cell) {
+      last_command_index = std::max(last_command_index, m_pending_write_commands[cell]);
+    });
+
+  if (m_completed_command_count.load(std::memory_order_acquire) >= last_command_index)
+    return;
+
+  // The GPU thread may be asleep if fewer than THRESHOLD_TO_WAKE_GPU bytes of commands have been queued.
+  WakeGPUThread();
+  while (m_completed_command_count.load(std::memory_order_acquire) < last_command_index)
+    std::this_thread::yield();
+}
+
+bool GPUBackend::GetWriteRegion(const GPUBackendCommand* cmd, u32* x, u32* y, u32* width, u32* height) const
+{
+  switch (cmd->type)
+  {
+    case GPUBackendCommandType::FillVRAM:
+    {
+      const GPUBackendFillVRAMCommand* ccmd = static_cast<const GPUBackendFillVRAMCommand*>(cmd);
+      *x = ccmd->x;
+      *y = ccmd->y;
+      *width = ccmd->width;
+      *height = ccmd->height;
+      return (*width > 0 && *height > 0);
+    }
+
+    case GPUBackendCommandType::UpdateVRAM:
+    {
+      const GPUBackendUpdateVRAMCommand* ccmd = static_cast<const GPUBackendUpdateVRAMCommand*>(cmd);
+      *x = ccmd->x;
+      *y = ccmd->y;
+      *width = ccmd->width;
+      *height = ccmd->height;
+      return (*width > 0 && *height > 0);
+    }
+
+    case GPUBackendCommandType::CopyVRAM:
+    {
+      const GPUBackendCopyVRAMCommand* ccmd = static_cast<const GPUBackendCopyVRAMCommand*>(cmd);
+      *x = ccmd->dst_x;
+      *y = ccmd->dst_y;
+      *width = ccmd->width;
+      *height = ccmd->height;
+      return (*width > 0 && *height > 0);
+    }
+
+    case GPUBackendCommandType::DrawPolygon:
+    {
+      const GPUBackendDrawPolygonCommand* ccmd = static_cast<const GPUBackendDrawPolygonCommand*>(cmd);
+      s32 min_x, min_y, max_x, max_y;
+      GetVertexBounds(ccmd->vertices, ccmd->num_vertices, &min_x, &min_y, &max_x, &max_y);
+      return ClipDrawRegion(min_x, min_y, max_x, max_y, x, y, width, height);
+    }
+
+    case GPUBackendCommandType::DrawPolygonPacket:
+    {
+      const GPUBackendDrawPolygonPacketCommand* ccmd = static_cast<const GPUBackendDrawPolygonPacketCommand*>(cmd);
+      s32 min_x, min_y, max_x, max_y;
+      ccmd->GetBounds(&min_x, &min_y, &max_x, &max_y);
+      return ClipDrawRegion(min_x, min_y, max_x, max_y, x, y, width, height);
+    }
+
+    case GPUBackendCommandType::DrawRectangle:
+    {
+      const GPUBackendDrawRectangleCommand* ccmd = static_cast<const GPUBackendDrawRectangleCommand*>(cmd);
+      return ClipDrawRegion(ccmd->x, ccmd->y, ccmd->x + static_cast<s32>(ccmd->width) - 1,
+                            ccmd->y + static_cast<s32>(ccmd->height) - 1, x, y, width, height);
+    }
+
+    case GPUBackendCommandType::DrawLine:
+    {
+      const GPUBackendDrawLineCommand* ccmd = static_cast<const GPUBackendDrawLineCommand*>(cmd);
+      s32 min_x, min_y, max_x, max_y;
+      GetVertexBounds(ccmd->vertices, ccmd->num_vertices, &min_x, &min_y, &max_x, &max_y);
+      return ClipDrawRegion(min_x, min_y, max_x, max_y, x, y, width, height);
+    }
+
+    default:
+      return false;
+  }
+}
+
+bool GPUBackend::ClipDrawRegion(s32 min_x, s32 min_y, s32 max_x, s32 max_y, u32* x, u32* y, u32* width,
+                                u32* height) const
+{
+  // Primitives are clipped to the drawing area rather than wrapping.
+  min_x = std::max(min_x, static_cast<s32>(m_queued_drawing_area.left));
+  min_y = std::max(min_y, static_cast<s32>(m_queued_drawing_area.top));
+  max_x = std::min(max_x, static_cast<s32>(m_queued_drawing_area.right));
+  max_y = std::min(max_y, static_cast<s32>(m_queued_drawing_area.bottom));
+  if (min_x > max_x || min_y > max_y)
+    return false;
+
+  *x = static_cast<u32>(min_x);
+  *y = static_cast<u32>(min_y);
+  *width = static_cast<u32>(max_x - min_x + 1);
+  *height = static_cast<u32>(max_y - min_y + 1);
+  return true;
+}
+
+void GPUBackend::MarkPendingWrites(const GPUBackendCommand* cmd, u64 command_index)
+{
+  u32 x, y, width, height;
+  if (!GetWriteRegion(cmd, &x, &y, &width, &height))
+    return;
+
+  ForEachVRAMCell<VRAM_CELL_SHIFT, VRAM_CELLS_X, VRAM_CELLS_Y>(
+    x, y, width, height, [this, command_index](u32 cell) { m_pending_write_commands[cell] = command_index; });
+}
+
+void GPUBackend::SetSkipUnreadDraws(bool enabled)
+{
+  m_skip_unread_draws = enabled;
+}
+
+bool GPUBackend::SyncRegionForReadback(u32* x, u32* y, u32* width, u32* height)
+{
+  if (*width == 0 || *height == 0)
+    return true;
+
+  // Full VRAM reads come from save states and dumps rather than the game, so don't let them stop draws being skipped.
+  if (*width < VRAM_WIDTH || *height < VRAM_HEIGHT)
+    SetVRAMCellFlags(*x, *y, *width, *height, VRAM_CELL_READ);
+
+  SyncRegion(*x, *y, *width, *height);
+  if (!m_has_stale_cells || !AnyVRAMCellFlag(*x, *y, *width, *height, VRAM_CELL_STALE))
+    return true;
+
+  // Expand the region to whole cells, so they can be reloaded. Regions which wrap cover the whole of VRAM in that
+  // direction, the same as hardware renderer readbacks.
+  const u32 left = *x % VRAM_WIDTH;
+  const u32 top = *y % VRAM_HEIGHT;
+  if ((left + *width) > VRAM_WIDTH)
+  {
+    *x = 0;
+    *width = VRAM_WIDTH;
+  }
+  else
+  {
+    *x = Common::AlignDownPow2(left, VRAM_CELL_SIZE);
+    *width = Common::AlignUpPow2(left + *width, VRAM_CELL_SIZE) - *x;
+  }
+  if ((top + *height) > VRAM_HEIGHT)
+  {
+    *y = 0;
+    *height = VRAM_HEIGHT;
+  }
+  else
+  {
+    *y = Common::AlignDownPow2(top, VRAM_CELL_SIZE);
+    *height = Common::AlignUpPow2(top + *height, VRAM_CELL_SIZE) - *y;
+  }
+
+  return false;
+}
+
+void GPUBackend::ReloadRegion(u32 x, u32 y, u32 width, u32 height, const u16* vram)
+{
+  DebugAssert(Common::IsAlignedPow2(x, VRAM_CELL_SIZE) && Common::IsAlignedPow2(y, VRAM_CELL_SIZE) &&
+              Common::IsAlignedPow2(width, VRAM_CELL_SIZE) && Common::IsAlignedPow2(height, VRAM_CELL_SIZE));
+
+  // Only the cells which are out of date are replaced, so anything which was rendered here is kept.
+  for (u32 cell_y = y; cell_y < (y + height); cell_y += VRAM_CELL_SIZE)
+  {
+    for (u32 cell_x = x; cell_x < (x + width); cell_x += VRAM_CELL_SIZE)
+    {
+      if (!(m_vram_cell_flags[(cell_y >> VRAM_CELL_SHIFT) * VRAM_CELLS_X + (cell_x >> VRAM_CELL_SHIFT)] &
+            VRAM_CELL_STALE))
+      {
+        continue;
+      }
+
+      GPUBackendUpdateVRAMCommand* cmd = NewUpdateVRAMCommand(VRAM_CELL_SIZE * VRAM_CELL_SIZE);
+      cmd->params.bits = 0;
+      cmd->x = static_cast<u16>(cell_x);
+      cmd->y = static_cast<u16>(cell_y);
+      cmd->width = VRAM_CELL_SIZE;
+      cmd->height = VRAM_CELL_SIZE;
+      for (u32 row = 0; row < VRAM_CELL_SIZE; row++)
+      {
+        std::memcpy(&cmd->data[row * VRAM_CELL_SIZE], &vram[(cell_y + row) * VRAM_WIDTH + cell_x],
+                    VRAM_CELL_SIZE * sizeof(u16));
+      }
+      PushCommand(cmd);
+    }
+  }
+
+  SyncRegion(x, y, width, height);
+}
+
+bool GPUBackend::UpdateVRAMCellState(const GPUBackendCommand* cmd)
+{
+  u32 x, y, width, height;
+  if (!GetWriteRegion(cmd, &x, &y, &width, &height))
+    return false;
+
+  bool reads_stale_cells = false;
+  switch (cmd->type)
+  {
+    case GPUBackendCommandType::FillVRAM:
+    {
+      ClearCoveredVRAMCellFlags(x, y, width, height, VRAM_CELL_STALE);
+    }
+    break;
+
+    case GPUBackendCommandType::UpdateVRAM:
+    {
+      // With mask checking, some of the old pixels may be kept.
+      if (!cmd->params.check_mask_before_draw)
+        ClearCoveredVRAMCellFlags(x, y, width, height, VRAM_CELL_STALE);
+    }
+    break;
+
+    case GPUBackendCommandType::CopyVRAM:
+    {
+      const GPUBackendCopyVRAMCommand* ccmd = static_cast<const GPUBackendCopyVRAMCommand*>(cmd);
+      reads_stale_cells = AnyVRAMCellFlag(ccmd->src_x, ccmd->src_y, ccmd->width, ccmd->height, VRAM_CELL_STALE);
+    }
+    break;
+
+    default:
+    {
+      if (m_skip_unread_draws && !AnyVRAMCellFlag(x, y, width, height, VRAM_CELL_READ))
+      {
+        SetVRAMCellFlags(x, y, width, height, VRAM_CELL_STALE);
+        m_has_stale_cells = true;
+        return true;
+      }
+
+      const GPUBackendDrawCommand* dcmd = static_cast<const GPUBackendDrawCommand*>(cmd);
+      if (cmd->type != GPUBackendCommandType::DrawLine && dcmd->rc.texture_enable)
+      {
+        const Common::Rectangle<u32> page = dcmd->draw_mode.GetTexturePageRectangle();
+        reads_stale_cells = AnyVRAMCellFlag(page.left, page.top, page.GetWidth(), page.GetHeight(), VRAM_CELL_STALE);
+        if (dcmd->draw_mode.IsUsingPalette())
+        {
+          const u32 clut_width = (dcmd->draw_mode.texture_mode == GPUTextureMode::Palette4Bit) ? 16 : 256;
+          reads_stale_cells |=
+            AnyVRAMCellFlag(dcmd->palette.GetXBase(), dcmd->palette.GetYBase(), clut_width, 1, VRAM_CELL_STALE);
+        }
+      }
+    }
+    break;
+  }
+
+  // Anything drawn from out of date data is out of date too.
+  if (reads_stale_cells)
+    SetVRAMCellFlags(x, y, width, height, VRAM_CELL_STALE);
+
+  return false;
+}
+
+void GPUBackend::SetVRAMCellFlags(u32 x, u32 y, u32 width, u32 height, u8 flags)
+{
+  ForEachVRAMCell<VRAM_CELL_SHIFT, VRAM_CELLS_X, VRAM_CELLS_Y>(
+    x, y, width, height, [this, flags](u32 cell) { m_vram_cell_flags[cell] |= flags; });
+}
+
+void GPUBackend::ClearCoveredVRAMCellFlags(u32 x, u32 y, u32 width, u32 height, u8 flags)
+{
+  // Only cells which are completely overwritten are affected. Wrapped regions are rare enough to ignore.
+  if ((x + width) > VRAM_WIDTH || (y + height) > VRAM_HEIGHT)
+    return;
+
+  const u32 first_cell_x = Common::AlignUpPow2(x, VRAM_CELL_SIZE) >> VRAM_CELL_SHIFT;
+  const u32 first_cell_y = Common::AlignUpPow2(y, VRAM_CELL_SIZE) >> VRAM_CELL_SHIFT;
+  const u32 end_cell_x = (x + width) >> VRAM_CELL_SHIFT;
+  const u32 end_cell_y = (y + height) >> VRAM_CELL_SHIFT;
+  for (u32 cy = first_cell_y; cy < end_cell_y; cy++)
+  {
+    for (u32 cx = first_cell_x; cx < end_cell_x; cx++)
+      m_vram_cell_flags[cy * VRAM_CELLS_X + cx] &= ~flags;
+  }
+}
+
+bool GPUBackend::AnyVRAMCellFlag(u32 x, u32 y, u32 width, u32 height, u8 flags) const
+{
+  bool result = false;
+  ForEachVRAMCell<VRAM_CELL_SHIFT, VRAM_CELLS_X, VRAM_CELLS_Y>(
+    x, y, width, height, [this, flags, &result](u32 cell) { result |= ((m_vram_cell_flags[cell] & flags) != 0); });
+  return result;
+}
+
 void GPUBackend::RunGPULoop()
 {
   static constexpr double SPIN_TIME_NS = 1 * 1000000;
@@ -253,12 +604,16 @@ void GPUBackend::RunGPULoop()
           DebugAssert(read_ptr == write_ptr);
           m_sync_semaphore.Post();
           allow_sleep = static_cast<const GPUBackendSyncCommand*>(cmd)->allow_sleep;
+          m_completed_command_count.fetch_add(1, std::memory_order_release);
         }
         break;
 
         default:
+        {
           HandleCommand(cmd);
-          break;
+          m_completed_command_count.fetch_add(1, std::memory_order_release);
+        }
+        break;
       }
     }
 
@@ -312,6 +667,32 @@ void GPUBackend::HandleCommand(const GPUBackendCommand* cmd)
     }
     break;
 
+    case GPUBackendCommandType::DrawPolygonPacket:
+    {
+      // Expand to a regular polygon command, so the renderer doesn't need to know about packets.
+      const GPUBackendDrawPolygonPacketCommand* ccmd = static_cast<const GPUBackendDrawPolygonPacketCommand*>(cmd);
+      alignas(GPUBackendDrawPolygonCommand) u8
+        buffer[sizeof(GPUBackendDrawPolygonCommand) + 4 * sizeof(GPUBackendDrawPolygonCommand::Vertex)];
+      GPUBackendDrawPolygonCommand* dcmd = reinterpret_cast<GPUBackendDrawPolygonCommand*>(buffer);
+      dcmd->type = GPUBackendCommandType::DrawPolygon;
+      dcmd->size = sizeof(buffer);
+      dcmd->params.bits = ccmd->params.bits;
+      dcmd->draw_mode.bits = ccmd->draw_mode.bits;
+      dcmd->rc.bits = ccmd->rc.bits;
+      dcmd->palette.bits = ccmd->palette.bits;
+      dcmd->window = ccmd->window;
+      dcmd->num_vertices = ccmd->num_vertices;
+      for (u32 i = 0; i < ccmd->num_vertices; i++)
+      {
+        const GPUVertexPosition vp{ccmd->GetPosition(i)};
+        dcmd->vertices[i].Set(ccmd->drawing_offset_x + vp.x, ccmd->drawing_offset_y + vp.y, ccmd->GetColor(i),
+                              ccmd->GetTexcoord(i));
+      }
+
+      DrawPolygon(dcmd);
+    }
+    break;
+
     case GPUBackendCommandType::DrawRectangle:
     {
       DrawRectangle(static_cast<const GPUBackendDrawRectangleCommand*>(cmd));
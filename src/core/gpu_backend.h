@@ -2,6 +2,7 @@
 #include "common/heap_array.h"
 #include "common/threading.h"
 #include "gpu_types.h"
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <memory>
@@ -32,12 +33,30 @@ public:
   GPUBackendCopyVRAMCommand* NewCopyVRAMCommand();
   GPUBackendSetDrawingAreaCommand* NewSetDrawingAreaCommand();
   GPUBackendDrawPolygonCommand* NewDrawPolygonCommand(u32 num_vertices);
+  GPUBackendDrawPolygonPacketCommand* NewDrawPolygonPacketCommand(GPURenderCommand rc);
   GPUBackendDrawRectangleCommand* NewDrawRectangleCommand();
   GPUBackendDrawLineCommand* NewDrawLineCommand(u32 num_vertices);
 
   void PushCommand(GPUBackendCommand* cmd);
   void Sync(bool allow_sleep);
 
+  /// Waits until all queued commands which write to the specified region of VRAM have completed. Commands which only
+  /// write to other parts of VRAM may still be running on the GPU thread afterwards. The region wraps around VRAM.
+  void SyncRegion(u32 x, u32 y, u32 width, u32 height);
+
+  /// Drops draws which only write to parts of VRAM that have never been read back with SyncRegionForReadback(). For
+  /// mirroring the hardware renderer, where this VRAM is only used to serve readbacks.
+  void SetSkipUnreadDraws(bool enabled);
+
+  /// Waits for queued writes to the region like SyncRegion(), and records that it has been read back. Returns false if
+  /// any of the region is out of date because draws were skipped. The region is then expanded to the area which needs
+  /// to be passed to ReloadRegion().
+  bool SyncRegionForReadback(u32* x, u32* y, u32* width, u32* height);
+
+  /// Replaces the out of date parts of a region from vram, which is a full VRAM image, e.g. read from the hardware
+  /// renderer.
+  void ReloadRegion(u32 x, u32 y, u32 width, u32 height, const u16* vram);
+
   /// Processes all pending GPU commands.
   void RunGPULoop();
 
@@ -48,6 +67,19 @@ protected:
   void StartGPUThread();
   void StopGPUThread();
 
+  /// Returns the region of VRAM which a command writes to, before it is executed. Transfers can wrap around VRAM.
+  bool GetWriteRegion(const GPUBackendCommand* cmd, u32* x, u32* y, u32* width, u32* height) const;
+  bool ClipDrawRegion(s32 min_x, s32 min_y, s32 max_x, s32 max_y, u32* x, u32* y, u32* width, u32* height) const;
+
+  /// Records which parts of VRAM a queued command writes to, so that readbacks only need to wait for those commands.
+  void MarkPendingWrites(const GPUBackendCommand* cmd, u64 command_index);
+
+  /// Tracks which parts of VRAM are out of date when skipping unread draws. Returns true if the command is skipped.
+  bool UpdateVRAMCellState(const GPUBackendCommand* cmd);
+  void SetVRAMCellFlags(u32 x, u32 y, u32 width, u32 height, u8 flags);
+  void ClearCoveredVRAMCellFlags(u32 x, u32 y, u32 width, u32 height, u8 flags);
+  bool AnyVRAMCellFlag(u32 x, u32 y, u32 width, u32 height, u8 flags) const;
+
   virtual void FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color, GPUBackendCommandParameters params) = 0;
   virtual void UpdateVRAM(u32 x, u32 y, u32 width, u32 height, const void* data,
                           GPUBackendCommandParameters params) = 0;
@@ -85,6 +117,32 @@ protected:
   HeapArray<u8, COMMAND_QUEUE_SIZE> m_command_fifo_data;
   alignas(64) std::atomic<u32> m_command_fifo_read_ptr{0};
   alignas(64) std::atomic<u32> m_command_fifo_write_ptr{0};
+
+  // Pending writes and readbacks are tracked at a granularity of 64x64 pixel cells.
+  enum : u32
+  {
+    VRAM_CELL_SHIFT = 6,
+    VRAM_CELL_SIZE = 1u << VRAM_CELL_SHIFT,
+    VRAM_CELLS_X = VRAM_WIDTH >> VRAM_CELL_SHIFT,
+    VRAM_CELLS_Y = VRAM_HEIGHT >> VRAM_CELL_SHIFT,
+  };
+
+  enum : u8
+  {
+    VRAM_CELL_READ = (1 << 0),
+    VRAM_CELL_STALE = (1 << 1),
+  };
+
+  // Only accessed by the CPU thread. Each cell holds the index of the last queued command which writes to it.
+  std::array<u64, VRAM_CELLS_X * VRAM_CELLS_Y> m_pending_write_commands{};
+  std::array<u8, VRAM_CELLS_X * VRAM_CELLS_Y> m_vram_cell_flags{};
+  Common::Rectangle<u32> m_queued_drawing_area{};
+  u64 m_queued_command_count = 0;
+  bool m_skip_unread_draws = false;
+  bool m_has_stale_cells = false;
+
+  // Number of commands the GPU thread has executed, in queue order.
+  alignas(64) std::atomic<u64> m_completed_command_count{0};
 };
 
 #ifdef _MSC_VER
@@ -2,6 +2,7 @@
 #include "common/align.h"
 #include "common/assert.h"
 #include "common/log.h"
+#include "common/platform.h"
 #include "cpu_core.h"
 #include "gpu_sw_backend.h"
 #include "host.h"
@@ -10,11 +11,23 @@
 #include "settings.h"
 #include "system.h"
 #include "util/state_wrapper.h"
+#include <array>
 #include <cmath>
+#include <cstring>
 #include <sstream>
 #include <tuple>
 Log_SetChannel(GPU_HW);
 
+#if defined(CPU_X64)
+#include <emmintrin.h>
+#elif defined(CPU_AARCH64)
+#ifdef _MSC_VER
+#include <arm64_neon.h>
+#else
+#include <arm_neon.h>
+#endif
+#endif
+
 template<typename T>
 ALWAYS_INLINE static constexpr std::tuple<T, T> MinMax(T v1, T v2)
 {
@@ -343,18 +356,32 @@ void GPU_HW::HandleFlippedQuadTextureCoordinates(BatchVertex* vertices)
 
   // Use floats here as it'll be faster than integer divides.
   const float rcp_area = 1.0f / area;
+
+  // The derivatives are laid out as {dudx, dvdx, dudy, dvdy}, and the sign tests are packed into an 8-bit code, with
+  // the negative tests in the low nibble and the zero tests in the high nibble, which indexes the offset LUT.
+  u32 code;
+#if defined(CPU_X64)
+  const __m128 d_area = _mm_mul_ps(_mm_setr_ps(dudx, dvdx, dudy, dvdy), _mm_set1_ps(rcp_area));
+  const __m128 zero = _mm_setzero_ps();
+  code = static_cast<u32>(_mm_movemask_ps(_mm_cmplt_ps(d_area, zero))) |
+         (static_cast<u32>(_mm_movemask_ps(_mm_cmpeq_ps(d_area, zero))) << 4);
+#elif defined(CPU_AARCH64)
+  // Brace-initializing the vector type isn't portable (MSVC's is a union), so load it from memory.
+  alignas(16) static constexpr u32 lane_bits[4] = {1, 2, 4, 8};
+  alignas(16) const float d_values[4] = {dudx, dvdx, dudy, dvdy};
+  const float32x4_t d_area = vmulq_n_f32(vld1q_f32(d_values), rcp_area);
+  const uint32x4_t bits = vld1q_u32(lane_bits);
+  code = vaddvq_u32(vandq_u32(vcltzq_f32(d_area), bits)) | (vaddvq_u32(vandq_u32(vceqzq_f32(d_area), bits)) << 4);
+#else
   const float dudx_area = dudx * rcp_area;
   const float dudy_area = dudy * rcp_area;
   const float dvdx_area = dvdx * rcp_area;
   const float dvdy_area = dvdy * rcp_area;
-  const bool neg_dudx = dudx_area < 0.0f;
-  const bool neg_dudy = dudy_area < 0.0f;
-  const bool neg_dvdx = dvdx_area < 0.0f;
-  const bool neg_dvdy = dvdy_area < 0.0f;
-  const bool zero_dudx = dudx_area == 0.0f;
-  const bool zero_dudy = dudy_area == 0.0f;
-  const bool zero_dvdx = dvdx_area == 0.0f;
-  const bool zero_dvdy = dvdy_area == 0.0f;
+  code = BoolToUInt32(dudx_area < 0.0f) | (BoolToUInt32(dvdx_area < 0.0f) << 1) |
+         (BoolToUInt32(dudy_area < 0.0f) << 2) | (BoolToUInt32(dvdy_area < 0.0f) << 3) |
+         (BoolToUInt32(dudx_area == 0.0f) << 4) | (BoolToUInt32(dvdx_area == 0.0f) << 5) |
+         (BoolToUInt32(dudy_area == 0.0f) << 6) | (BoolToUInt32(dvdy_area == 0.0f) << 7);
+#endif
 
   // If we have negative dU or dV in any direction, increment the U or V to work properly with nearest-neighbor in
   // this impl. If we don't have 1:1 pixel correspondence, this creates a slight "shift" in the sprite, but we
@@ -362,47 +389,89 @@ void GPU_HW::HandleFlippedQuadTextureCoordinates(BatchVertex* vertices)
   // rare cases where 3D meshes hit this scenario, and a single texel offset can pop in, but this is way better than
   // having borked 2D overall.
   //
-  // TODO: If perf becomes an issue, we can probably SIMD the 8 comparisons above,
-  // create an 8-bit code, and use a LUT to get the offsets.
   // Case 1: U is decreasing in X, but no change in Y.
   // Case 2: U is decreasing in Y, but no change in X.
   // Case 3: V is decreasing in X, but no change in Y.
   // Case 4: V is decreasing in Y, but no change in X.
-  if ((neg_dudx && zero_dudy) || (neg_dudy && zero_dudx))
-  {
-    vertices[0].u++;
-    vertices[1].u++;
-    vertices[2].u++;
-    vertices[3].u++;
-  }
+  static constexpr std::array<u8, 256> s_offset_lut = []() {
+    std::array<u8, 256> lut = {};
+    for (u32 i = 0; i < 256; i++)
+    {
+      const bool neg_dudx = (i & 0x01) != 0, neg_dvdx = (i & 0x02) != 0;
+      const bool neg_dudy = (i & 0x04) != 0, neg_dvdy = (i & 0x08) != 0;
+      const bool zero_dudx = (i & 0x10) != 0, zero_dvdx = (i & 0x20) != 0;
+      const bool zero_dudy = (i & 0x40) != 0, zero_dvdy = (i & 0x80) != 0;
+      const bool inc_u = (neg_dudx && zero_dudy) || (neg_dudy && zero_dudx);
+      const bool inc_v = (neg_dvdx && zero_dvdy) || (neg_dvdy && zero_dvdx);
+      lut[i] = static_cast<u8>((inc_u ? 1u : 0u) | (inc_v ? 2u : 0u));
+    }
+    return lut;
+  }();
+
+  const u8 offsets = s_offset_lut[code];
+  if (offsets == 0)
+    return;
 
-  if ((neg_dvdx && zero_dvdy) || (neg_dvdy && zero_dvdx))
+  const u16 inc_u = offsets & 1u;
+  const u16 inc_v = offsets >> 1;
+  for (u32 i = 0; i < 4; i++)
   {
-    vertices[0].v++;
-    vertices[1].v++;
-    vertices[2].v++;
-    vertices[3].v++;
+    vertices[i].u += inc_u;
+    vertices[i].v += inc_v;
   }
 }
 
 void GPU_HW::ComputePolygonUVLimits(BatchVertex* vertices, u32 num_vertices)
 {
-  u16 min_u = vertices[0].u, max_u = vertices[0].u, min_v = vertices[0].v, max_v = vertices[0].v;
-  for (u32 i = 1; i < num_vertices; i++)
+  DebugAssert(num_vertices == 3 || num_vertices == 4);
+
+  // u and v are adjacent, so each vertex's texcoords can be loaded as a single u|v<<16 word. Triangles repeat the
+  // first vertex in the last lane, which doesn't change the result.
+  std::array<u32, 4> uv;
+  for (u32 i = 0; i < 3; i++)
+    std::memcpy(&uv[i], &vertices[i].u, sizeof(u32));
+  std::memcpy(&uv[3], &vertices[(num_vertices == 4) ? 3 : 0].u, sizeof(u32));
+
+  u16 min_u, max_u, min_v, max_v;
+#if defined(CPU_X64)
+  // Texcoords are at most 256, so the signed 16-bit min/max is fine.
+  const __m128i uvv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(uv.data()));
+  __m128i minv = _mm_min_epi16(uvv, _mm_shuffle_epi32(uvv, _MM_SHUFFLE(1, 0, 3, 2)));
+  __m128i maxv = _mm_max_epi16(uvv, _mm_shuffle_epi32(uvv, _MM_SHUFFLE(1, 0, 3, 2)));
+  minv = _mm_min_epi16(minv, _mm_shuffle_epi32(minv, _MM_SHUFFLE(2, 3, 0, 1)));
+  maxv = _mm_max_epi16(maxv, _mm_shuffle_epi32(maxv, _MM_SHUFFLE(2, 3, 0, 1)));
+  const u32 min_uv = static_cast<u32>(_mm_cvtsi128_si32(minv));
+  const u32 max_uv = static_cast<u32>(_mm_cvtsi128_si32(maxv));
+  min_u = Truncate16(min_uv);
+  min_v = Truncate16(min_uv >> 16);
+  max_u = Truncate16(max_uv);
+  max_v = Truncate16(max_uv >> 16);
+#elif defined(CPU_AARCH64)
+  const uint16x4x2_t uvv = vld2_u16(reinterpret_cast<const u16*>(uv.data()));
+  min_u = vminv_u16(uvv.val[0]);
+  max_u = vmaxv_u16(uvv.val[0]);
+  min_v = vminv_u16(uvv.val[1]);
+  max_v = vmaxv_u16(uvv.val[1]);
+#else
+  min_u = max_u = Truncate16(uv[0]);
+  min_v = max_v = Truncate16(uv[0] >> 16);
+  for (u32 i = 1; i < 4; i++)
   {
-    min_u = std::min<u16>(min_u, vertices[i].u);
-    max_u = std::max<u16>(max_u, vertices[i].u);
-    min_v = std::min<u16>(min_v, vertices[i].v);
-    max_v = std::max<u16>(max_v, vertices[i].v);
+    min_u = std::min<u16>(min_u, Truncate16(uv[i]));
+    max_u = std::max<u16>(max_u, Truncate16(uv[i]));
+    min_v = std::min<u16>(min_v, Truncate16(uv[i] >> 16));
+    max_v = std::max<u16>(max_v, Truncate16(uv[i] >> 16));
   }
+#endif
 
   if (min_u != max_u)
     max_u--;
   if (min_v != max_v)
     max_v--;
 
+  const u32 uv_limits = BatchVertex::PackUVLimits(min_u, max_u, min_v, max_v);
   for (u32 i = 0; i < num_vertices; i++)
-    vertices[i].SetUVLimits(min_u, max_u, min_v, max_v);
+    vertices[i].uv_limits = uv_limits;
 }
 
 void GPU_HW::SetBatchDepthBuffer(bool enabled)
@@ -1124,7 +1193,11 @@ void GPU_HW::UpdateSoftwareRenderer(bool copy_vram_from_hw)
   const bool current_enabled = (m_sw_renderer != nullptr);
   const bool new_enabled = g_settings.gpu_use_software_renderer_for_readbacks;
   if (current_enabled == new_enabled)
+  {
+    if (m_sw_renderer)
+      m_sw_renderer->SetSkipUnreadDraws(ShouldSkipUnreadSoftwareRendererDraws());
     return;
+  }
 
   m_vram_ptr = m_vram_shadow.data();
 
@@ -1154,9 +1227,17 @@ void GPU_HW::UpdateSoftwareRenderer(bool copy_vram_from_hw)
   }
 
   m_sw_renderer = std::move(sw_renderer);
+  m_sw_renderer->SetSkipUnreadDraws(ShouldSkipUnreadSoftwareRendererDraws());
   m_vram_ptr = m_sw_renderer->GetVRAM();
 }
 
+bool GPU_HW::ShouldSkipUnreadSoftwareRendererDraws()
+{
+  // Rewind and runahead save state every frame, which reads back all of VRAM. Anything which was skipped would have to
+  // be downloaded from the GPU each time, which is slower than just drawing it.
+  return (!g_settings.rewind_enable && !g_settings.IsRunaheadEnabled());
+}
+
 void GPU_HW::FillBackendCommandParameters(GPUBackendCommand* cmd) const
 {
   cmd->params.bits = 0;
@@ -1175,10 +1256,16 @@ void GPU_HW::FillDrawCommand(GPUBackendDrawCommand* cmd, GPURenderCommand rc) co
   cmd->window = m_draw_mode.texture_window;
 }
 
-void GPU_HW::ReadSoftwareRendererVRAM(u32 x, u32 y, u32 width, u32 height)
+bool GPU_HW::ReadSoftwareRendererVRAM(u32* x, u32* y, u32* width, u32* height)
+{
+  DebugAssert(m_sw_renderer);
+  return m_sw_renderer->SyncRegionForReadback(x, y, width, height);
+}
+
+void GPU_HW::ReloadSoftwareRendererVRAM(const Common::Rectangle<u32>& rect)
 {
   DebugAssert(m_sw_renderer);
-  m_sw_renderer->Sync(false);
+  m_sw_renderer->ReloadRegion(rect.left, rect.top, rect.GetWidth(), rect.GetHeight(), m_vram_shadow.data());
 }
 
 void GPU_HW::UpdateSoftwareRendererVRAM(u32 x, u32 y, u32 width, u32 height, const void* data, bool set_mask,
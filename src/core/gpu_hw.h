@@ -293,7 +293,9 @@ protected:
   void FillBackendCommandParameters(GPUBackendCommand* cmd) const;
   void FillDrawCommand(GPUBackendDrawCommand* cmd, GPURenderCommand rc) const;
   void UpdateSoftwareRenderer(bool copy_vram_from_hw);
-  void ReadSoftwareRendererVRAM(u32 x, u32 y, u32 width, u32 height);
+  static bool ShouldSkipUnreadSoftwareRendererDraws();
+  bool ReadSoftwareRendererVRAM(u32* x, u32* y, u32* width, u32* height);
+  void ReloadSoftwareRendererVRAM(const Common::Rectangle<u32>& rect);
   void UpdateSoftwareRendererVRAM(u32 x, u32 y, u32 width, u32 height, const void* data, bool set_mask,
                                   bool check_mask);
   void FillSoftwareRendererVRAM(u32 x, u32 y, u32 width, u32 height, u32 color);
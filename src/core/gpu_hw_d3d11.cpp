@@ -935,11 +935,9 @@ void GPU_HW_D3D11::UpdateDisplay()
 
 void GPU_HW_D3D11::ReadVRAM(u32 x, u32 y, u32 width, u32 height)
 {
-  if (IsUsingSoftwareRendererForReadbacks())
-  {
-    ReadSoftwareRendererVRAM(x, y, width, height);
+  // Parts of VRAM which the software renderer skipped drawing to are downloaded from the GPU instead.
+  if (IsUsingSoftwareRendererForReadbacks() && ReadSoftwareRendererVRAM(&x, &y, &width, &height))
     return;
-  }
 
   // Get bounds with wrap-around handled.
   const Common::Rectangle<u32> copy_rect = GetVRAMTransferBounds(x, y, width, height);
@@ -972,6 +970,9 @@ void GPU_HW_D3D11::ReadVRAM(u32 x, u32 y, u32 width, u32 height)
   }
 
   RestoreGraphicsAPIState();
+
+  if (IsUsingSoftwareRendererForReadbacks())
+    ReloadSoftwareRendererVRAM(copy_rect);
 }
 
 void GPU_HW_D3D11::FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color)
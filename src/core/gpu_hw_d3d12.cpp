@@ -947,11 +947,9 @@ void GPU_HW_D3D12::UpdateDisplay()
 
 void GPU_HW_D3D12::ReadVRAM(u32 x, u32 y, u32 width, u32 height)
 {
-  if (IsUsingSoftwareRendererForReadbacks())
-  {
-    ReadSoftwareRendererVRAM(x, y, width, height);
+  // Parts of VRAM which the software renderer skipped drawing to are downloaded from the GPU instead.
+  if (IsUsingSoftwareRendererForReadbacks() && ReadSoftwareRendererVRAM(&x, &y, &width, &height))
     return;
-  }
 
   // Get bounds with wrap-around handled.
   const Common::Rectangle<u32> copy_rect = GetVRAMTransferBounds(x, y, width, height);
@@ -985,6 +983,9 @@ void GPU_HW_D3D12::ReadVRAM(u32 x, u32 y, u32 width, u32 height)
                                              VRAM_WIDTH * sizeof(u16));
 
   RestoreGraphicsAPIState();
+
+  if (IsUsingSoftwareRendererForReadbacks())
+    ReloadSoftwareRendererVRAM(copy_rect);
 }
 
 void GPU_HW_D3D12::FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color)
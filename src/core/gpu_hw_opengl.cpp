@@ -981,11 +981,9 @@ void GPU_HW_OpenGL::UpdateDisplay()
 
 void GPU_HW_OpenGL::ReadVRAM(u32 x, u32 y, u32 width, u32 height)
 {
-  if (IsUsingSoftwareRendererForReadbacks())
-  {
-    ReadSoftwareRendererVRAM(x, y, width, height);
+  // Parts of VRAM which the software renderer skipped drawing to are downloaded from the GPU instead.
+  if (IsUsingSoftwareRendererForReadbacks() && ReadSoftwareRendererVRAM(&x, &y, &width, &height))
     return;
-  }
 
   // Get bounds with wrap-around handled.
   const Common::Rectangle<u32> copy_rect = GetVRAMTransferBounds(x, y, width, height);
@@ -1014,6 +1012,9 @@ void GPU_HW_OpenGL::ReadVRAM(u32 x, u32 y, u32 width, u32 height)
   glPixelStorei(GL_PACK_ALIGNMENT, 4);
   glPixelStorei(GL_PACK_ROW_LENGTH, 0);
   RestoreGraphicsAPIState();
+
+  if (IsUsingSoftwareRendererForReadbacks())
+    ReloadSoftwareRendererVRAM(copy_rect);
 }
 
 void GPU_HW_OpenGL::FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color)
@@ -1538,11 +1538,9 @@ void GPU_HW_Vulkan::UpdateDisplay()
 
 void GPU_HW_Vulkan::ReadVRAM(u32 x, u32 y, u32 width, u32 height)
 {
-  if (IsUsingSoftwareRendererForReadbacks())
-  {
-    ReadSoftwareRendererVRAM(x, y, width, height);
+  // Parts of VRAM which the software renderer skipped drawing to are downloaded from the GPU instead.
+  if (IsUsingSoftwareRendererForReadbacks() && ReadSoftwareRendererVRAM(&x, &y, &width, &height))
     return;
-  }
 
   // Get bounds with wrap-around handled.
   const Common::Rectangle<u32> copy_rect = GetVRAMTransferBounds(x, y, width, height);
@@ -1586,6 +1584,9 @@ void GPU_HW_Vulkan::ReadVRAM(u32 x, u32 y, u32 width, u32 height)
   m_vram_readback_staging_texture.ReadTexels(0, 0, encoded_width, encoded_height,
                                              &m_vram_shadow[copy_rect.top * VRAM_WIDTH + copy_rect.left],
                                              VRAM_WIDTH * sizeof(u16));
+
+  if (IsUsingSoftwareRendererForReadbacks())
+    ReloadSoftwareRendererVRAM(copy_rect);
 }
 
 void GPU_HW_Vulkan::FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color)
@@ -582,6 +582,13 @@ void GPU_SW::DispatchRenderCommand()
   {
     case GPUPrimitive::Polygon:
     {
+      // When rendering on a separate thread, only the positions are needed here.
+      if (m_backend.GetThread())
+      {
+        DispatchPolygonPacket(rc);
+        return;
+      }
+
       const u32 num_vertices = rc.quad_polygon ? 4 : 3;
       GPUBackendDrawPolygonCommand* cmd = m_backend.NewDrawPolygonCommand(num_vertices);
       FillDrawCommand(cmd, rc);
@@ -603,49 +610,7 @@ void GPU_SW::DispatchRenderCommand()
       if (!IsDrawingAreaIsValid())
         return;
 
-      // Cull polygons which are too large.
-      const auto [min_x_12, max_x_12] = MinMax(cmd->vertices[1].x, cmd->vertices[2].x);
-      const auto [min_y_12, max_y_12] = MinMax(cmd->vertices[1].y, cmd->vertices[2].y);
-      const s32 min_x = std::min(min_x_12, cmd->vertices[0].x);
-      const s32 max_x = std::max(max_x_12, cmd->vertices[0].x);
-      const s32 min_y = std::min(min_y_12, cmd->vertices[0].y);
-      const s32 max_y = std::max(max_y_12, cmd->vertices[0].y);
-
-      if ((max_x - min_x) >= MAX_PRIMITIVE_WIDTH || (max_y - min_y) >= MAX_PRIMITIVE_HEIGHT)
-      {
-        Log_DebugPrintf("Culling too-large polygon: %d,%d %d,%d %d,%d", cmd->vertices[0].x, cmd->vertices[0].y,
-                        cmd->vertices[1].x, cmd->vertices[1].y, cmd->vertices[2].x, cmd->vertices[2].y);
-      }
-      else
-      {
-        AddDrawTriangleTicks(cmd->vertices[0].x, cmd->vertices[0].y, cmd->vertices[1].x, cmd->vertices[1].y,
-                             cmd->vertices[2].x, cmd->vertices[2].y, rc.shading_enable, rc.texture_enable,
-                             rc.transparency_enable);
-      }
-
-      // quads
-      if (rc.quad_polygon)
-      {
-        const s32 min_x_123 = std::min(min_x_12, cmd->vertices[3].x);
-        const s32 max_x_123 = std::max(max_x_12, cmd->vertices[3].x);
-        const s32 min_y_123 = std::min(min_y_12, cmd->vertices[3].y);
-        const s32 max_y_123 = std::max(max_y_12, cmd->vertices[3].y);
-
-        // Cull polygons which are too large.
-        if ((max_x_123 - min_x_123) >= MAX_PRIMITIVE_WIDTH || (max_y_123 - min_y_123) >= MAX_PRIMITIVE_HEIGHT)
-        {
-          Log_DebugPrintf("Culling too-large polygon (quad second half): %d,%d %d,%d %d,%d", cmd->vertices[2].x,
-                          cmd->vertices[2].y, cmd->vertices[1].x, cmd->vertices[1].y, cmd->vertices[0].x,
-                          cmd->vertices[0].y);
-        }
-        else
-        {
-          AddDrawTriangleTicks(cmd->vertices[2].x, cmd->vertices[2].y, cmd->vertices[1].x, cmd->vertices[1].y,
-                               cmd->vertices[3].x, cmd->vertices[3].y, rc.shading_enable, rc.texture_enable,
-                               rc.transparency_enable);
-        }
-      }
-
+      AddDrawPolygonTicks(rc, cmd->vertices);
       m_backend.PushCommand(cmd);
     }
     break;
@@ -831,9 +796,74 @@ void GPU_SW::DispatchRenderCommand()
   }
 }
 
+void GPU_SW::DispatchPolygonPacket(GPURenderCommand rc)
+{
+  GPUBackendDrawPolygonPacketCommand* cmd = m_backend.NewDrawPolygonPacketCommand(rc);
+  FillDrawCommand(cmd, rc);
+  cmd->drawing_offset_x = m_drawing_offset.x;
+  cmd->drawing_offset_y = m_drawing_offset.y;
+
+  const u32 num_words = GPUBackendDrawPolygonPacketCommand::GetWordCount(rc);
+  for (u32 i = 0; i < num_words; i++)
+    cmd->words[i] = FifoPop();
+
+  if (!IsDrawingAreaIsValid())
+    return;
+
+  std::array<GPUBackendDrawPolygonCommand::Vertex, 4> vertices;
+  for (u32 i = 0; i < cmd->num_vertices; i++)
+    cmd->GetDrawPosition(i, &vertices[i].x, &vertices[i].y);
+
+  AddDrawPolygonTicks(rc, vertices.data());
+  m_backend.PushCommand(cmd);
+}
+
+void GPU_SW::AddDrawPolygonTicks(GPURenderCommand rc, const GPUBackendDrawPolygonCommand::Vertex* vertices)
+{
+  // Cull polygons which are too large.
+  const auto [min_x_12, max_x_12] = MinMax(vertices[1].x, vertices[2].x);
+  const auto [min_y_12, max_y_12] = MinMax(vertices[1].y, vertices[2].y);
+  const s32 min_x = std::min(min_x_12, vertices[0].x);
+  const s32 max_x = std::max(max_x_12, vertices[0].x);
+  const s32 min_y = std::min(min_y_12, vertices[0].y);
+  const s32 max_y = std::max(max_y_12, vertices[0].y);
+
+  if ((max_x - min_x) >= MAX_PRIMITIVE_WIDTH || (max_y - min_y) >= MAX_PRIMITIVE_HEIGHT)
+  {
+    Log_DebugPrintf("Culling too-large polygon: %d,%d %d,%d %d,%d", vertices[0].x, vertices[0].y, vertices[1].x,
+                    vertices[1].y, vertices[2].x, vertices[2].y);
+  }
+  else
+  {
+    AddDrawTriangleTicks(vertices[0].x, vertices[0].y, vertices[1].x, vertices[1].y, vertices[2].x, vertices[2].y,
+                         rc.shading_enable, rc.texture_enable, rc.transparency_enable);
+  }
+
+  // quads
+  if (rc.quad_polygon)
+  {
+    const s32 min_x_123 = std::min(min_x_12, vertices[3].x);
+    const s32 max_x_123 = std::max(max_x_12, vertices[3].x);
+    const s32 min_y_123 = std::min(min_y_12, vertices[3].y);
+    const s32 max_y_123 = std::max(max_y_12, vertices[3].y);
+
+    // Cull polygons which are too large.
+    if ((max_x_123 - min_x_123) >= MAX_PRIMITIVE_WIDTH || (max_y_123 - min_y_123) >= MAX_PRIMITIVE_HEIGHT)
+    {
+      Log_DebugPrintf("Culling too-large polygon (quad second half): %d,%d %d,%d %d,%d", vertices[2].x, vertices[2].y,
+                      vertices[1].x, vertices[1].y, vertices[0].x, vertices[0].y);
+    }
+    else
+    {
+      AddDrawTriangleTicks(vertices[2].x, vertices[2].y, vertices[1].x, vertices[1].y, vertices[3].x, vertices[3].y,
+                           rc.shading_enable, rc.texture_enable, rc.transparency_enable);
+    }
+  }
+}
+
 void GPU_SW::ReadVRAM(u32 x, u32 y, u32 width, u32 height)
 {
-  m_backend.Sync(false);
+  m_backend.SyncRegion(x, y, width, height);
 }
 
 void GPU_SW::FillVRAM(u32 x, u32 y, u32 width, u32 height, u32 color)
@@ -55,6 +55,10 @@ protected:
   void FillBackendCommandParameters(GPUBackendCommand* cmd) const;
   void FillDrawCommand(GPUBackendDrawCommand* cmd, GPURenderCommand rc) const;
 
+  /// Queues a polygon without decoding its colours and texcoords, leaving that to the GPU thread.
+  void DispatchPolygonPacket(GPURenderCommand rc);
+  void AddDrawPolygonTicks(GPURenderCommand rc, const GPUBackendDrawPolygonCommand::Vertex* vertices);
+
   HeapArray<u8, GPU_MAX_DISPLAY_WIDTH * GPU_MAX_DISPLAY_HEIGHT * sizeof(u32)> m_display_texture_buffer;
   HostDisplayPixelFormat m_16bit_display_format = HostDisplayPixelFormat::RGB565;
   HostDisplayPixelFormat m_24bit_display_format = HostDisplayPixelFormat::RGBA8;
@@ -35,6 +35,8 @@ void GPU_SW_Backend::DrawPolygon(const GPUBackendDrawPolygonCommand* cmd)
 
   const DrawTriangleFunction DrawFunction = GetDrawTriangleFunction(
     rc.shading_enable, rc.texture_enable, rc.raw_texture_enable, rc.transparency_enable, dithering_enable);
+  if (rc.texture_enable)
+    SetupTextureState(cmd);
 
   (this->*DrawFunction)(cmd, &cmd->vertices[0], &cmd->vertices[1], &cmd->vertices[2]);
   if (rc.quad_polygon)
@@ -47,6 +49,8 @@ void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
 
   const DrawRectangleFunction DrawFunction =
     GetDrawRectangleFunction(rc.texture_enable, rc.raw_texture_enable, rc.transparency_enable);
+  if (rc.texture_enable)
+    SetupTextureState(cmd);
 
   (this->*DrawFunction)(cmd);
 }
@@ -79,6 +83,32 @@ constexpr GPU_SW_Backend::DitherLUT GPU_SW_Backend::ComputeDitherLUT()
 
 static constexpr GPU_SW_Backend::DitherLUT s_dither_lut = GPU_SW_Backend::ComputeDitherLUT();
 
+void GPU_SW_Backend::SetupTextureState(const GPUBackendDrawCommand* cmd)
+{
+  m_texture_page_x = cmd->draw_mode.GetTexturePageBaseX();
+  m_texture_page_ptr = GetPixelPtr(0, cmd->draw_mode.GetTexturePageBaseY());
+
+  u32 clut_size;
+  switch (cmd->draw_mode.texture_mode)
+  {
+    case GPUTextureMode::Palette4Bit:
+      clut_size = 16;
+      break;
+    case GPUTextureMode::Palette8Bit:
+      clut_size = 256;
+      break;
+    default:
+      return;
+  }
+
+  // The palette can wrap around the right edge of VRAM.
+  const u32 clut_x = cmd->palette.GetXBase();
+  const u16* clut_row = GetPixelPtr(0, cmd->palette.GetYBase());
+  const u32 count_before_wrap = std::min(clut_size, VRAM_WIDTH - clut_x);
+  std::copy_n(clut_row + clut_x, count_before_wrap, m_clut.begin());
+  std::copy_n(clut_row, clut_size - count_before_wrap, m_clut.begin() + count_before_wrap);
+}
+
 template<bool texture_enable, bool raw_texture_enable, bool transparency_enable, bool dithering_enable>
 void ALWAYS_INLINE_RELEASE GPU_SW_Backend::ShadePixel(const GPUBackendDrawCommand* cmd, u32 x, u32 y, u8 color_r,
                                                       u8 color_g, u8 color_b, u8 texcoord_x, u8 texcoord_y)
@@ -91,39 +121,7 @@ void ALWAYS_INLINE_RELEASE GPU_SW_Backend::ShadePixel(const GPUBackendDrawComman
     texcoord_y = (texcoord_y & cmd->window.and_y) | cmd->window.or_y;
 
     VRAMPixel texture_color;
-    switch (cmd->draw_mode.texture_mode)
-    {
-      case GPUTextureMode::Palette4Bit:
-      {
-        const u16 palette_value =
-          GetPixel((cmd->draw_mode.GetTexturePageBaseX() + ZeroExtend32(texcoord_x / 4)) % VRAM_WIDTH,
-                   (cmd->draw_mode.GetTexturePageBaseY() + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
-        const u16 palette_index = (palette_value >> ((texcoord_x % 4) * 4)) & 0x0Fu;
-
-        texture_color.bits =
-          GetPixel((cmd->palette.GetXBase() + ZeroExtend32(palette_index)) % VRAM_WIDTH, cmd->palette.GetYBase());
-      }
-      break;
-
-      case GPUTextureMode::Palette8Bit:
-      {
-        const u16 palette_value =
-          GetPixel((cmd->draw_mode.GetTexturePageBaseX() + ZeroExtend32(texcoord_x / 2)) % VRAM_WIDTH,
-                   (cmd->draw_mode.GetTexturePageBaseY() + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
-        const u16 palette_index = (palette_value >> ((texcoord_x % 2) * 8)) & 0xFFu;
-        texture_color.bits =
-          GetPixel((cmd->palette.GetXBase() + ZeroExtend32(palette_index)) % VRAM_WIDTH, cmd->palette.GetYBase());
-      }
-      break;
-
-      default:
-      {
-        texture_color.bits = GetPixel((cmd->draw_mode.GetTexturePageBaseX() + ZeroExtend32(texcoord_x)) % VRAM_WIDTH,
-                                      (cmd->draw_mode.GetTexturePageBaseY() + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
-      }
-      break;
-    }
-
+    texture_color.bits = GetTexel(cmd->draw_mode.texture_mode, texcoord_x, texcoord_y);
     if (texture_color.bits == 0)
       return;
 
@@ -227,6 +225,23 @@ void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
   const auto [r, g, b] = UnpackColorRGB24(cmd->color);
   const auto [origin_texcoord_x, origin_texcoord_y] = UnpackTexcoord(cmd->texcoord);
 
+  // Clip horizontally once, rather than for every pixel.
+  const s32 start_x = std::max(origin_x, static_cast<s32>(m_drawing_area.left));
+  const s32 end_x = std::min(origin_x + static_cast<s32>(cmd->width) - 1, static_cast<s32>(m_drawing_area.right));
+  if (start_x > end_x)
+    return;
+
+  const u32 count = static_cast<u32>(end_x - start_x + 1);
+  const u8 start_texcoord_x = Truncate8(ZeroExtend32(origin_texcoord_x) + static_cast<u32>(start_x - origin_x));
+
+  // Opaque sprites are by far the most common rectangles, and don't need per-pixel shading. Modulating by 0x808080
+  // leaves the texture unchanged, so those can be treated as raw textures. Rectangles are never dithered.
+  const bool fast_path =
+    !transparency_enable && (!texture_enable || raw_texture_enable || (cmd->color & 0xFFFFFFu) == 0x808080u);
+  const u16 flat_color =
+    Truncate16(ZeroExtend32(s_dither_lut[2][3][r]) | (ZeroExtend32(s_dither_lut[2][3][g]) << 5) |
+               (ZeroExtend32(s_dither_lut[2][3][b]) << 10) | ZeroExtend32(cmd->params.GetMaskOR()));
+
   for (u32 offset_y = 0; offset_y < cmd->height; offset_y++)
   {
     const s32 y = origin_y + static_cast<s32>(offset_y);
@@ -238,17 +253,74 @@ void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
 
     const u8 texcoord_y = Truncate8(ZeroExtend32(origin_texcoord_y) + offset_y);
 
-    for (u32 offset_x = 0; offset_x < cmd->width; offset_x++)
+    if (fast_path)
     {
-      const s32 x = origin_x + static_cast<s32>(offset_x);
-      if (x < static_cast<s32>(m_drawing_area.left) || x > static_cast<s32>(m_drawing_area.right))
-        continue;
+      u16* row = GetPixelPtr(static_cast<u32>(start_x), static_cast<u32>(y));
+      if constexpr (texture_enable)
+        BlitRectangleRow(cmd, row, count, start_texcoord_x, texcoord_y);
+      else
+        FillRectangleRow(row, count, flat_color, cmd->params);
+
+      continue;
+    }
+
+    for (u32 offset_x = 0; offset_x < count; offset_x++)
+    {
+      const u32 x = static_cast<u32>(start_x) + offset_x;
+      const u8 texcoord_x = Truncate8(ZeroExtend32(start_texcoord_x) + offset_x);
+
+      ShadePixel<texture_enable, raw_texture_enable, transparency_enable, false>(cmd, x, static_cast<u32>(y), r, g, b,
+                                                                                 texcoord_x, texcoord_y);
+    }
+  }
+}
+
+void GPU_SW_Backend::FillRectangleRow(u16* row, u32 count, u16 color, GPUBackendCommandParameters params)
+{
+  const u16 mask_and = params.GetMaskAND();
+  if (mask_and == 0)
+  {
+    std::fill_n(row, count, color);
+    return;
+  }
 
-      const u8 texcoord_x = Truncate8(ZeroExtend32(origin_texcoord_x) + offset_x);
+  for (u32 i = 0; i < count; i++)
+  {
+    if ((row[i] & mask_and) == 0)
+      row[i] = color;
+  }
+}
 
-      ShadePixel<texture_enable, raw_texture_enable, transparency_enable, false>(
-        cmd, static_cast<u32>(x), static_cast<u32>(y), r, g, b, texcoord_x, texcoord_y);
+void GPU_SW_Backend::BlitRectangleRow(const GPUBackendDrawRectangleCommand* cmd, u16* row, u32 count, u8 texcoord_x,
+                                      u8 texcoord_y)
+{
+  const u16 mask_and = cmd->params.GetMaskAND();
+  const u16 mask_or = cmd->params.GetMaskOR();
+  const GPUTextureWindow& window = cmd->window;
+  texcoord_y = (texcoord_y & window.and_y) | window.or_y;
+
+  // 15-bit textures with no window are a straight copy from VRAM, as long as the row doesn't wrap. Zero texels are
+  // still transparent, but selecting rather than branching lets the compiler vectorize it.
+  if (!cmd->draw_mode.IsUsingPalette() && window.and_x == 0xFFu && window.or_x == 0u &&
+      mask_and == 0 && (ZeroExtend32(texcoord_x) + count) <= 256u &&
+      (m_texture_page_x + ZeroExtend32(texcoord_x) + count) <= VRAM_WIDTH)
+  {
+    const u16* src = &m_texture_page_ptr[VRAM_WIDTH * ZeroExtend32(texcoord_y) + m_texture_page_x + texcoord_x];
+    for (u32 i = 0; i < count; i++)
+    {
+      const u16 texel = src[i];
+      row[i] = (texel != 0) ? (texel | mask_or) : row[i];
     }
+
+    return;
+  }
+
+  const GPUTextureMode mode = cmd->draw_mode.texture_mode;
+  for (u32 i = 0; i < count; i++, texcoord_x++)
+  {
+    const u16 texel = GetTexel(mode, (texcoord_x & window.and_x) | window.or_x, texcoord_y);
+    if (texel != 0 && (row[i] & mask_and) == 0)
+      row[i] = texel | mask_or;
   }
 }
 
@@ -98,6 +98,36 @@ protected:
   //////////////////////////////////////////////////////////////////////////
   // Rasterization
   //////////////////////////////////////////////////////////////////////////
+  /// Sets up the texture page and CLUT for a textured draw, so they don't need to be looked up for every texel.
+  void SetupTextureState(const GPUBackendDrawCommand* cmd);
+
+  ALWAYS_INLINE_RELEASE u16 GetTexturePagePixel(const u32 x, const u32 y) const
+  {
+    return m_texture_page_ptr[VRAM_WIDTH * y + ((m_texture_page_x + x) & VRAM_WIDTH_MASK)];
+  }
+
+  /// Returns the texel at the specified texture coordinates, after the texture window is applied.
+  ALWAYS_INLINE_RELEASE u16 GetTexel(const GPUTextureMode mode, const u8 texcoord_x, const u8 texcoord_y) const
+  {
+    switch (mode)
+    {
+      case GPUTextureMode::Palette4Bit:
+      {
+        const u16 palette_value = GetTexturePagePixel(ZeroExtend32(texcoord_x / 4), ZeroExtend32(texcoord_y));
+        return m_clut[(palette_value >> ((texcoord_x % 4) * 4)) & 0x0Fu];
+      }
+
+      case GPUTextureMode::Palette8Bit:
+      {
+        const u16 palette_value = GetTexturePagePixel(ZeroExtend32(texcoord_x / 2), ZeroExtend32(texcoord_y));
+        return m_clut[(palette_value >> ((texcoord_x % 2) * 8)) & 0xFFu];
+      }
+
+      default:
+        return GetTexturePagePixel(ZeroExtend32(texcoord_x), ZeroExtend32(texcoord_y));
+    }
+  }
+
   template<bool texture_enable, bool raw_texture_enable, bool transparency_enable, bool dithering_enable>
   void ShadePixel(const GPUBackendDrawCommand* cmd, u32 x, u32 y, u8 color_r, u8 color_g, u8 color_b, u8 texcoord_x,
                   u8 texcoord_y);
@@ -105,6 +135,10 @@ protected:
   template<bool texture_enable, bool raw_texture_enable, bool transparency_enable>
   void DrawRectangle(const GPUBackendDrawRectangleCommand* cmd);
 
+  /// Fast paths for opaque rectangles, which write a whole row at a time instead of shading each pixel.
+  void FillRectangleRow(u16* row, u32 count, u16 color, GPUBackendCommandParameters params);
+  void BlitRectangleRow(const GPUBackendDrawRectangleCommand* cmd, u16* row, u32 count, u8 texcoord_x, u8 texcoord_y);
+
   using DrawRectangleFunction = void (GPU_SW_Backend::*)(const GPUBackendDrawRectangleCommand* cmd);
   DrawRectangleFunction GetDrawRectangleFunction(bool texture_enable, bool raw_texture_enable,
                                                  bool transparency_enable);
@@ -164,4 +198,11 @@ protected:
   DrawLineFunction GetDrawLineFunction(bool shading_enable, bool transparency_enable, bool dithering_enable);
 
   std::array<u16, VRAM_WIDTH * VRAM_HEIGHT> m_vram;
+
+  // Texture state for the current draw. Texture pages never cross the bottom of VRAM, so only X needs to wrap.
+  const u16* m_texture_page_ptr = nullptr;
+  u32 m_texture_page_x = 0;
+
+  // Copy of the palette for the current draw, like the CLUT cache on the real GPU.
+  std::array<u16, 256> m_clut;
 };
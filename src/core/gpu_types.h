@@ -2,6 +2,7 @@
 #include "common/bitfield.h"
 #include "common/rectangle.h"
 #include "types.h"
+#include <algorithm>
 #include <array>
 
 enum : u32
@@ -238,7 +239,8 @@ enum class GPUBackendCommandType : u8
   SetDrawingArea,
   DrawPolygon,
   DrawRectangle,
-  DrawLine
+  DrawLine,
+  DrawPolygonPacket
 };
 
 union GPUBackendCommandParameters
@@ -359,6 +361,67 @@ struct GPUBackendDrawPolygonCommand : public GPUBackendDrawCommand
   Vertex vertices[0];
 };
 
+/// Polygon in its GP0 form, which is decoded on the GPU thread. Only the vertex positions are needed on the CPU
+/// thread, for timing.
+struct GPUBackendDrawPolygonPacketCommand : public GPUBackendDrawCommand
+{
+  s32 drawing_offset_x;
+  s32 drawing_offset_y;
+  u16 num_vertices;
+
+  /// Parameter words following the command word. The first vertex's colour is in the command word, so with colour,
+  /// position and texcoord counted for every vertex, each field is at a fixed stride.
+  u32 words[0];
+
+  ALWAYS_INLINE static u32 GetWordsPerVertex(GPURenderCommand rc)
+  {
+    return 1u + BoolToUInt32(rc.shading_enable) + BoolToUInt32(rc.texture_enable);
+  }
+  ALWAYS_INLINE static u32 GetWordCount(GPURenderCommand rc)
+  {
+    return (rc.quad_polygon ? 4u : 3u) * GetWordsPerVertex(rc) - BoolToUInt32(rc.shading_enable);
+  }
+
+  ALWAYS_INLINE u32 GetColor(u32 index) const
+  {
+    return (rc.shading_enable && index > 0) ? (words[index * GetWordsPerVertex(rc) - 1] & UINT32_C(0x00FFFFFF)) :
+                                               rc.color_for_first_vertex;
+  }
+  ALWAYS_INLINE GPUVertexPosition GetPosition(u32 index) const
+  {
+    return GPUVertexPosition{words[index * GetWordsPerVertex(rc)]};
+  }
+  ALWAYS_INLINE u16 GetTexcoord(u32 index) const
+  {
+    return rc.texture_enable ? Truncate16(words[index * GetWordsPerVertex(rc) + 1]) : 0;
+  }
+
+  /// Returns the position of a vertex in VRAM, i.e. with the drawing offset applied.
+  ALWAYS_INLINE void GetDrawPosition(u32 index, s32* x, s32* y) const
+  {
+    const GPUVertexPosition vp{GetPosition(index)};
+    *x = drawing_offset_x + vp.x;
+    *y = drawing_offset_y + vp.y;
+  }
+
+  /// Returns the inclusive bounds of all of the vertices in VRAM.
+  void GetBounds(s32* min_x, s32* min_y, s32* max_x, s32* max_y) const
+  {
+    GetDrawPosition(0, min_x, min_y);
+    *max_x = *min_x;
+    *max_y = *min_y;
+    for (u32 i = 1; i < num_vertices; i++)
+    {
+      s32 x, y;
+      GetDrawPosition(i, &x, &y);
+      *min_x = std::min(*min_x, x);
+      *min_y = std::min(*min_y, y);
+      *max_x = std::max(*max_x, x);
+      *max_y = std::max(*max_y, y);
+    }
+  }
+};
+
 struct GPUBackendDrawRectangleCommand : public GPUBackendDrawCommand
 {
   s32 x, y;
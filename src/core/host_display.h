@@ -215,6 +215,10 @@ public:
   void SetDisplayAlignment(Alignment alignment) { m_display_alignment = alignment; }
   void SetDisplayStretch(bool stretch) { m_display_stretch = stretch; }
 
+  /// When set, a frame is dropped instead of waiting for the previous frame to be presented, or for a free swap chain
+  /// image. Currently only implemented by the Vulkan display.
+  void SetDropLateFrames(bool enabled) { m_drop_late_frames = enabled; }
+
   /// Sets the software cursor to the specified texture. Ownership of the texture is transferred.
   void SetSoftwareCursor(std::unique_ptr<HostDisplayTexture> texture, float scale = 1.0f);
 
@@ -298,6 +302,7 @@ protected:
   bool m_display_changed = false;
   bool m_display_integer_scaling = false;
   bool m_display_stretch = false;
+  bool m_drop_late_frames = false;
 };
 
 /// Returns a pointer to the current host display abstraction. Assumes AcquireHostDisplay() has been caled.
@@ -284,6 +284,15 @@ std::unique_ptr<MemoryCard> MemoryCard::Open(std::string_view filename)
   return mc;
 }
 
+std::unique_ptr<MemoryCard> MemoryCard::OpenFolder(std::string_view path, const std::vector<std::string>& serials)
+{
+  std::unique_ptr<MemoryCard> mc = std::make_unique<MemoryCard>();
+  mc->m_filename = path;
+  mc->m_is_folder = true;
+  MemoryCardImage::LoadFromFolder(&mc->m_data, &mc->m_folder_saves, mc->m_filename.c_str(), serials);
+  return mc;
+}
+
 void MemoryCard::Format()
 {
   MemoryCardImage::Format(&m_data);
@@ -295,6 +304,7 @@ bool MemoryCard::LoadFromFile()
   return MemoryCardImage::LoadFromFile(&m_data, m_filename.c_str());
 }
 
+
 bool MemoryCard::SaveIfChanged(bool display_osd_message)
 {
   m_save_event->Deactivate();
@@ -315,7 +325,9 @@ bool MemoryCard::SaveIfChanged(bool display_osd_message)
     display_name = FileSystem::GetDisplayNameFromPath(m_filename);
   }
 
-  if (!MemoryCardImage::SaveToFile(m_data, m_filename.c_str()))
+  const bool result = m_is_folder ? MemoryCardImage::SaveToFolder(&m_data, &m_folder_saves, m_filename.c_str()) :
+                                    MemoryCardImage::SaveToFile(m_data, m_filename.c_str());
+  if (!result)
   {
     if (display_osd_message)
     {
@@ -6,6 +6,7 @@
 #include <memory>
 #include <string>
 #include <string_view>
+#include <vector>
 
 class TimingEvent;
 
@@ -20,6 +21,11 @@ public:
   static std::unique_ptr<MemoryCard> Create();
   static std::unique_ptr<MemoryCard> Open(std::string_view filename);
 
+  /// Opens a card backed by a folder, with each save stored in its own file. Only the saves for the game's serials are
+  /// loaded (all saves if there are none), so that a single folder can be shared between games without running out of
+  /// blocks.
+  static std::unique_ptr<MemoryCard> OpenFolder(std::string_view path, const std::vector<std::string>& serials);
+
   const MemoryCardImage::DataArray& GetData() const { return m_data; }
   MemoryCardImage::DataArray& GetData() { return m_data; }
   const std::string& GetFilename() const { return m_filename; }
@@ -95,4 +101,7 @@ private:
   MemoryCardImage::DataArray m_data{};
 
   std::string m_filename;
+
+  MemoryCardImage::FolderSaveMap m_folder_saves;
+  bool m_is_folder = false;
 };
@@ -4,10 +4,12 @@
 #include "common/log.h"
 #include "common/path.h"
 #include "common/string_util.h"
+#include "fmt/format.h"
 #include "system.h"
 #include "util/shiftjis.h"
 #include "util/state_wrapper.h"
 #include <algorithm>
+#include <cctype>
 #include <cstdio>
 #include <optional>
 Log_SetChannel(MemoryCard);
@@ -730,4 +732,150 @@ bool ImportSave(DataArray* data, const char* filename)
   }
 }
 
+bool IsSaveForGame(const std::string_view& save_name, const std::string_view& serial)
+{
+  // Save names start with a B, the region, and the game code, e.g. BASLUS-00571. Not all games include the dash.
+  const auto skip_dashes = [](const std::string_view& str, size_t pos) {
+    while (pos < str.length() && str[pos] == '-')
+      pos++;
+    return pos;
+  };
+
+  size_t save_pos = 2;
+  size_t code_pos = 0;
+  for (;;)
+  {
+    save_pos = skip_dashes(save_name, save_pos);
+    code_pos = skip_dashes(serial, code_pos);
+    if (code_pos == serial.length())
+      return true;
+    if (save_pos == save_name.length() ||
+        std::toupper(static_cast<unsigned char>(save_name[save_pos])) !=
+          std::toupper(static_cast<unsigned char>(serial[code_pos])))
+    {
+      return false;
+    }
+
+    save_pos++;
+    code_pos++;
+  }
+}
+
+void LoadFromFolder(DataArray* data, FolderSaveMap* saves, const char* path, const std::vector<std::string>& serials)
+{
+  // The card image is built from the saves in the folder, starting from a blank card.
+  Format(data);
+  saves->clear();
+
+  FileSystem::FindResultsArray files;
+  FileSystem::FindFiles(path, "*.mcs", FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_HIDDEN_FILES, &files);
+  std::sort(files.begin(), files.end(), [](const FILESYSTEM_FIND_DATA& lhs, const FILESYSTEM_FIND_DATA& rhs) {
+    return (lhs.FileName < rhs.FileName);
+  });
+
+  for (const FILESYSTEM_FIND_DATA& fd : files)
+  {
+    // Files are named after the save they hold, so other games' saves can be skipped without reading them. Games
+    // which span several discs usually save under the first disc's serial, so any of the set's serials can match.
+    const std::string_view save_name(Path::GetFileTitle(fd.FileName));
+    if (!serials.empty() && std::none_of(serials.begin(), serials.end(), [&save_name](const std::string& serial) {
+          return IsSaveForGame(save_name, serial);
+        }))
+    {
+      continue;
+    }
+
+    if (!ImportSave(data, fd.FileName.c_str()))
+    {
+      Log_WarningPrintf("Failed to load save '%s' into folder memory card", fd.FileName.c_str());
+      continue;
+    }
+
+    for (const FileInfo& fi : EnumerateFiles(*data, false))
+    {
+      if (saves->find(fi.filename) != saves->end())
+        continue;
+
+      FolderSave& save = (*saves)[fi.filename];
+      save.path = fd.FileName;
+      ReadFile(*data, fi, &save.data);
+    }
+  }
+
+  Log_InfoPrintf("Loaded %zu saves from folder memory card '%s' (%u blocks free)", saves->size(), path,
+                 GetFreeBlockCount(*data));
+}
+
+bool SaveToFolder(DataArray* data, FolderSaveMap* saves, const char* path)
+{
+  if (!FileSystem::DirectoryExists(path) && !FileSystem::CreateDirectory(path, false))
+  {
+    Log_ErrorPrintf("Failed to create memory card folder '%s'", path);
+    return false;
+  }
+
+  // Only saves which differ from what's in the folder are written.
+  bool result = true;
+  const std::vector<FileInfo> files(EnumerateFiles(*data, false));
+  for (const FileInfo& fi : files)
+  {
+    std::vector<u8> save_data;
+    if (!ReadFile(*data, fi, &save_data))
+    {
+      result = false;
+      continue;
+    }
+
+    auto iter = saves->find(fi.filename);
+    if (iter != saves->end() && iter->second.data == save_data)
+      continue;
+
+    // Files which weren't loaded, e.g. because they belong to another game or didn't fit, are left alone.
+    std::string save_path;
+    if (iter != saves->end())
+    {
+      save_path = iter->second.path;
+    }
+    else
+    {
+      const std::string sanitized_name(Path::SanitizeFileName(fi.filename));
+      save_path = Path::Combine(path, sanitized_name + ".mcs");
+      for (u32 i = 1; FileSystem::FileExists(save_path.c_str()); i++)
+        save_path = Path::Combine(path, fmt::format("{} ({}).mcs", sanitized_name, i));
+    }
+
+    Log_InfoPrintf("Writing save '%s' to '%s'", fi.filename.c_str(), save_path.c_str());
+    if (!ExportSave(data, fi, save_path.c_str()))
+    {
+      result = false;
+      continue;
+    }
+
+    (*saves)[fi.filename] = FolderSave{std::move(save_path), std::move(save_data)};
+  }
+
+  // Saves which were deleted from the card are deleted from the folder as well.
+  for (auto iter = saves->begin(); iter != saves->end();)
+  {
+    if (std::any_of(files.begin(), files.end(),
+                    [&iter](const FileInfo& fi) { return (fi.filename == iter->first); }))
+    {
+      ++iter;
+      continue;
+    }
+
+    Log_InfoPrintf("Deleting save '%s' from '%s'", iter->first.c_str(), iter->second.path.c_str());
+    if (!FileSystem::DeleteFile(iter->second.path.c_str()))
+    {
+      result = false;
+      ++iter;
+      continue;
+    }
+
+    iter = saves->erase(iter);
+  }
+
+  return result;
+}
+
 } // namespace MemoryCardImage
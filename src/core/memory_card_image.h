@@ -5,6 +5,7 @@
 #include <memory>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace MemoryCardImage {
@@ -55,4 +56,25 @@ bool ImportCard(DataArray* data, const char* filename);
 bool ImportCard(DataArray* data, const char* filename, std::vector<u8> file_data);
 bool ExportSave(DataArray* data, const FileInfo& fi, const char* filename);
 bool ImportSave(DataArray* data, const char* filename);
+
+/// Contents of a save as it was last read from or written to a folder card.
+struct FolderSave
+{
+  std::string path;
+  std::vector<u8> data;
+};
+
+/// Saves which were loaded from or written to a folder, by save name.
+using FolderSaveMap = std::unordered_map<std::string, FolderSave>;
+
+/// Returns true if the save name, e.g. BASLUS-00571, belongs to the game with the specified serial.
+bool IsSaveForGame(const std::string_view& save_name, const std::string_view& serial);
+
+/// Builds a card from the .mcs files in a folder whose names match any of the serials, or all of them if there are no
+/// serials.
+void LoadFromFolder(DataArray* data, FolderSaveMap* saves, const char* path, const std::vector<std::string>& serials);
+
+/// Writes the saves which changed since the folder was loaded, and deletes those which were removed from the card. New
+/// saves never replace a file which wasn't loaded, such as another game's save, and get a unique name instead.
+bool SaveToFolder(DataArray* data, FolderSaveMap* saves, const char* path);
 } // namespace MemoryCardImage
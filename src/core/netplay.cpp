@@ -0,0 +1,627 @@
+#include "netplay.h"
+#include "common/assert.h"
+#include "common/log.h"
+#include "common/rollback_sync.h"
+#include "common/timer.h"
+#include "controller.h"
+#include "host.h"
+#include "system.h"
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cstring>
+
+#ifdef _WIN32
+#include "common/windows_headers.h"
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+Log_SetChannel(Netplay);
+
+namespace Netplay {
+
+#ifdef _WIN32
+using SocketType = SOCKET;
+static constexpr SocketType INVALID_SOCKET_VALUE = INVALID_SOCKET;
+#else
+using SocketType = int;
+static constexpr SocketType INVALID_SOCKET_VALUE = -1;
+#endif
+
+enum : u32
+{
+  PACKET_MAGIC = 0x504E5344, // DSNP
+  PROTOCOL_VERSION = 1,
+
+  NUM_ROLLBACK_STATES = MAX_ROLLBACK_FRAMES + 1,
+  MAX_PACKET_SIZE = 1024,
+};
+
+static constexpr float HELLO_INTERVAL = 0.25f;
+static constexpr float CONNECTION_TIMEOUT = 10.0f;
+
+enum class PacketType : u8
+{
+  Hello,
+  Input,
+  StateHash,
+  Bye,
+};
+
+#pragma pack(push, 1)
+struct PacketHeader
+{
+  u32 magic;
+  u16 version;
+  PacketType type;
+  u8 player;
+};
+
+struct HelloPacket
+{
+  PacketHeader header;
+  u8 controller_types[NUM_PLAYERS];
+  u8 input_delay;
+  u8 connected; ///< Sender has already heard from the receiver.
+};
+
+/// Followed by num_frames input frames.
+struct InputPacketHeader
+{
+  PacketHeader header;
+  u32 start_frame;
+  u32 ack_frame; ///< Number of the receiver's input frames we have.
+  s8 frame_advantage;
+  u8 num_frames;
+};
+
+struct StateHashPacket
+{
+  PacketHeader header;
+  u32 frame;
+  u64 hash;
+};
+#pragma pack(pop)
+
+using InputFrame = RollbackSync::InputFrame;
+static_assert(sizeof(InputFrame) == MAX_INPUT_BINDS);
+
+static bool OpenSocket(u16 local_port, const std::string& remote_address);
+static void CloseSocket();
+static void SendPacket(const void* data, size_t size);
+static void SendHello();
+static void SendInputs();
+static void SendStateHash(u32 frame, u64 hash);
+static void ReceivePackets();
+static void HandlePacket(const u8* data, size_t size);
+static void HandleInputPacket(const InputPacketHeader& hdr, const u8* frames);
+static void OnConnected();
+static void ApplyInput(u32 pad, const InputFrame& input);
+static void SimulateFrame(u32 frame, bool resimulating);
+static void Rollback();
+static void CheckForDesync();
+static void ReportDesync(u32 frame);
+
+static bool s_active = false;
+static bool s_connected = false;
+static bool s_desync_reported = false;
+static SocketType s_socket = INVALID_SOCKET_VALUE;
+static sockaddr_storage s_remote_addr = {};
+static socklen_t s_remote_addr_len = 0;
+
+static u32 s_local_player = 0;
+static u32 s_input_delay = DEFAULT_INPUT_DELAY;
+static Common::Timer::Value s_last_receive_time = 0;
+static Common::Timer::Value s_last_hello_time = 0;
+
+static RollbackSync s_sync(MAX_ROLLBACK_FRAMES, DESYNC_CHECK_INTERVAL);
+static InputFrame s_local_live_input = {};
+
+// Inputs last applied to each controller, so bind states are only changed on transitions.
+static std::array<InputFrame, NUM_PLAYERS> s_applied_inputs = {};
+
+} // namespace Netplay
+
+bool Netplay::OpenSocket(u16 local_port, const std::string& remote_address)
+{
+#ifdef _WIN32
+  WSADATA wsa_data;
+  if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0)
+  {
+    Log_ErrorPrintf("WSAStartup() failed");
+    return false;
+  }
+#endif
+
+  const std::string::size_type port_pos = remote_address.rfind(':');
+  if (port_pos == std::string::npos || port_pos == 0)
+  {
+    Log_ErrorPrintf("Remote address '%s' should be in the form host:port", remote_address.c_str());
+    CloseSocket();
+    return false;
+  }
+
+  const std::string remote_host(remote_address.substr(0, port_pos));
+  const std::string remote_port(remote_address.substr(port_pos + 1));
+
+  addrinfo hints = {};
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_DGRAM;
+  hints.ai_protocol = IPPROTO_UDP;
+
+  addrinfo* result = nullptr;
+  if (getaddrinfo(remote_host.c_str(), remote_port.c_str(), &hints, &result) != 0 || !result)
+  {
+    Log_ErrorPrintf("Failed to resolve '%s'", remote_address.c_str());
+    CloseSocket();
+    return false;
+  }
+
+  std::memcpy(&s_remote_addr, result->ai_addr, result->ai_addrlen);
+  s_remote_addr_len = static_cast<socklen_t>(result->ai_addrlen);
+  freeaddrinfo(result);
+
+  s_socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (s_socket == INVALID_SOCKET_VALUE)
+  {
+    Log_ErrorPrintf("socket() failed");
+    CloseSocket();
+    return false;
+  }
+
+  sockaddr_in local_addr = {};
+  local_addr.sin_family = AF_INET;
+  local_addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  local_addr.sin_port = htons(local_port);
+  if (bind(s_socket, reinterpret_cast<const sockaddr*>(&local_addr), sizeof(local_addr)) != 0)
+  {
+    Log_ErrorPrintf("Failed to bind to port %u", local_port);
+    CloseSocket();
+    return false;
+  }
+
+#ifdef _WIN32
+  u_long non_blocking = 1;
+  const bool nb_result = (ioctlsocket(s_socket, FIONBIO, &non_blocking) == 0);
+#else
+  const bool nb_result = (fcntl(s_socket, F_SETFL, fcntl(s_socket, F_GETFL, 0) | O_NONBLOCK) == 0);
+#endif
+  if (!nb_result)
+  {
+    Log_ErrorPrintf("Failed to make socket non-blocking");
+    CloseSocket();
+    return false;
+  }
+
+  return true;
+}
+
+void Netplay::CloseSocket()
+{
+  if (s_socket != INVALID_SOCKET_VALUE)
+  {
+#ifdef _WIN32
+    closesocket(s_socket);
+#else
+    close(s_socket);
+#endif
+    s_socket = INVALID_SOCKET_VALUE;
+  }
+
+#ifdef _WIN32
+  WSACleanup();
+#endif
+}
+
+bool Netplay::Start(u32 local_player, u16 local_port, const std::string& remote_address, u32 input_delay)
+{
+  if (s_active)
+    Stop();
+
+  if (local_player >= NUM_PLAYERS)
+  {
+    Log_ErrorPrintf("Invalid player %u", local_player);
+    return false;
+  }
+
+  if (!System::IsValid() || !OpenSocket(local_port, remote_address))
+    return false;
+
+  s_active = true;
+  s_connected = false;
+  s_local_player = local_player;
+  s_input_delay = std::min<u32>(input_delay, MAX_INPUT_DELAY);
+  s_last_hello_time = 0;
+  System::SetRollbackStateCount(NUM_ROLLBACK_STATES);
+
+  Log_InfoPrintf("Netplay started as player %u on port %u, waiting for %s", local_player + 1, local_port,
+                 remote_address.c_str());
+  Host::AddKeyedFormattedOSDMessage("Netplay", 3600.0f,
+                                    Host::TranslateString("OSDMessage", "Waiting for other player on port %u..."),
+                                    local_port);
+  return true;
+}
+
+void Netplay::Stop()
+{
+  if (!s_active)
+    return;
+
+  if (s_connected)
+  {
+    const PacketHeader bye = {PACKET_MAGIC, PROTOCOL_VERSION, PacketType::Bye, static_cast<u8>(s_local_player)};
+    SendPacket(&bye, sizeof(bye));
+  }
+
+  CloseSocket();
+  System::SetRollbackStateCount(0);
+  s_active = false;
+  s_connected = false;
+  Log_InfoPrintf("Netplay stopped");
+}
+
+bool Netplay::IsActive()
+{
+  return s_active;
+}
+
+void Netplay::SetLocalBindState(u32 bind_index, float value)
+{
+  if (bind_index >= MAX_INPUT_BINDS)
+    return;
+
+  s_local_live_input[bind_index] = static_cast<u8>(std::clamp(value * 255.0f, 0.0f, 255.0f));
+}
+
+void Netplay::SendPacket(const void* data, size_t size)
+{
+  sendto(s_socket, static_cast<const char*>(data), static_cast<int>(size), 0,
+         reinterpret_cast<const sockaddr*>(&s_remote_addr), s_remote_addr_len);
+}
+
+void Netplay::SendHello()
+{
+  HelloPacket hello = {};
+  hello.header = {PACKET_MAGIC, PROTOCOL_VERSION, PacketType::Hello, static_cast<u8>(s_local_player)};
+  for (u32 i = 0; i < NUM_PLAYERS; i++)
+    hello.controller_types[i] = static_cast<u8>(g_settings.controller_types[i]);
+  hello.input_delay = static_cast<u8>(s_input_delay);
+  hello.connected = static_cast<u8>(s_connected);
+  SendPacket(&hello, sizeof(hello));
+  s_last_hello_time = Common::Timer::GetCurrentValue();
+}
+
+void Netplay::SendInputs()
+{
+  // Send everything the other side hasn't acknowledged yet, since packets can be lost.
+  const u32 start_frame = s_sync.GetUnacknowledgedStartFrame();
+  const u32 num_frames = s_sync.GetUnacknowledgedFrameCount();
+
+  std::array<u8, MAX_PACKET_SIZE> buffer;
+  static_assert(sizeof(InputPacketHeader) + sizeof(InputFrame) * RollbackSync::MAX_FRAMES_PER_PACKET <=
+                MAX_PACKET_SIZE);
+
+  InputPacketHeader hdr = {};
+  hdr.header = {PACKET_MAGIC, PROTOCOL_VERSION, PacketType::Input, static_cast<u8>(s_local_player)};
+  hdr.start_frame = start_frame;
+  hdr.ack_frame = s_sync.GetRemoteFrameCount();
+  hdr.frame_advantage = static_cast<s8>(s_sync.GetLocalFrameAdvantage());
+  hdr.num_frames = static_cast<u8>(num_frames);
+  std::memcpy(buffer.data(), &hdr, sizeof(hdr));
+  for (u32 i = 0; i < num_frames; i++)
+  {
+    std::memcpy(&buffer[sizeof(hdr) + i * sizeof(InputFrame)],
+                s_sync.GetLocalInput(start_frame + i).data(), sizeof(InputFrame));
+  }
+
+  SendPacket(buffer.data(), sizeof(hdr) + num_frames * sizeof(InputFrame));
+}
+
+void Netplay::SendStateHash(u32 frame, u64 hash)
+{
+  StateHashPacket packet = {};
+  packet.header = {PACKET_MAGIC, PROTOCOL_VERSION, PacketType::StateHash, static_cast<u8>(s_local_player)};
+  packet.frame = frame;
+  packet.hash = hash;
+  SendPacket(&packet, sizeof(packet));
+}
+
+void Netplay::ReceivePackets()
+{
+  std::array<u8, MAX_PACKET_SIZE> buffer;
+  while (s_active)
+  {
+    sockaddr_storage from_addr;
+    socklen_t from_addr_len = sizeof(from_addr);
+    const int size = static_cast<int>(recvfrom(s_socket, reinterpret_cast<char*>(buffer.data()),
+                                               static_cast<int>(buffer.size()), 0,
+                                               reinterpret_cast<sockaddr*>(&from_addr), &from_addr_len));
+    if (size <= 0)
+      break;
+
+    // Anyone can send to our port, so only listen to the other player.
+    const sockaddr_in& from = reinterpret_cast<const sockaddr_in&>(from_addr);
+    const sockaddr_in& remote = reinterpret_cast<const sockaddr_in&>(s_remote_addr);
+    if (from_addr_len < static_cast<socklen_t>(sizeof(sockaddr_in)) || from.sin_family != AF_INET ||
+        from.sin_addr.s_addr != remote.sin_addr.s_addr || from.sin_port != remote.sin_port)
+    {
+      Log_WarningPrintf("Ignoring packet of %d bytes from unknown sender", size);
+      continue;
+    }
+
+    HandlePacket(buffer.data(), static_cast<size_t>(size));
+  }
+}
+
+void Netplay::HandlePacket(const u8* data, size_t size)
+{
+  PacketHeader header;
+  if (size < sizeof(header))
+    return;
+
+  std::memcpy(&header, data, sizeof(header));
+  if (header.magic != PACKET_MAGIC || header.version != PROTOCOL_VERSION || header.player == s_local_player ||
+      header.player >= NUM_PLAYERS)
+  {
+    Log_WarningPrintf("Ignoring invalid packet of %zu bytes", size);
+    return;
+  }
+
+  s_last_receive_time = Common::Timer::GetCurrentValue();
+
+  // Both sides must use the same input delay, otherwise the frames they queue input for don't line up.
+  if (header.type == PacketType::Hello && size >= sizeof(HelloPacket))
+  {
+    HelloPacket hello;
+    std::memcpy(&hello, data, sizeof(hello));
+    if (hello.input_delay != s_input_delay)
+    {
+      Log_ErrorPrintf("Other player uses an input delay of %u frames, but ours is %u", hello.input_delay,
+                      s_input_delay);
+      Host::AddKeyedFormattedOSDMessage(
+        "Netplay", 10.0f,
+        Host::TranslateString("OSDMessage", "Other player uses an input delay of %u frames, but ours is %u."),
+        hello.input_delay, s_input_delay);
+      Stop();
+      return;
+    }
+  }
+
+  if (!s_connected && header.type != PacketType::Bye)
+    OnConnected();
+
+  switch (header.type)
+  {
+    case PacketType::Hello:
+    {
+      HelloPacket hello;
+      if (size < sizeof(hello))
+        return;
+
+      std::memcpy(&hello, data, sizeof(hello));
+      for (u32 i = 0; i < NUM_PLAYERS; i++)
+      {
+        if (hello.controller_types[i] != static_cast<u8>(g_settings.controller_types[i]))
+        {
+          Host::AddKeyedOSDMessage(
+            "NetplayControllerMismatch",
+            Host::TranslateStdString("OSDMessage", "Controller types differ between players, expect desyncs."), 10.0f);
+          break;
+        }
+      }
+
+      // The other side may not have received our hello yet.
+      if (!hello.connected)
+        SendHello();
+    }
+    break;
+
+    case PacketType::Input:
+    {
+      InputPacketHeader hdr;
+      if (size < sizeof(hdr))
+        return;
+
+      std::memcpy(&hdr, data, sizeof(hdr));
+      if (size < (sizeof(hdr) + hdr.num_frames * sizeof(InputFrame)))
+        return;
+
+      HandleInputPacket(hdr, data + sizeof(hdr));
+    }
+    break;
+
+    case PacketType::StateHash:
+    {
+      StateHashPacket packet;
+      if (size < sizeof(packet))
+        return;
+
+      std::memcpy(&packet, data, sizeof(packet));
+      if (!s_sync.AddRemoteHash(packet.frame, packet.hash))
+        ReportDesync(packet.frame);
+    }
+    break;
+
+    case PacketType::Bye:
+    {
+      Host::AddKeyedOSDMessage("Netplay", Host::TranslateStdString("OSDMessage", "Other player disconnected."),
+                               5.0f);
+      Stop();
+    }
+    break;
+
+    default:
+      break;
+  }
+}
+
+void Netplay::HandleInputPacket(const InputPacketHeader& hdr, const u8* frames)
+{
+  s_sync.AddRemoteInputs(hdr.start_frame, hdr.ack_frame, hdr.frame_advantage, hdr.num_frames, frames);
+}
+
+void Netplay::OnConnected()
+{
+  Log_InfoPrintf("Other player connected, resetting system");
+  Host::AddKeyedOSDMessage("Netplay", Host::TranslateStdString("OSDMessage", "Netplay session started."), 5.0f);
+
+  // Both sides start from a fresh reset, so the initial state matches.
+  System::ResetSystem();
+
+  s_connected = true;
+  s_desync_reported = false;
+  s_local_live_input = {};
+  s_applied_inputs = {};
+  s_sync.Reset(s_input_delay);
+}
+
+void Netplay::ApplyInput(u32 pad, const InputFrame& input)
+{
+  Controller* controller = System::GetController(pad);
+  const Controller::ControllerInfo* cinfo = controller ? Controller::GetControllerInfo(controller->GetType()) : nullptr;
+  if (!cinfo)
+    return;
+
+  InputFrame& applied = s_applied_inputs[pad];
+  for (u32 i = 0; i < cinfo->num_bindings; i++)
+  {
+    const Controller::ControllerBindingInfo& bi = cinfo->bindings[i];
+    if (bi.bind_index >= MAX_INPUT_BINDS ||
+        (bi.type != Controller::ControllerBindingType::Button && bi.type != Controller::ControllerBindingType::Axis &&
+         bi.type != Controller::ControllerBindingType::HalfAxis))
+    {
+      continue;
+    }
+
+    // Only apply transitions, since some binds (e.g. analog toggle) act on every call.
+    if (input[bi.bind_index] == applied[bi.bind_index])
+      continue;
+
+    applied[bi.bind_index] = input[bi.bind_index];
+    controller->SetBindState(bi.bind_index, static_cast<float>(input[bi.bind_index]) / 255.0f);
+  }
+}
+
+void Netplay::SimulateFrame(u32 frame, bool resimulating)
+{
+  System::SaveRollbackState(frame % NUM_ROLLBACK_STATES);
+
+  ApplyInput(s_local_player, s_sync.GetLocalInput(frame));
+  ApplyInput(s_local_player ^ 1u, s_sync.PredictRemoteInput(frame));
+
+  System::RunRollbackFrame(resimulating);
+}
+
+void Netplay::Rollback()
+{
+  const u32 current_frame = s_sync.GetCurrentFrame();
+  const u32 rollback_frame = s_sync.TakeRollbackFrame();
+  const u32 frames_to_run = current_frame - rollback_frame;
+  if (frames_to_run > NUM_ROLLBACK_STATES)
+  {
+    // Shouldn't happen, since we stop predicting after MAX_ROLLBACK_FRAMES.
+    Log_ErrorPrintf("Cannot roll back %u frames", frames_to_run);
+    return;
+  }
+
+  Common::Timer timer;
+  if (!System::LoadRollbackState(rollback_frame % NUM_ROLLBACK_STATES))
+    return;
+
+  // The controllers are now in the state from before the rollback frame.
+  if (rollback_frame > 0)
+  {
+    s_applied_inputs[s_local_player] = s_sync.GetLocalInput(rollback_frame - 1);
+    s_applied_inputs[s_local_player ^ 1u] = s_sync.GetRemoteUsedInput(rollback_frame - 1);
+  }
+  else
+  {
+    s_applied_inputs = {};
+  }
+
+  for (u32 frame = rollback_frame; frame < current_frame; frame++)
+    SimulateFrame(frame, true);
+
+  const double time = timer.GetTimeMilliseconds();
+  const double frame_budget = 1000.0 / static_cast<double>(System::GetThrottleFrequency());
+  if (time > frame_budget)
+  {
+    Log_WarningPrintf("Re-simulating %u frames took %.2f ms, over the %.2f ms budget", frames_to_run, time,
+                      frame_budget);
+  }
+  else
+  {
+    Log_DevPrintf("Re-simulated %u frames from %u in %.2f ms", frames_to_run, rollback_frame, time);
+  }
+}
+
+void Netplay::CheckForDesync()
+{
+  u32 frame;
+  while (s_sync.GetNextHashFrame(&frame))
+  {
+    const u64 hash = System::GetRollbackStateHash(frame % NUM_ROLLBACK_STATES);
+    SendStateHash(frame, hash);
+    if (!s_sync.AddLocalHash(frame, hash))
+      ReportDesync(frame);
+  }
+}
+
+void Netplay::ReportDesync(u32 frame)
+{
+  Log_ErrorPrintf("Desync detected at frame %u", frame);
+  if (!s_desync_reported)
+  {
+    s_desync_reported = true;
+    Host::AddKeyedFormattedOSDMessage("NetplayDesync", 10.0f,
+                                      Host::TranslateString("OSDMessage", "Netplay desync detected at frame %u."),
+                                      frame);
+  }
+}
+
+void Netplay::RunFrame()
+{
+  ReceivePackets();
+  if (!s_active)
+    return;
+
+  const Common::Timer::Value current_time = Common::Timer::GetCurrentValue();
+  if (!s_connected)
+  {
+    if (Common::Timer::ConvertValueToSeconds(current_time - s_last_hello_time) >= HELLO_INTERVAL)
+      SendHello();
+
+    return;
+  }
+
+  if (Common::Timer::ConvertValueToSeconds(current_time - s_last_receive_time) >= CONNECTION_TIMEOUT)
+  {
+    Log_ErrorPrintf("No packets received in %.0f seconds, ending session", CONNECTION_TIMEOUT);
+    Host::AddKeyedOSDMessage("Netplay", Host::TranslateStdString("OSDMessage", "Netplay connection lost."), 5.0f);
+    Stop();
+    return;
+  }
+
+  if (s_sync.NeedsRollback())
+    Rollback();
+
+  // Input is sent even when stalled, since the other player may be waiting for it.
+  const bool stalled = !s_sync.BeginFrame(s_local_live_input);
+  SendInputs();
+  if (stalled)
+    return;
+
+  SimulateFrame(s_sync.GetCurrentFrame(), false);
+  s_sync.EndFrame();
+
+  CheckForDesync();
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "types.h"
+#include <string>
+
+/// Two-player rollback netplay over UDP. Each instance runs the full simulation, sending only its local input to the
+/// other side. Remote input is predicted until it arrives, and when a prediction turns out to be wrong, the emulator
+/// rolls back to the mispredicted frame and re-simulates up to the current frame with the corrected input.
+namespace Netplay {
+
+enum : u32
+{
+  /// Number of players in a session. Player N drives controller port N.
+  NUM_PLAYERS = 2,
+
+  /// Maximum number of bindings per controller which are transmitted.
+  MAX_INPUT_BINDS = 32,
+
+  /// Maximum number of frames we run ahead of the last confirmed remote input. Also the number of frames which may
+  /// have to be re-simulated in one go when a misprediction is detected.
+  MAX_ROLLBACK_FRAMES = 7,
+
+  /// Default number of frames local input is delayed by, to reduce the number of mispredictions.
+  DEFAULT_INPUT_DELAY = 1,
+  MAX_INPUT_DELAY = 4,
+
+  /// Interval in frames at which confirmed state hashes are exchanged for desync detection.
+  DESYNC_CHECK_INTERVAL = 30,
+};
+
+/// Starts a session. The local instance binds to local_port, and exchanges packets with remote_address, which is in
+/// the form hostname:port. The system is reset once the other player is connected.
+bool Start(u32 local_player, u16 local_port, const std::string& remote_address, u32 input_delay = DEFAULT_INPUT_DELAY);
+
+/// Ends the session, notifying the other player.
+void Stop();
+
+/// Returns true if a session is active, i.e. the netplay frame loop should be used.
+bool IsActive();
+
+/// Updates the local player's input for the next frame. Called by the input manager instead of setting the bind
+/// state on the controller directly, so that the input can be delayed and sent to the other player.
+void SetLocalBindState(u32 bind_index, float value);
+
+/// Runs a single frame, rolling back and re-simulating if required. Called by System::RunFrame() while active.
+void RunFrame();
+
+} // namespace Netplay
@@ -7,6 +7,8 @@
 #include "system.h"
 #include "zlib.h"
 #include <cctype>
+#include <cmath>
+#include <cstdlib>
 #include <cstring>
 Log_SetChannel(PSFLoader);
 
@@ -58,6 +60,45 @@ float File::GetTagFloat(const char* tag_name, float default_value) const
   return GetTagFloat(tag_name).value_or(default_value);
 }
 
+std::optional<float> File::GetTagTime(const char* tag_name) const
+{
+  auto it = m_tags.find(tag_name);
+  if (it == m_tags.end())
+    return std::nullopt;
+
+  // Each ':' shifts the previous components up by a factor of 60. Commas are sometimes used as the decimal separator.
+  float seconds = 0.0f;
+  const char* str = it->second.c_str();
+  for (;;)
+  {
+    while (std::isspace(*str))
+      str++;
+
+    char* end;
+    const float value = std::strtof(str, &end);
+    if (end == str)
+      return std::nullopt;
+
+    seconds += value;
+    str = end;
+    if (*str == ',' && std::isdigit(str[1]))
+    {
+      const char* frac_start = str + 1;
+      const float frac = std::strtof(frac_start, &end);
+      seconds += frac / std::pow(10.0f, static_cast<float>(end - frac_start));
+      str = end;
+    }
+
+    if (*str != ':')
+      break;
+
+    seconds *= 60.0f;
+    str++;
+  }
+
+  return seconds;
+}
+
 bool File::Load(const char* path)
 {
   std::optional<std::vector<u8>> file_data(FileSystem::ReadBinaryFile(path));
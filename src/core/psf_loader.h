@@ -37,6 +37,9 @@ public:
   int GetTagInt(const char* tag_name, int default_value) const;
   float GetTagFloat(const char* tag_name, float default_value) const;
 
+  /// Parses a time tag such as "length" or "fade", which is in the form [[hh:]mm:]ss[.sss], returning seconds.
+  std::optional<float> GetTagTime(const char* tag_name) const;
+
   bool Load(const char* path);
 
 private:
@@ -11,6 +11,7 @@
 #include "host_display.h"
 #include "host_settings.h"
 #include "system.h"
+#include "util/cd_image.h"
 #include <algorithm>
 #include <array>
 #include <cctype>
@@ -89,7 +90,7 @@ Settings::Settings()
 bool Settings::HasAnyPerGameMemoryCards() const
 {
   return std::any_of(memory_card_types.begin(), memory_card_types.end(), [](MemoryCardType t) {
-    return (t == MemoryCardType::PerGame || t == MemoryCardType::PerGameTitle);
+    return (t == MemoryCardType::PerGame || t == MemoryCardType::PerGameTitle || t == MemoryCardType::Folder);
   });
 }
 
@@ -177,6 +178,7 @@ void Settings::Load(SettingsInterface& si)
   rewind_enable = si.GetBoolValue("Main", "RewindEnable", false);
   rewind_save_frequency = si.GetFloatValue("Main", "RewindFrequency", 10.0f);
   rewind_save_slots = static_cast<u32>(si.GetIntValue("Main", "RewindSaveSlots", 10));
+  rewind_native_vram = si.GetBoolValue("Main", "RewindNativeVRAM", false);
   runahead_frames = static_cast<u32>(si.GetIntValue("Main", "RunaheadFrameCount", 0));
 
   cpu_execution_mode =
@@ -200,6 +202,8 @@ void Settings::Load(SettingsInterface& si)
   gpu_resolution_scale = static_cast<u32>(si.GetIntValue("GPU", "ResolutionScale", 1));
   gpu_multisamples = static_cast<u32>(si.GetIntValue("GPU", "Multisamples", 1));
   gpu_use_debug_device = si.GetBoolValue("GPU", "UseDebugDevice", false);
+  gpu_vulkan_frames_in_flight = static_cast<u32>(
+    std::clamp(si.GetIntValue("GPU", "VulkanFramesInFlight", DEFAULT_GPU_VULKAN_FRAMES_IN_FLIGHT), 2, 4));
   gpu_per_sample_shading = si.GetBoolValue("GPU", "PerSampleShading", false);
   gpu_use_thread = si.GetBoolValue("GPU", "UseThread", true);
   gpu_use_software_renderer_for_readbacks = si.GetBoolValue("GPU", "UseSoftwareRendererForReadbacks", false);
@@ -258,6 +262,7 @@ void Settings::Load(SettingsInterface& si)
   display_show_inputs = si.GetBoolValue("Display", "ShowInputs", false);
   display_show_enhancements = si.GetBoolValue("Display", "ShowEnhancements", false);
   display_all_frames = si.GetBoolValue("Display", "DisplayAllFrames", false);
+  display_drop_late_frames = si.GetBoolValue("Display", "DropLateFrames", false);
   display_internal_resolution_screenshots = si.GetBoolValue("Display", "InternalResolutionScreenshots", false);
   video_sync_enabled = si.GetBoolValue("Display", "VSync", DEFAULT_VSYNC_VALUE);
   display_post_process_chain = si.GetStringValue("Display", "PostProcessChain", "");
@@ -295,6 +300,8 @@ void Settings::Load(SettingsInterface& si)
 
   bios_patch_tty_enable = si.GetBoolValue("BIOS", "PatchTTYEnable", false);
   bios_patch_fast_boot = si.GetBoolValue("BIOS", "PatchFastBoot", DEFAULT_FAST_BOOT_VALUE);
+  bios_hle_enable = si.GetBoolValue("BIOS", "HLEEnable", false);
+  bios_hle_functions = si.GetStringValue("BIOS", "HLEFunctions", "");
 
   multitap_mode =
     ParseMultitapModeName(
@@ -400,6 +407,7 @@ void Settings::Save(SettingsInterface& si) const
   si.SetBoolValue("Main", "RewindEnable", rewind_enable);
   si.SetFloatValue("Main", "RewindFrequency", rewind_save_frequency);
   si.SetIntValue("Main", "RewindSaveSlots", rewind_save_slots);
+  si.SetBoolValue("Main", "RewindNativeVRAM", rewind_native_vram);
   si.SetIntValue("Main", "RunaheadFrameCount", runahead_frames);
 
   si.SetStringValue("CPU", "ExecutionMode", GetCPUExecutionModeName(cpu_execution_mode));
@@ -416,6 +424,7 @@ void Settings::Save(SettingsInterface& si) const
   si.SetIntValue("GPU", "ResolutionScale", static_cast<long>(gpu_resolution_scale));
   si.SetIntValue("GPU", "Multisamples", static_cast<long>(gpu_multisamples));
   si.SetBoolValue("GPU", "UseDebugDevice", gpu_use_debug_device);
+  si.SetIntValue("GPU", "VulkanFramesInFlight", static_cast<long>(gpu_vulkan_frames_in_flight));
   si.SetBoolValue("GPU", "PerSampleShading", gpu_per_sample_shading);
   si.SetBoolValue("GPU", "UseThread", gpu_use_thread);
   si.SetBoolValue("GPU", "ThreadedPresentation", gpu_threaded_presentation);
@@ -460,6 +469,7 @@ void Settings::Save(SettingsInterface& si) const
   si.SetBoolValue("Display", "ShowInputs", display_show_inputs);
   si.SetBoolValue("Display", "ShowEnhancements", display_show_enhancements);
   si.SetBoolValue("Display", "DisplayAllFrames", display_all_frames);
+  si.SetBoolValue("Display", "DropLateFrames", display_drop_late_frames);
   si.SetBoolValue("Display", "InternalResolutionScreenshots", display_internal_resolution_screenshots);
   si.SetBoolValue("Display", "VSync", video_sync_enabled);
   if (display_post_process_chain.empty())
@@ -493,6 +503,8 @@ void Settings::Save(SettingsInterface& si) const
 
   si.SetBoolValue("BIOS", "PatchTTYEnable", bios_patch_tty_enable);
   si.SetBoolValue("BIOS", "PatchFastBoot", bios_patch_fast_boot);
+  si.SetBoolValue("BIOS", "HLEEnable", bios_hle_enable);
+  si.SetStringValue("BIOS", "HLEFunctions", bios_hle_functions.c_str());
 
   for (u32 i = 0; i < NUM_CONTROLLER_AND_CARD_PORTS; i++)
   {
@@ -1072,14 +1084,15 @@ const char* Settings::GetControllerTypeDisplayName(ControllerType type)
   return s_controller_display_names[static_cast<int>(type)];
 }
 
-static std::array<const char*, 6> s_memory_card_type_names = {
-  {"None", "Shared", "PerGame", "PerGameTitle", "PerGameFileTitle", "NonPersistent"}};
-static std::array<const char*, 6> s_memory_card_type_display_names = {
+static std::array<const char*, 7> s_memory_card_type_names = {
+  {"None", "Shared", "PerGame", "PerGameTitle", "PerGameFileTitle", "NonPersistent", "Folder"}};
+static std::array<const char*, 7> s_memory_card_type_display_names = {
   {TRANSLATABLE("MemoryCardType", "No Memory Card"), TRANSLATABLE("MemoryCardType", "Shared Between All Games"),
    TRANSLATABLE("MemoryCardType", "Separate Card Per Game (Game Code)"),
    TRANSLATABLE("MemoryCardType", "Separate Card Per Game (Game Title)"),
    TRANSLATABLE("MemoryCardType", "Separate Card Per Game (File Title)"),
-   TRANSLATABLE("MemoryCardType", "Non-Persistent Card (Do Not Save)")}};
+   TRANSLATABLE("MemoryCardType", "Non-Persistent Card (Do Not Save)"),
+   TRANSLATABLE("MemoryCardType", "Shared Folder (One File Per Save)")}};
 
 std::optional<MemoryCardType> Settings::ParseMemoryCardTypeName(const char* str)
 {
@@ -1129,6 +1142,11 @@ std::string Settings::GetGameMemoryCardPath(const char* game_code, u32 slot)
   return Path::Combine(EmuFolders::MemoryCards, fmt::format("{}_{}.mcd", game_code, slot + 1));
 }
 
+std::string Settings::GetFolderMemoryCardPath(u32 slot)
+{
+  return Path::Combine(EmuFolders::MemoryCards, fmt::format("shared_folder_{}", slot + 1));
+}
+
 static std::array<const char*, 4> s_multitap_enable_mode_names = {{"Disabled", "Port1Only", "Port2Only", "BothPorts"}};
 static std::array<const char*, 4> s_multitap_enable_mode_display_names = {
   {TRANSLATABLE("MultitapMode", "Disabled"), TRANSLATABLE("MultitapMode", "Enable on Port 1 Only"),
@@ -1188,6 +1206,8 @@ void EmuFolders::SetDefaults()
   Screenshots = Path::Combine(DataRoot, "screenshots");
   Shaders = Path::Combine(DataRoot, "shaders");
   Textures = Path::Combine(DataRoot, "textures");
+
+  CDImage::SetArchiveIndexDirectory(Path::Combine(Cache, "archives"));
 }
 
 static std::string LoadPathFromSettings(SettingsInterface& si, const std::string& root, const char* section,
@@ -1215,6 +1235,7 @@ void EmuFolders::LoadConfig(SettingsInterface& si)
   Screenshots = LoadPathFromSettings(si, DataRoot, "Folders", "Screenshots", "screenshots");
   Shaders = LoadPathFromSettings(si, DataRoot, "Folders", "Shaders", "shaders");
   Textures = LoadPathFromSettings(si, DataRoot, "Folders", "Textures", "textures");
+  CDImage::SetArchiveIndexDirectory(Path::Combine(Cache, "archives"));
 
   Log_DevPrintf("BIOS Directory: %s", Bios.c_str());
   Log_DevPrintf("Cache Directory: %s", Cache.c_str());
@@ -1273,6 +1294,7 @@ bool EmuFolders::EnsureFoldersExist()
   result = FileSystem::EnsureDirectoryExists(Cache.c_str(), false) && result;
   result = FileSystem::EnsureDirectoryExists(Path::Combine(Cache, "achievement_badge").c_str(), false) && result;
   result = FileSystem::EnsureDirectoryExists(Path::Combine(Cache, "achievement_gameicon").c_str(), false) && result;
+  result = FileSystem::EnsureDirectoryExists(Path::Combine(Cache, "archives").c_str(), false) && result;
   result = FileSystem::EnsureDirectoryExists(Cheats.c_str(), false) && result;
   result = FileSystem::EnsureDirectoryExists(Covers.c_str(), false) && result;
   result = FileSystem::EnsureDirectoryExists(Dumps.c_str(), false) && result;
@@ -79,6 +79,7 @@ struct Settings
   bool rewind_enable = false;
   float rewind_save_frequency = 10.0f;
   u32 rewind_save_slots = 10;
+  bool rewind_native_vram = false;
   u32 runahead_frames = 0;
 
   GPURenderer gpu_renderer = DEFAULT_GPU_RENDERER;
@@ -90,6 +91,7 @@ struct Settings
   bool gpu_use_software_renderer_for_readbacks = false;
   bool gpu_threaded_presentation = true;
   bool gpu_use_debug_device = false;
+  u32 gpu_vulkan_frames_in_flight = DEFAULT_GPU_VULKAN_FRAMES_IN_FLIGHT;
   bool gpu_per_sample_shading = false;
   bool gpu_true_color = true;
   bool gpu_scaled_dithering = true;
@@ -128,6 +130,7 @@ struct Settings
   bool display_show_inputs = false;
   bool display_show_enhancements = false;
   bool display_all_frames = false;
+  bool display_drop_late_frames = false;
   bool display_internal_resolution_screenshots = false;
   bool video_sync_enabled = DEFAULT_VSYNC_VALUE;
   float display_osd_scale = 100.0f;
@@ -209,6 +212,8 @@ struct Settings
 
   bool bios_patch_tty_enable = false;
   bool bios_patch_fast_boot = DEFAULT_FAST_BOOT_VALUE;
+  bool bios_hle_enable = false;
+  std::string bios_hle_functions;
   bool enable_8mb_ram = false;
 
   std::array<ControllerType, NUM_CONTROLLER_AND_CARD_PORTS> controller_types{};
@@ -268,8 +273,9 @@ struct Settings
 
   ALWAYS_INLINE static bool IsPerGameMemoryCardType(MemoryCardType type)
   {
+    // Folder cards only load the running game's saves, so they're reopened when the game changes too.
     return (type == MemoryCardType::PerGame || type == MemoryCardType::PerGameTitle ||
-            type == MemoryCardType::PerGameFileTitle);
+            type == MemoryCardType::PerGameFileTitle || type == MemoryCardType::Folder);
   }
   bool HasAnyPerGameMemoryCards() const;
 
@@ -280,6 +286,9 @@ struct Settings
   /// Returns the default path to a memory card for a specific game.
   static std::string GetGameMemoryCardPath(const char* game_code, u32 slot);
 
+  /// Returns the path to the folder which holds the saves for a folder memory card.
+  static std::string GetFolderMemoryCardPath(u32 slot);
+
   static void CPUOverclockPercentToFraction(u32 percent, u32* numerator, u32* denominator);
   static u32 CPUOverclockFractionToPercent(u32 numerator, u32 denominator);
 
@@ -293,6 +302,7 @@ struct Settings
     DEFAULT_DMA_HALT_TICKS = 100,
     DEFAULT_GPU_FIFO_SIZE = 16,
     DEFAULT_GPU_MAX_RUN_AHEAD = 128,
+    DEFAULT_GPU_VULKAN_FRAMES_IN_FLIGHT = 2,
     DEFAULT_VRAM_WRITE_DUMP_WIDTH_THRESHOLD = 128,
     DEFAULT_VRAM_WRITE_DUMP_HEIGHT_THRESHOLD = 128,
   };
@@ -2,6 +2,7 @@
 #include "IconsFontAwesome5.h"
 #include "achievements.h"
 #include "bios.h"
+#include "bios_hle.h"
 #include "bus.h"
 #include "cdrom.h"
 #include "cheats.h"
@@ -10,6 +11,7 @@
 #include "common/log.h"
 #include "common/make_array.h"
 #include "common/path.h"
+#include "common/startup_trace.h"
 #include "common/string_util.h"
 #include "common/threading.h"
 #include "controller.h"
@@ -30,6 +32,7 @@
 #include "mdec.h"
 #include "memory_card.h"
 #include "multitap.h"
+#include "netplay.h"
 #include "pad.h"
 #include "pgxp.h"
 #include "psf_loader.h"
@@ -76,6 +79,7 @@ struct MemorySaveState
 {
   std::unique_ptr<HostDisplayTexture> vram_texture;
   std::unique_ptr<GrowableMemoryByteStream> state_stream;
+  bool native_vram = false;
 };
 
 namespace System {
@@ -189,6 +193,7 @@ static s32 s_rewind_save_counter = -1;
 static bool s_rewinding_first_save = false;
 
 static std::deque<MemorySaveState> s_runahead_states;
+static std::vector<MemorySaveState> s_rollback_states;
 static bool s_runahead_replay_pending = false;
 static u32 s_runahead_frames = 0;
 
@@ -371,7 +376,7 @@ bool System::IsLoadableFilename(const std::string_view& path)
                                                 ".exe", ".psexe", ".ps-exe",                            // exes
                                                 ".psf", ".minipsf",                                     // psf
                                                 ".m3u",                                                 // playlists
-                                                ".pbp");
+                                                ".pbp", ".zip");
 
   for (const char* test_extension : extensions)
   {
@@ -755,6 +760,8 @@ bool System::RecreateGPU(GPURenderer renderer, bool force_recreate_display, bool
 
 std::unique_ptr<CDImage> System::OpenCDImage(const char* path, Common::Error* error, bool check_for_patches)
 {
+  StartupTrace::Phase trace_phase("Open disc");
+
   std::unique_ptr<CDImage> media = CDImage::Open(path, error);
   if (!media)
     return {};
@@ -1031,6 +1038,8 @@ bool System::SaveResumeState()
 
 bool System::BootSystem(SystemBootParameters parameters)
 {
+  StartupTrace::Phase trace_phase("Boot system");
+
   if (!parameters.save_state.empty())
   {
     // loading a state, so pull the media path from the save state to avoid a double change
@@ -1239,11 +1248,21 @@ bool System::BootSystem(SystemBootParameters parameters)
   if (IsRunning())
     UpdateSpeedLimiterState();
 
+  if (!parameters.netplay_remote_address.empty() &&
+      !Netplay::Start(parameters.netplay_player, parameters.netplay_local_port, parameters.netplay_remote_address,
+                      parameters.netplay_input_delay.value_or(Netplay::DEFAULT_INPUT_DELAY)))
+  {
+    Host::ReportErrorAsync(Host::TranslateString("System", "Error"),
+                           Host::TranslateString("System", "Failed to start netplay session."));
+  }
+
   return true;
 }
 
 bool System::Initialize(bool force_software_renderer)
 {
+  StartupTrace::Phase trace_phase("Initialize components");
+
   g_ticks_per_second = ScaleTicksToOverclock(MASTER_CLOCK);
   s_max_slice_ticks = ScaleTicksToOverclock(MASTER_CLOCK / 10);
   s_frame_number = 1;
@@ -1277,6 +1296,7 @@ bool System::Initialize(bool force_software_renderer)
   TimingEvents::Initialize();
 
   CPU::Initialize();
+  BIOS::HLE::UpdateSettings();
 
   if (!Bus::Initialize())
   {
@@ -1369,6 +1389,8 @@ void System::DestroySystem()
 
   SetTimerResolutionIncreased(false);
 
+  Netplay::Stop();
+
   s_cpu_thread_usage = {};
 
   ClearMemorySaveStates();
@@ -1484,6 +1506,8 @@ void System::RecreateSystem()
 
 bool System::CreateGPU(GPURenderer renderer)
 {
+  StartupTrace::Phase trace_phase("Create GPU");
+
   switch (renderer)
   {
 #ifdef WITH_OPENGL
@@ -2013,6 +2037,13 @@ void System::RunFrame()
 {
   s_frame_timer.Reset();
 
+  if (Netplay::IsActive())
+  {
+    Netplay::RunFrame();
+    s_next_frame_time += s_frame_period;
+    return;
+  }
+
   if (s_rewind_load_counter >= 0)
   {
     DoRewind();
@@ -2026,6 +2057,10 @@ void System::RunFrame()
 
   s_next_frame_time += s_frame_period;
 
+  // Frame numbers restart at one on boot, so this is the first frame of the boot being traced.
+  if (s_frame_number == 2 && StartupTrace::IsActive())
+    StartupTrace::Mark("First frame");
+
   if (s_memory_saves_enabled)
     DoMemorySaveStates();
 }
@@ -2237,12 +2272,14 @@ void System::UpdateSpeedLimiterState()
 
   g_host_display->SetDisplayMaxFPS(max_display_fps);
   g_host_display->SetVSync(video_sync_enabled);
+  g_host_display->SetDropLateFrames(g_settings.display_drop_late_frames);
 
   if (g_settings.increase_timer_resolution)
     SetTimerResolutionIncreased(m_throttler_enabled);
 
-  // When syncing to host and using vsync, we don't need to sleep.
-  if (syncing_to_host && video_sync_enabled && m_display_all_frames)
+  // When syncing to host and using vsync, we don't need to sleep. Unless frames can be dropped, in which case
+  // presentation no longer blocks emulation.
+  if (syncing_to_host && video_sync_enabled && m_display_all_frames && !g_settings.display_drop_late_frames)
   {
     Log_InfoPrintf("Using host vsync for throttling.");
     m_throttler_enabled = false;
@@ -2634,6 +2671,14 @@ std::unique_ptr<MemoryCard> System::GetMemoryCardForSlot(u32 slot, MemoryCardTyp
     case MemoryCardType::NonPersistent:
       return MemoryCard::Create();
 
+    case MemoryCardType::Folder:
+    {
+      const std::vector<std::string> serials(s_running_game_code.empty() ?
+                                               std::vector<std::string>() :
+                                               GameDatabase::GetDiscSetSerials(s_running_game_code));
+      return MemoryCard::OpenFolder(Settings::GetFolderMemoryCardPath(slot), serials);
+    }
+
     case MemoryCardType::None:
     default:
       return nullptr;
@@ -2825,6 +2870,8 @@ void System::UpdateRunningGame(const char* path, CDImage* image, bool booting)
   if (!booting && s_running_game_path == path)
     return;
 
+  StartupTrace::Phase trace_phase("Identify game");
+
   s_running_game_path.clear();
   s_running_game_code.clear();
   s_running_game_title.clear();
@@ -3016,11 +3063,13 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
 {
   if (IsValid() && (g_settings.gpu_renderer != old_settings.gpu_renderer ||
                     g_settings.gpu_use_debug_device != old_settings.gpu_use_debug_device ||
-                    g_settings.gpu_threaded_presentation != old_settings.gpu_threaded_presentation))
+                    g_settings.gpu_threaded_presentation != old_settings.gpu_threaded_presentation ||
+                    g_settings.gpu_vulkan_frames_in_flight != old_settings.gpu_vulkan_frames_in_flight))
   {
-    // if debug device/threaded presentation change, we need to recreate the whole display
+    // if debug device/threaded presentation/frames in flight change, we need to recreate the whole display
     const bool recreate_display = (g_settings.gpu_use_debug_device != old_settings.gpu_use_debug_device ||
-                                   g_settings.gpu_threaded_presentation != old_settings.gpu_threaded_presentation);
+                                   g_settings.gpu_threaded_presentation != old_settings.gpu_threaded_presentation ||
+                                   g_settings.gpu_vulkan_frames_in_flight != old_settings.gpu_vulkan_frames_in_flight);
 
     Host::AddFormattedOSDMessage(5.0f, Host::TranslateString("OSDMessage", "Switching to %s%s GPU renderer."),
                                  Settings::GetRendererName(g_settings.gpu_renderer),
@@ -3087,6 +3136,16 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
         CPU::ClearICache();
     }
 
+    if (g_settings.bios_hle_enable != old_settings.bios_hle_enable ||
+        g_settings.bios_hle_functions != old_settings.bios_hle_functions)
+    {
+      BIOS::HLE::UpdateSettings();
+
+      // kernel call vectors are only left uncompiled while HLE is active
+      if (g_settings.IsUsingCodeCache())
+        CPU::CodeCache::Flush();
+    }
+
     g_spu.GetOutputStream()->SetOutputVolume(GetAudioOutputVolume());
 
     if (g_settings.gpu_resolution_scale != old_settings.gpu_resolution_scale ||
@@ -3166,6 +3225,7 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
     if (g_settings.rewind_enable != old_settings.rewind_enable ||
         g_settings.rewind_save_frequency != old_settings.rewind_save_frequency ||
         g_settings.rewind_save_slots != old_settings.rewind_save_slots ||
+        g_settings.rewind_native_vram != old_settings.rewind_native_vram ||
         g_settings.runahead_frames != old_settings.runahead_frames)
     {
       UpdateMemorySaveStateSettings();
@@ -3188,6 +3248,7 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
         g_settings.fast_forward_speed != old_settings.fast_forward_speed ||
         g_settings.display_max_fps != old_settings.display_max_fps ||
         g_settings.display_all_frames != old_settings.display_all_frames ||
+        g_settings.display_drop_late_frames != old_settings.display_drop_late_frames ||
         g_settings.sync_to_host_refresh_rate != old_settings.sync_to_host_refresh_rate)
     {
       UpdateSpeedLimiterState();
@@ -3234,11 +3295,20 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
     UpdateMultitaps();
 }
 
-void System::CalculateRewindMemoryUsage(u32 num_saves, u64* ram_usage, u64* vram_usage)
+void System::CalculateRewindMemoryUsage(u32 num_saves, bool native_vram, u64* ram_usage, u64* vram_usage)
 {
+  // MAX_SAVE_STATE_SIZE already accounts for native VRAM, which is what the software renderer always stores.
   *ram_usage = MAX_SAVE_STATE_SIZE * static_cast<u64>(num_saves);
-  *vram_usage = (VRAM_WIDTH * VRAM_HEIGHT * 4) * static_cast<u64>(std::max(g_settings.gpu_resolution_scale, 1u)) *
-                static_cast<u64>(g_settings.gpu_multisamples) * static_cast<u64>(num_saves);
+  if (native_vram || g_settings.gpu_renderer == GPURenderer::Software)
+  {
+    *vram_usage = 0;
+  }
+  else
+  {
+    const u64 scale = std::max(g_settings.gpu_resolution_scale, 1u);
+    *vram_usage = (VRAM_WIDTH * VRAM_HEIGHT * 4) * scale * scale * static_cast<u64>(g_settings.gpu_multisamples) *
+                  static_cast<u64>(num_saves);
+  }
 }
 
 void System::ClearMemorySaveStates()
@@ -3259,7 +3329,7 @@ void System::UpdateMemorySaveStateSettings()
     s_rewind_save_counter = 0;
 
     u64 ram_usage, vram_usage;
-    CalculateRewindMemoryUsage(g_settings.rewind_save_slots, &ram_usage, &vram_usage);
+    CalculateRewindMemoryUsage(g_settings.rewind_save_slots, g_settings.rewind_native_vram, &ram_usage, &vram_usage);
     Log_InfoPrintf(
       "Rewind is enabled, saving every %d frames, with %u slots and %" PRIu64 "MB RAM and %" PRIu64 "MB VRAM usage",
       std::max(s_rewind_save_frequency, 1), g_settings.rewind_save_slots, ram_usage / 1048576, vram_usage / 1048576);
@@ -3285,7 +3355,7 @@ bool System::LoadMemoryState(const MemorySaveState& mss)
 
   StateWrapper sw(mss.state_stream.get(), StateWrapper::Mode::Read, SAVE_STATE_VERSION);
   HostDisplayTexture* host_texture = mss.vram_texture.get();
-  if (!DoState(sw, &host_texture, true, true))
+  if (!DoState(sw, mss.native_vram ? nullptr : &host_texture, true, true))
   {
     Host::ReportErrorAsync("Error", "Failed to load memory save state, resetting.");
     InternalReset();
@@ -3302,9 +3372,13 @@ bool System::SaveMemoryState(MemorySaveState* mss)
   else
     mss->state_stream->SeekAbsolute(0);
 
+  // Native VRAM states read back and store the unscaled VRAM in the stream, and drop the upscaled copy.
+  if (mss->native_vram)
+    mss->vram_texture.reset();
+
   HostDisplayTexture* host_texture = mss->vram_texture.release();
   StateWrapper sw(mss->state_stream.get(), StateWrapper::Mode::Write, SAVE_STATE_VERSION);
-  if (!DoState(sw, &host_texture, false, true))
+  if (!DoState(sw, mss->native_vram ? nullptr : &host_texture, false, true))
   {
     Log_ErrorPrint("Failed to create rewind state.");
     delete host_texture;
@@ -3330,6 +3404,7 @@ bool System::SaveRewindState()
     s_rewind_states.pop_front();
   }
 
+  mss.native_vram = g_settings.rewind_native_vram;
   if (!SaveMemoryState(&mss))
     return false;
 
@@ -3513,6 +3588,48 @@ void System::DoMemorySaveStates()
     SaveRunaheadState();
 }
 
+void System::SetRollbackStateCount(u32 count)
+{
+  s_rollback_states.clear();
+  s_rollback_states.resize(count);
+}
+
+bool System::SaveRollbackState(u32 slot)
+{
+  MemorySaveState& mss = s_rollback_states[slot];
+  if (!SaveMemoryState(&mss))
+    return false;
+
+  // Drop anything left over from a larger state, so the hash only covers this one.
+  mss.state_stream->Resize(static_cast<u32>(mss.state_stream->GetPosition()));
+  return true;
+}
+
+bool System::LoadRollbackState(u32 slot)
+{
+  return LoadMemoryState(s_rollback_states[slot]);
+}
+
+u64 System::GetRollbackStateHash(u32 slot)
+{
+  const MemorySaveState& mss = s_rollback_states[slot];
+  if (!mss.state_stream)
+    return 0;
+
+  return XXH64(mss.state_stream->GetMemoryPointer(), static_cast<size_t>(mss.state_stream->GetSize()), 0);
+}
+
+void System::RunRollbackFrame(bool resimulating)
+{
+  if (resimulating)
+    g_spu.SetAudioOutputMuted(true);
+
+  DoRunFrame();
+
+  if (resimulating)
+    g_spu.SetAudioOutputMuted(false);
+}
+
 void System::SetRunaheadReplayFlag()
 {
   if (s_runahead_frames == 0 || s_runahead_states.empty())
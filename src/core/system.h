@@ -32,6 +32,12 @@ struct SystemBootParameters
   u32 media_playlist_index = 0;
   bool load_image_to_ram = false;
   bool force_software_renderer = false;
+
+  /// Starts a netplay session after booting when set, see Netplay::Start().
+  std::string netplay_remote_address;
+  u32 netplay_player = 0;
+  u16 netplay_local_port = 0;
+  std::optional<u32> netplay_input_delay;
 };
 
 struct SaveStateInfo
@@ -196,6 +202,15 @@ bool BootSystem(SystemBootParameters parameters);
 void PauseSystem(bool paused);
 void ResetSystem();
 
+/// Rollback states, used by netplay. Slots are reused, the caller keeps track of which frame each holds.
+void SetRollbackStateCount(u32 count);
+bool SaveRollbackState(u32 slot);
+bool LoadRollbackState(u32 slot);
+u64 GetRollbackStateHash(u32 slot);
+
+/// Runs a single frame without throttling, for netplay. Audio is muted when re-simulating.
+void RunRollbackFrame(bool resimulating);
+
 /// Loads state from the specified filename.
 bool LoadState(const char* filename);
 bool SaveState(const char* filename, bool backup_existing_save);
@@ -420,7 +435,9 @@ void HostDisplayResized();
 //////////////////////////////////////////////////////////////////////////
 // Memory Save States (Rewind and Runahead)
 //////////////////////////////////////////////////////////////////////////
-void CalculateRewindMemoryUsage(u32 num_saves, u64* ram_usage, u64* vram_usage);
+/// Estimates the host memory used by rewind. When native_vram is set, VRAM is kept at native resolution in the state
+/// itself instead of in a host texture, so no GPU memory is used.
+void CalculateRewindMemoryUsage(u32 num_saves, bool native_vram, u64* ram_usage, u64* vram_usage);
 void ClearMemorySaveStates();
 void UpdateMemorySaveStateSettings();
 bool LoadRewindState(u32 skip_saves = 0, bool consume_state = true);
@@ -35,7 +35,7 @@ static constexpr u32 VRAMRGBA5551ToRGBA8888(u16 color)
 
 std::string TextureReplacementHash::ToString() const
 {
-  return StringUtil::StdStringFromFormat("%" PRIx64 "%" PRIx64, high, low);
+  return StringUtil::StdStringFromFormat("%016" PRIx64 "%016" PRIx64, high, low);
 }
 
 bool TextureReplacementHash::ParseString(const std::string_view& sv)
@@ -68,6 +68,13 @@ void TextureReplacements::SetGameID(std::string game_id)
 
 const TextureReplacementTexture* TextureReplacements::GetVRAMWriteReplacement(u32 width, u32 height, const void* pixels)
 {
+  if (m_vram_write_replacements.empty() ||
+      (!m_vram_write_replacement_any_size &&
+       m_vram_write_replacement_sizes.find(PackVRAMWriteSize(width, height)) == m_vram_write_replacement_sizes.end()))
+  {
+    return nullptr;
+  }
+
   const TextureReplacementHash hash = GetVRAMWriteHash(width, height, pixels);
 
   const auto it = m_vram_write_replacements.find(hash);
@@ -115,6 +122,10 @@ void TextureReplacements::Shutdown()
 {
   m_texture_cache.clear();
   m_vram_write_replacements.clear();
+  m_vram_write_replacement_sizes.clear();
+  m_vram_write_replacement_any_size = false;
+  m_dumped_vram_writes.clear();
+  m_dumped_vram_writes_loaded = false;
   m_game_id.clear();
 }
 
@@ -134,27 +145,32 @@ TextureReplacementHash TextureReplacements::GetVRAMWriteHash(u32 width, u32 heig
   return {hash.low64, hash.high64};
 }
 
-std::string TextureReplacements::GetVRAMWriteDumpFilename(u32 width, u32 height, const void* pixels) const
+std::string TextureReplacements::GetVRAMWriteDumpFilename(u32 width, u32 height, const void* pixels)
 {
   if (m_game_id.empty())
     return {};
 
-  const TextureReplacementHash hash = GetVRAMWriteHash(width, height, pixels);
-  const std::string dump_directory(GetDumpDirectory());
-  std::string filename(Path::Combine(dump_directory, fmt::format("vram-write-{}.png", hash.ToString())));
+  if (!m_dumped_vram_writes_loaded)
+    LoadDumpedVRAMWrites();
 
-  if (FileSystem::FileExists(filename.c_str()))
+  const TextureReplacementHash hash = GetVRAMWriteHash(width, height, pixels);
+  if (!m_dumped_vram_writes.insert(hash).second)
     return {};
 
+  const std::string dump_directory(GetDumpDirectory());
   if (!FileSystem::EnsureDirectoryExists(dump_directory.c_str(), false))
     return {};
 
-  return filename;
+  return Path::Combine(dump_directory, fmt::format("vram-write-{}-{}x{}.png", hash.ToString(), width, height));
 }
 
 void TextureReplacements::Reload()
 {
   m_vram_write_replacements.clear();
+  m_vram_write_replacement_sizes.clear();
+  m_vram_write_replacement_any_size = false;
+  m_dumped_vram_writes.clear();
+  m_dumped_vram_writes_loaded = false;
 
   if (g_settings.texture_replacements.AnyReplacementsEnabled())
     FindTextures(GetSourceDirectory());
@@ -181,7 +197,7 @@ void TextureReplacements::PurgeUnreferencedTexturesFromCache()
 
 bool TextureReplacements::ParseReplacementFilename(const std::string& filename,
                                                    TextureReplacementHash* replacement_hash,
-                                                   ReplacmentType* replacement_type)
+                                                   ReplacmentType* replacement_type, u32* width, u32* height)
 {
   const char* extension = std::strrchr(filename.c_str(), '.');
   const char* title = std::strrchr(filename.c_str(), '/');
@@ -208,7 +224,31 @@ bool TextureReplacements::ParseReplacementFilename(const std::string& filename,
     return false;
   }
 
-  if (!replacement_hash->ParseString(std::string_view(hashpart, static_cast<size_t>(extension - hashpart))))
+  // Newer dumps are named vram-write-<hash>-<width>x<height>, older ones only include the hash.
+  std::string_view hashview(hashpart, static_cast<size_t>(extension - hashpart));
+  *width = 0;
+  *height = 0;
+  if (hashview.length() > 32 && hashview[32] == '-')
+  {
+    const std::string_view sizeview(hashview.substr(33));
+    const std::string_view::size_type xpos = sizeview.find('x');
+    if (xpos == std::string_view::npos)
+      return false;
+
+    const std::optional<u32> width_value = StringUtil::FromChars<u32>(sizeview.substr(0, xpos));
+    const std::optional<u32> height_value = StringUtil::FromChars<u32>(sizeview.substr(xpos + 1));
+    if (!width_value.has_value() || !height_value.has_value() || width_value.value() == 0 ||
+        height_value.value() == 0)
+    {
+      return false;
+    }
+
+    *width = width_value.value();
+    *height = height_value.value();
+    hashview = hashview.substr(0, 32);
+  }
+
+  if (!replacement_hash->ParseString(hashview))
     return false;
 
   extension++;
@@ -238,7 +278,8 @@ void TextureReplacements::FindTextures(const std::string& dir)
 
     TextureReplacementHash hash;
     ReplacmentType type;
-    if (!ParseReplacementFilename(fd.FileName, &hash, &type))
+    u32 width, height;
+    if (!ParseReplacementFilename(fd.FileName, &hash, &type, &width, &height))
       continue;
 
     switch (type)
@@ -253,12 +294,36 @@ void TextureReplacements::FindTextures(const std::string& dir)
         }
 
         m_vram_write_replacements.emplace(hash, std::move(fd.FileName));
+        if (width != 0)
+          m_vram_write_replacement_sizes.insert(PackVRAMWriteSize(width, height));
+        else
+          m_vram_write_replacement_any_size = true;
       }
       break;
     }
   }
 
   Log_InfoPrintf("Found %zu replacement VRAM writes for '%s'", m_vram_write_replacements.size(), m_game_id.c_str());
+  if (m_vram_write_replacement_any_size && !m_vram_write_replacements.empty())
+    Log_InfoPrintf("Some replacements do not include the write size in their name, all writes will be hashed.");
+}
+
+void TextureReplacements::LoadDumpedVRAMWrites()
+{
+  m_dumped_vram_writes_loaded = true;
+
+  FileSystem::FindResultsArray files;
+  FileSystem::FindFiles(GetDumpDirectory().c_str(), "vram-write-*", FILESYSTEM_FIND_FILES, &files);
+  for (const FILESYSTEM_FIND_DATA& fd : files)
+  {
+    TextureReplacementHash hash;
+    ReplacmentType type;
+    u32 width, height;
+    if (ParseReplacementFilename(fd.FileName, &hash, &type, &width, &height))
+      m_dumped_vram_writes.insert(hash);
+  }
+
+  Log_DevPrintf("Found %zu previously dumped VRAM writes", m_dumped_vram_writes.size());
 }
 
 const TextureReplacementTexture* TextureReplacements::LoadTexture(const std::string& filename)
@@ -5,6 +5,7 @@
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 struct TextureReplacementHash
@@ -63,18 +64,24 @@ private:
   };
 
   using VRAMWriteReplacementMap = std::unordered_map<TextureReplacementHash, std::string>;
+  using VRAMWriteSizeSet = std::unordered_set<u32>;
+  using VRAMWriteHashSet = std::unordered_set<TextureReplacementHash>;
   using TextureCache = std::unordered_map<std::string, TextureReplacementTexture>;
 
+  static constexpr u32 PackVRAMWriteSize(u32 width, u32 height) { return width | (height << 16); }
+
+  /// Width/height are set to zero if the filename does not include the size of the source write.
   static bool ParseReplacementFilename(const std::string& filename, TextureReplacementHash* replacement_hash,
-                                       ReplacmentType* replacement_type);
+                                       ReplacmentType* replacement_type, u32* width, u32* height);
 
   std::string GetSourceDirectory() const;
   std::string GetDumpDirectory() const;
 
   TextureReplacementHash GetVRAMWriteHash(u32 width, u32 height, const void* pixels) const;
-  std::string GetVRAMWriteDumpFilename(u32 width, u32 height, const void* pixels) const;
+  std::string GetVRAMWriteDumpFilename(u32 width, u32 height, const void* pixels);
 
   void FindTextures(const std::string& dir);
+  void LoadDumpedVRAMWrites();
 
   const TextureReplacementTexture* LoadTexture(const std::string& filename);
   void PreloadTextures();
@@ -85,6 +92,15 @@ private:
   TextureCache m_texture_cache;
 
   VRAMWriteReplacementMap m_vram_write_replacements;
+
+  // Sizes of the writes which have replacements, so that writes of other sizes don't need to be hashed. Replacements
+  // named without a size match any write, and disable the filter.
+  VRAMWriteSizeSet m_vram_write_replacement_sizes;
+  bool m_vram_write_replacement_any_size = false;
+
+  // Hashes of writes which have already been dumped, populated from the dump directory on first use.
+  VRAMWriteHashSet m_dumped_vram_writes;
+  bool m_dumped_vram_writes_loaded = false;
 };
 
 extern TextureReplacements g_texture_replacements;
\ No newline at end of file
@@ -147,6 +147,18 @@ void Timers::CheckForIRQ(u32 timer, u32 old_counter)
   {
     interrupt_request |= cs.mode.irq_on_overflow;
     cs.mode.reached_overflow = true;
+
+    // Counters which aren't armed are updated lazily, so the ticks can carry the counter past the target again after
+    // wrapping. The target reset above can't have applied, since the counter was already past the target.
+    cs.counter -= 0xFFFFu;
+    if (cs.target > 0 && cs.counter >= cs.target)
+    {
+      interrupt_request |= cs.mode.irq_at_target;
+      cs.mode.reached_target = true;
+      if (cs.mode.reset_at_target)
+        cs.counter %= cs.target;
+    }
+
     cs.counter %= 0xFFFFu;
   }
 
@@ -309,6 +321,10 @@ void Timers::WriteRegister(u32 offset, u32 value)
       Log_ErrorPrintf("Write unknown register in timer %u (offset 0x%02X, value 0x%X)", timer_index, offset, value);
       break;
   }
+
+  // the GPU only schedules events for hblank/dot clock interrupts which are armed
+  if (timer_index < 2 && cs.use_external_clock)
+    g_gpu->UpdateCRTCTickEvent();
 }
 
 void Timers::UpdateCountingEnabled(CounterState& cs)
@@ -353,15 +369,13 @@ void Timers::UpdateIRQ(u32 index)
 
 TickCount Timers::GetTicksUntilNextInterrupt() const
 {
-  TickCount min_ticks = System::GetMaxSliceTicks();
+  // Nothing depends on the counters when no interrupts are armed, reads catch up on the elapsed ticks instead.
+  TickCount min_ticks = System::MASTER_CLOCK;
   for (u32 i = 0; i < NUM_TIMERS; i++)
   {
     const CounterState& cs = m_states[i];
-    if (!cs.counting_enabled || (i < 2 && cs.external_counting_enabled) ||
-        (!cs.mode.irq_at_target && !cs.mode.irq_on_overflow && (cs.mode.irq_repeat || !cs.irq_done)))
-    {
+    if (!cs.counting_enabled || (i < 2 && cs.external_counting_enabled) || !IsIRQArmed(cs))
       continue;
-    }
 
     if (cs.mode.irq_at_target)
     {
@@ -34,7 +34,7 @@ public:
   ALWAYS_INLINE bool IsExternalIRQEnabled(u32 timer) const
   {
     const CounterState& cs = m_states[timer];
-    return (cs.external_counting_enabled && (cs.mode.bits & ((1u << 4) | (1u << 5))) != 0);
+    return (cs.external_counting_enabled && IsIRQArmed(cs));
   }
 
   TickCount GetTicksUntilIRQ(u32 timer) const;
@@ -84,6 +84,13 @@ private:
     bool irq_done;
   };
 
+  /// Returns true if the counter reaching its target or overflowing would raise an interrupt. When no timer is armed,
+  /// counters are only brought up to date when they are accessed.
+  ALWAYS_INLINE static bool IsIRQArmed(const CounterState& cs)
+  {
+    return ((cs.mode.irq_at_target || cs.mode.irq_on_overflow) && (cs.mode.irq_repeat || !cs.irq_done));
+  }
+
   void UpdateCountingEnabled(CounterState& cs);
   void CheckForIRQ(u32 index, u32 old_counter);
   void UpdateIRQ(u32 index);
@@ -145,6 +145,7 @@ enum class MemoryCardType
   PerGameTitle,
   PerGameFileTitle,
   NonPersistent,
+  Folder,
   Count
 };
 
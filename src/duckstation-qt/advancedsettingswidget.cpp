@@ -250,6 +250,8 @@ AdvancedSettingsWidget::AdvancedSettingsWidget(SettingsDialog* dialog, QWidget*
   addIntRangeTweakOption(dialog, m_ui.tweakOptionTable, tr("GPU Max Run-Ahead"), "Hacks", "GPUMaxRunAhead", 0, 1000,
                          Settings::DEFAULT_GPU_MAX_RUN_AHEAD);
   addBooleanTweakOption(dialog, m_ui.tweakOptionTable, tr("Use Debug Host GPU Device"), "GPU", "UseDebugDevice", false);
+  addIntRangeTweakOption(dialog, m_ui.tweakOptionTable, tr("Vulkan Frames In Flight"), "GPU", "VulkanFramesInFlight", 2,
+                         4, Settings::DEFAULT_GPU_VULKAN_FRAMES_IN_FLIGHT);
 
   addBooleanTweakOption(dialog, m_ui.tweakOptionTable, tr("Increase Timer Resolution"), "Main",
                         "IncreaseTimerResolution", true);
@@ -310,6 +312,8 @@ void AdvancedSettingsWidget::onResetToDefaultClicked()
   setIntRangeTweakOption(m_ui.tweakOptionTable, i++,
                          static_cast<int>(Settings::DEFAULT_GPU_MAX_RUN_AHEAD)); // GPU max run-ahead
   setBooleanTweakOption(m_ui.tweakOptionTable, i++, false);                      // Use debug host GPU device
+  setIntRangeTweakOption(m_ui.tweakOptionTable, i++,
+                         static_cast<int>(Settings::DEFAULT_GPU_VULKAN_FRAMES_IN_FLIGHT)); // Vulkan frames in flight
   setBooleanTweakOption(m_ui.tweakOptionTable, i++, true);                       // Increase timer resolution
   setBooleanTweakOption(m_ui.tweakOptionTable, i++, false);                      // Allow booting without SBI file
   setBooleanTweakOption(m_ui.tweakOptionTable, i++, false);                      // Create save state backups
@@ -24,6 +24,11 @@ DebuggerWindow::~DebuggerWindow() = default;
 
 void DebuggerWindow::onEmulationPaused()
 {
+  // Memory can be read directly again while paused.
+  m_memory_watch_active = false;
+  g_emu_thread->setMemoryWatch(-1, 0, 0);
+  m_ui.memoryView->clearSnapshot();
+
   setUIEnabled(true);
   refreshAll();
   refreshBreakpointList();
@@ -38,6 +43,11 @@ void DebuggerWindow::onEmulationResumed()
 {
   setUIEnabled(false);
 
+  // Keep the memory view live while running, from copies made by the emulation thread at the end of each frame.
+  m_memory_watch_active = true;
+  m_ui.memoryView->startSnapshots();
+  updateMemoryWatch();
+
   {
     QSignalBlocker sb(m_ui.actionPause);
     m_ui.actionPause->setChecked(false);
@@ -355,6 +365,8 @@ void DebuggerWindow::onMemorySearchStringChanged(const QString&)
 void DebuggerWindow::closeEvent(QCloseEvent* event)
 {
   QMainWindow::closeEvent(event);
+  m_memory_watch_active = false;
+  g_emu_thread->setMemoryWatch(-1, 0, 0);
   g_emu_thread->setSystemPaused(true, true);
   CPU::ClearBreakpoints();
   g_emu_thread->setSystemPaused(false);
@@ -387,6 +399,8 @@ void DebuggerWindow::connectSignals()
   connect(hi, &EmuThread::systemPaused, this, &DebuggerWindow::onEmulationPaused);
   connect(hi, &EmuThread::systemResumed, this, &DebuggerWindow::onEmulationResumed);
   connect(hi, &EmuThread::debuggerMessageReported, this, &DebuggerWindow::onDebuggerMessageReported);
+  connect(hi, &EmuThread::memoryWatchUpdated, this, &DebuggerWindow::onMemoryWatchUpdated);
+  connect(m_ui.memoryView, &MemoryViewWidget::visibleRangeChanged, this, &DebuggerWindow::updateMemoryWatch);
 
   connect(m_ui.actionPause, &QAction::toggled, this, &DebuggerWindow::onPauseActionToggled);
   connect(m_ui.actionRunToCursor, &QAction::triggered, this, &DebuggerWindow::onRunToCursorTriggered);
@@ -450,7 +464,6 @@ void DebuggerWindow::setUIEnabled(bool enabled)
   m_ui.codeView->setEnabled(enabled);
   m_ui.registerView->setEnabled(enabled);
   m_ui.stackView->setEnabled(enabled);
-  m_ui.memoryView->setEnabled(enabled);
   m_ui.actionRunToCursor->setEnabled(enabled);
   m_ui.actionAddBreakpoint->setEnabled(enabled);
   m_ui.actionToggleBreakpoint->setEnabled(enabled);
@@ -462,10 +475,8 @@ void DebuggerWindow::setUIEnabled(bool enabled)
   m_ui.actionGoToAddress->setEnabled(enabled);
   m_ui.actionGoToPC->setEnabled(enabled);
   m_ui.actionTrace->setEnabled(enabled);
-  m_ui.memoryRegionRAM->setEnabled(enabled);
-  m_ui.memoryRegionEXP1->setEnabled(enabled);
-  m_ui.memoryRegionScratchpad->setEnabled(enabled);
-  m_ui.memoryRegionBIOS->setEnabled(enabled);
+
+  // The memory view and region selection stay enabled, since memory is watched while running.
 }
 
 void DebuggerWindow::setMemoryViewRegion(Bus::MemoryRegion region)
@@ -493,9 +504,30 @@ void DebuggerWindow::setMemoryViewRegion(Bus::MemoryRegion region)
 
 #undef SET_REGION_REGION_BUTTON
 
+  updateMemoryWatch();
   m_ui.memoryView->repaint();
 }
 
+void DebuggerWindow::updateMemoryWatch()
+{
+  if (!m_memory_watch_active)
+    return;
+
+  const size_t start = m_ui.memoryView->visibleStartOffset();
+  const size_t end = m_ui.memoryView->visibleEndOffset();
+  g_emu_thread->setMemoryWatch(static_cast<int>(m_active_memory_region), static_cast<quint32>(start),
+                               static_cast<quint32>(end - start));
+}
+
+void DebuggerWindow::onMemoryWatchUpdated(int region, quint32 offset, const QByteArray& data)
+{
+  // Ignore copies of a range we've since scrolled away from or switched region from.
+  if (!m_memory_watch_active || region != static_cast<int>(m_active_memory_region))
+    return;
+
+  m_ui.memoryView->updateSnapshot(offset, data.constData(), static_cast<size_t>(data.size()));
+}
+
 void DebuggerWindow::toggleBreakpoint(VirtualMemoryAddress address)
 {
   const bool new_bp_state = !CPU::HasBreakpointAtAddress(address);
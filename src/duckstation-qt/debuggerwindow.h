@@ -54,6 +54,8 @@ private Q_SLOTS:
   void onCodeViewItemActivated(QModelIndex index);
   void onMemorySearchTriggered();
   void onMemorySearchStringChanged(const QString&);
+  void onMemoryWatchUpdated(int region, quint32 offset, const QByteArray& data);
+  void updateMemoryWatch();
 
 
 private:
@@ -80,4 +82,6 @@ private:
   Bus::MemoryRegion m_active_memory_region;
 
   PhysicalMemoryAddress m_next_memory_search_address = 0;
+
+  bool m_memory_watch_active = false;
 };
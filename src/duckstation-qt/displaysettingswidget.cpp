@@ -46,6 +46,7 @@ DisplaySettingsWidget::DisplaySettingsWidget(SettingsDialog* dialog, QWidget* pa
                                                "InternalResolutionScreenshots", false);
   SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.vsync, "Display", "VSync", false);
   SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.displayAllFrames, "Display", "DisplayAllFrames", false);
+  SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.dropLateFrames, "Display", "DropLateFrames", false);
   SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.gpuThread, "GPU", "UseThread", true);
   SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.threadedPresentation, "GPU", "ThreadedPresentation", true);
   SettingWidgetBinder::BindWidgetToBoolSetting(sif, m_ui.syncToHostRefreshRate, "Main", "SyncToHostRefreshRate", false);
@@ -126,6 +127,11 @@ DisplaySettingsWidget::DisplaySettingsWidget(SettingsDialog* dialog, QWidget* pa
   dialog->registerWidgetHelp(m_ui.threadedPresentation, tr("Threaded Presentation"), tr("Checked"),
                              tr("Presents frames on a background thread when fast forwarding or vsync is disabled. "
                                 "This can measurably improve performance in the Vulkan renderer."));
+  dialog->registerWidgetHelp(
+    m_ui.dropLateFrames, tr("Drop Late Frames"), tr("Unchecked"),
+    tr("Skips displaying a frame instead of waiting when the previous frame has not been presented yet, so a slow "
+       "vblank or compositor does not hold up emulation. Useful when the host and console refresh rates differ. "
+       "Currently only supported in the Vulkan renderer."));
   dialog->registerWidgetHelp(m_ui.gpuThread, tr("Threaded Rendering"), tr("Checked"),
                              tr("Uses a second thread for drawing graphics. Currently only available for the software "
                                 "renderer, but can provide a significant speed improvement, and is safe to use."));
@@ -266,6 +272,7 @@ void DisplaySettingsWidget::populateGPUAdaptersAndResolutions()
 
   m_ui.gpuThread->setEnabled(thread_supported);
   m_ui.threadedPresentation->setEnabled(threaded_presentation_supported);
+  m_ui.dropLateFrames->setEnabled(threaded_presentation_supported);
 }
 
 void DisplaySettingsWidget::onGPUAdapterIndexChanged()
@@ -1,8 +1,12 @@
 #include "gamelistmodel.h"
 #include "common/file_system.h"
+#include "common/log.h"
+#include "common/md5_digest.h"
 #include "common/path.h"
 #include "common/string_util.h"
+#include "core/settings.h"
 #include "core/system.h"
+#include "fmt/format.h"
 #include "qthost.h"
 #include "qtutils.h"
 #include <QtConcurrent/QtConcurrent>
@@ -13,6 +17,9 @@
 #include <QtGui/QGuiApplication>
 #include <QtGui/QIcon>
 #include <QtGui/QPainter>
+#include <cstdio>
+#include <unordered_set>
+Log_SetChannel(GameListModel);
 
 static constexpr std::array<const char*, GameListModel::Column_Count> s_column_names = {
   {"Type", "Serial", "Title", "File Title", "Developer", "Publisher", "Genre", "Year", "Players", "Size", "Region",
@@ -22,6 +29,7 @@ static constexpr int COVER_ART_WIDTH = 512;
 static constexpr int COVER_ART_HEIGHT = 512;
 static constexpr int COVER_ART_SPACING = 32;
 static constexpr int MIN_COVER_CACHE_SIZE = 256;
+static constexpr int MIN_COVER_THUMBNAIL_SIZE = 64;
 
 static int DPRScale(int size, float dpr)
 {
@@ -33,53 +41,52 @@ static int DPRUnscale(int size, float dpr)
   return static_cast<int>(static_cast<float>(size) / dpr);
 }
 
-static void resizeAndPadPixmap(QPixmap* pm, int expected_width, int expected_height, float dpr)
+static void resizeAndPadImage(QImage* image, int expected_width, int expected_height, float dpr)
 {
   const int dpr_expected_width = DPRScale(expected_width, dpr);
   const int dpr_expected_height = DPRScale(expected_height, dpr);
-  if (pm->width() == dpr_expected_width && pm->height() == dpr_expected_height)
+  if (image->width() == dpr_expected_width && image->height() == dpr_expected_height)
     return;
 
-  *pm = pm->scaled(dpr_expected_width, dpr_expected_height, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-  if (pm->width() == dpr_expected_width && pm->height() == dpr_expected_height)
+  *image = image->scaled(dpr_expected_width, dpr_expected_height, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+  image->setDevicePixelRatio(dpr);
+  if (image->width() == dpr_expected_width && image->height() == dpr_expected_height)
     return;
 
   // QPainter works in unscaled coordinates.
   int xoffs = 0;
   int yoffs = 0;
-  if (pm->width() < dpr_expected_width)
-    xoffs = DPRUnscale((dpr_expected_width - pm->width()) / 2, dpr);
-  if (pm->height() < dpr_expected_height)
-    yoffs = DPRUnscale((dpr_expected_height - pm->height()) / 2, dpr);
+  if (image->width() < dpr_expected_width)
+    xoffs = DPRUnscale((dpr_expected_width - image->width()) / 2, dpr);
+  if (image->height() < dpr_expected_height)
+    yoffs = DPRUnscale((dpr_expected_height - image->height()) / 2, dpr);
 
-  QPixmap padded_image(dpr_expected_width, dpr_expected_height);
+  QImage padded_image(dpr_expected_width, dpr_expected_height, QImage::Format_ARGB32_Premultiplied);
   padded_image.setDevicePixelRatio(dpr);
   padded_image.fill(Qt::transparent);
   QPainter painter;
   if (painter.begin(&padded_image))
   {
     painter.setCompositionMode(QPainter::CompositionMode_Source);
-    painter.drawPixmap(xoffs, yoffs, *pm);
-    painter.setCompositionMode(QPainter::CompositionMode_Destination);
-    painter.fillRect(padded_image.rect(), QColor(0, 0, 0, 0));
+    painter.drawImage(xoffs, yoffs, *image);
     painter.end();
   }
 
-  *pm = padded_image;
+  *image = std::move(padded_image);
 }
 
-static QPixmap createPlaceholderImage(const QPixmap& placeholder_pixmap, int width, int height, float scale,
-                                      const std::string& title)
+static QImage createPlaceholderImage(const QImage& placeholder_image, int width, int height, float scale,
+                                     const std::string& title)
 {
   const float dpr = qApp->devicePixelRatio();
-  QPixmap pm(placeholder_pixmap.copy());
-  pm.setDevicePixelRatio(dpr);
-  if (pm.isNull())
-    return QPixmap();
+  QImage image(placeholder_image.convertToFormat(QImage::Format_ARGB32_Premultiplied));
+  image.setDevicePixelRatio(dpr);
+  if (image.isNull())
+    return QImage();
 
-  resizeAndPadPixmap(&pm, width, height, dpr);
+  resizeAndPadImage(&image, width, height, dpr);
   QPainter painter;
-  if (painter.begin(&pm))
+  if (painter.begin(&image))
   {
     QFont font;
     font.setPointSize(std::max(static_cast<int>(32.0f * scale), 1));
@@ -92,7 +99,38 @@ static QPixmap createPlaceholderImage(const QPixmap& placeholder_pixmap, int wid
     painter.end();
   }
 
-  return pm;
+  return image;
+}
+
+static int getCoverThumbnailSize(int size)
+{
+  // Thumbnails are only generated at power of two sizes and scaled down when loaded, otherwise every step of the zoom
+  // slider would write a new set of thumbnails.
+  int thumbnail_size = MIN_COVER_THUMBNAIL_SIZE;
+  while (thumbnail_size < size)
+    thumbnail_size *= 2;
+  return thumbnail_size;
+}
+
+static bool isCoverThumbnailSize(int size)
+{
+  return (size >= MIN_COVER_THUMBNAIL_SIZE && (size & (size - 1)) == 0);
+}
+
+static std::string getCoverThumbnailPath(const std::string& thumbnail_directory, const std::string& cover_path)
+{
+  // Keyed on the modification time as well, so replacing a cover regenerates its thumbnail.
+  FILESYSTEM_STAT_DATA sd;
+  if (thumbnail_directory.empty() || !FileSystem::StatFile(cover_path.c_str(), &sd))
+    return {};
+
+  const std::string key(fmt::format("{}|{}|{}", cover_path, static_cast<s64>(sd.ModificationTime), sd.Size));
+  u8 digest[16];
+  MD5Digest md5;
+  md5.Update(key.data(), static_cast<u32>(key.size()));
+  md5.Final(digest);
+
+  return Path::Combine(thumbnail_directory, StringUtil::EncodeHex(digest, sizeof(digest)) + ".png");
 }
 
 std::optional<GameListModel::Column> GameListModel::getColumnIdForName(std::string_view name)
@@ -116,6 +154,10 @@ GameListModel::GameListModel(QObject* parent /* = nullptr */)
 {
   loadCommonImages();
   setColumnDisplayNames();
+
+  const auto lock = GameList::GetLock();
+  m_row_count = static_cast<int>(GameList::GetEntryCount());
+  m_change_counter = GameList::GetChangeCounter();
 }
 GameListModel::~GameListModel() = default;
 
@@ -128,6 +170,85 @@ void GameListModel::setCoverScale(float scale)
   m_cover_scale = scale;
   m_loading_pixmap = QPixmap(getCoverArtWidth(), getCoverArtHeight());
   m_loading_pixmap.fill(QColor(0, 0, 0, 0));
+
+  // Thumbnails are stored per size in device pixels, so each size has its own directory.
+  const float dpr = qApp->devicePixelRatio();
+  m_cover_thumbnail_width = getCoverThumbnailSize(DPRScale(getCoverArtWidth(), dpr));
+  m_cover_thumbnail_height = getCoverThumbnailSize(DPRScale(getCoverArtHeight(), dpr));
+  m_cover_thumbnail_directory = Path::Combine(
+    EmuFolders::Cache,
+    Path::Combine("covers", fmt::format("{}x{}", m_cover_thumbnail_width, m_cover_thumbnail_height)));
+  if (!FileSystem::DirectoryExists(m_cover_thumbnail_directory.c_str()) &&
+      !FileSystem::CreateDirectory(m_cover_thumbnail_directory.c_str(), true))
+  {
+    Log_ErrorPrintf("Failed to create cover thumbnail directory '%s'", m_cover_thumbnail_directory.c_str());
+    m_cover_thumbnail_directory = {};
+  }
+}
+
+void GameListModel::pruneCoverThumbnails()
+{
+  if (m_cover_thumbnail_directory.empty())
+    return;
+
+  struct CoverKey
+  {
+    std::string path;
+    std::string serial;
+    std::string title;
+  };
+  std::vector<CoverKey> keys;
+  {
+    const auto lock = GameList::GetLock();
+    const u32 count = GameList::GetEntryCount();
+    keys.reserve(count);
+    for (u32 i = 0; i < count; i++)
+    {
+      const GameList::Entry* ge = GameList::GetEntryByIndex(i);
+      keys.push_back(CoverKey{ge->path, ge->serial, ge->title});
+    }
+  }
+
+  // Thumbnail names don't depend on the size, so the same set is referenced in every size directory.
+  QtConcurrent::run([keys = std::move(keys), thumbnail_directory = m_cover_thumbnail_directory]() {
+    std::unordered_set<std::string> referenced;
+    for (const CoverKey& key : keys)
+    {
+      const std::string cover_path(GameList::GetCoverImagePath(key.path, key.serial, key.title));
+      if (!cover_path.empty())
+        referenced.emplace(Path::GetFileName(getCoverThumbnailPath(thumbnail_directory, cover_path)));
+    }
+
+    FileSystem::FindResultsArray directories;
+    const std::string covers_directory(Path::GetDirectory(thumbnail_directory));
+    FileSystem::FindFiles(covers_directory.c_str(), "*", FILESYSTEM_FIND_FOLDERS | FILESYSTEM_FIND_RELATIVE_PATHS,
+                          &directories);
+    for (const FILESYSTEM_FIND_DATA& dd : directories)
+    {
+      // Directories which aren't one of the thumbnail sizes are left over from older versions.
+      const std::string directory(Path::Combine(covers_directory, dd.FileName));
+      int width = 0, height = 0;
+      if (std::sscanf(dd.FileName.c_str(), "%dx%d", &width, &height) != 2 ||
+          !isCoverThumbnailSize(width) || !isCoverThumbnailSize(height))
+      {
+        if (!FileSystem::RecursiveDeleteDirectory(directory.c_str()))
+          Log_WarningPrintf("Failed to remove cover thumbnail directory '%s'", directory.c_str());
+        continue;
+      }
+
+      FileSystem::FindResultsArray files;
+      FileSystem::FindFiles(directory.c_str(), "*", FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_RELATIVE_PATHS, &files);
+      for (const FILESYSTEM_FIND_DATA& fd : files)
+      {
+        if (referenced.find(fd.FileName) != referenced.end())
+          continue;
+
+        const std::string path(Path::Combine(directory, fd.FileName));
+        if (!FileSystem::DeleteFile(path.c_str()))
+          Log_WarningPrintf("Failed to remove cover thumbnail '%s'", path.c_str());
+      }
+    }
+  });
 }
 
 void GameListModel::refreshCovers()
@@ -154,31 +275,50 @@ void GameListModel::reloadCommonImages()
 
 void GameListModel::loadOrGenerateCover(const GameList::Entry* ge)
 {
-  QFuture<QPixmap> future =
-    QtConcurrent::run([this, path = ge->path, title = ge->title, serial = ge->serial]() -> QPixmap {
-      QPixmap image;
+  // Images are decoded and scaled off the UI thread, QPixmap can only be created on it.
+  QFuture<QImage> future =
+    QtConcurrent::run([path = ge->path, title = ge->title, serial = ge->serial, width = getCoverArtWidth(),
+                       height = getCoverArtHeight(), scale = m_cover_scale, placeholder = m_placeholder_image,
+                       thumbnail_directory = m_cover_thumbnail_directory, thumbnail_width = m_cover_thumbnail_width,
+                       thumbnail_height = m_cover_thumbnail_height]() -> QImage {
+      QImage image;
       const std::string cover_path(GameList::GetCoverImagePath(path, serial, title));
       if (!cover_path.empty())
       {
         const float dpr = qApp->devicePixelRatio();
-        image = QPixmap(QString::fromStdString(cover_path));
-        if (!image.isNull())
+        const std::string thumbnail_path(getCoverThumbnailPath(thumbnail_directory, cover_path));
+        if (!thumbnail_path.empty() && image.load(QString::fromStdString(thumbnail_path)))
+        {
+          image.setDevicePixelRatio(dpr);
+          resizeAndPadImage(&image, width, height, dpr);
+        }
+        else if (image.load(QString::fromStdString(cover_path)))
         {
+          if (!thumbnail_path.empty())
+          {
+            resizeAndPadImage(&image, thumbnail_width, thumbnail_height, 1.0f);
+            if (!image.save(QString::fromStdString(thumbnail_path), "PNG"))
+              Log_WarningPrintf("Failed to save cover thumbnail '%s'", thumbnail_path.c_str());
+          }
+
           image.setDevicePixelRatio(dpr);
-          resizeAndPadPixmap(&image, getCoverArtWidth(), getCoverArtHeight(), dpr);
+          resizeAndPadImage(&image, width, height, dpr);
         }
       }
 
       if (image.isNull())
-        image =
-          createPlaceholderImage(m_placeholder_pixmap, getCoverArtWidth(), getCoverArtHeight(), m_cover_scale, title);
+        image = createPlaceholderImage(placeholder, width, height, scale, title);
 
       return image;
     });
 
   // Context must be 'this' so we run on the UI thread.
-  future.then(this, [this, path = ge->path](QPixmap pm) {
-    m_cover_pixmap_cache.Insert(std::move(path), std::move(pm));
+  future.then(this, [this, path = ge->path, scale = m_cover_scale](QImage image) {
+    // Drop covers which were requested before the scale changed, they've been evicted already.
+    if (m_cover_scale != scale)
+      return;
+
+    m_cover_pixmap_cache.Insert(path, QPixmap::fromImage(std::move(image)));
     invalidateCoverForPath(path);
   });
 }
@@ -227,7 +367,7 @@ int GameListModel::rowCount(const QModelIndex& parent) const
   if (parent.isValid())
     return 0;
 
-  return static_cast<int>(GameList::GetEntryCount());
+  return m_row_count;
 }
 
 int GameListModel::columnCount(const QModelIndex& parent) const
@@ -413,9 +553,68 @@ QVariant GameListModel::headerData(int section, Qt::Orientation orientation, int
 void GameListModel::refresh()
 {
   beginResetModel();
+  {
+    const auto lock = GameList::GetLock();
+    m_row_count = static_cast<int>(GameList::GetEntryCount());
+    m_change_counter = GameList::GetChangeCounter();
+  }
   endResetModel();
 }
 
+void GameListModel::applyGameListChanges()
+{
+  const auto lock = GameList::GetLock();
+  const std::optional<std::vector<GameList::Change>> changes(GameList::GetChangesSince(m_change_counter));
+  if (!changes.has_value())
+  {
+    refresh();
+    return;
+  }
+
+  m_change_counter = GameList::GetChangeCounter();
+
+  // The cover may have changed along with the serial or title.
+  for (const GameList::Change& change : changes.value())
+  {
+    if (change.type != GameList::ChangeType::Added)
+      m_cover_pixmap_cache.Remove(change.path);
+  }
+
+  // The list has already been compacted, so apply the net effect: removals first, leaving the surviving rows in their
+  // final positions, then the new rows on the end. Runs of adjacent rows are applied together, the views and sort model
+  // handle ranges much better than single rows.
+  const GameList::ChangeSummary summary(GameList::SummarizeChanges(changes.value(), static_cast<u32>(m_row_count)));
+  for (auto iter = summary.removed.rbegin(); iter != summary.removed.rend();)
+  {
+    const int last = static_cast<int>(*iter);
+    int first = last;
+    for (++iter; iter != summary.removed.rend() && static_cast<int>(*iter) == (first - 1); ++iter)
+      first--;
+
+    beginRemoveRows(QModelIndex(), first, last);
+    m_row_count -= last - first + 1;
+    endRemoveRows();
+  }
+
+  const int new_row_count = static_cast<int>(GameList::GetEntryCount());
+  if (new_row_count > m_row_count)
+  {
+    beginInsertRows(QModelIndex(), m_row_count, new_row_count - 1);
+    m_row_count = new_row_count;
+    endInsertRows();
+  }
+
+  for (auto iter = summary.updated.begin(); iter != summary.updated.end();)
+  {
+    const int first = static_cast<int>(*iter);
+    int last = first;
+    for (++iter; iter != summary.updated.end() && static_cast<int>(*iter) == (last + 1); ++iter)
+      last++;
+
+    emit dataChanged(index(first, 0), index(last, Column_Count - 1));
+  }
+}
+
 bool GameListModel::titlesLessThan(int left_row, int right_row) const
 {
   if (left_row < 0 || left_row >= static_cast<int>(GameList::GetEntryCount()) || right_row < 0 ||
@@ -559,7 +758,7 @@ void GameListModel::loadCommonImages()
   for (int i = 0; i < static_cast<int>(GameDatabase::CompatibilityRating::Count); i++)
     m_compatibility_pixmaps[i] = QtUtils::GetIconForCompatibility(static_cast<GameDatabase::CompatibilityRating>(i)).pixmap(96, 24);
 
-  m_placeholder_pixmap.load(QStringLiteral("%1/images/cover-placeholder.png").arg(QtHost::GetResourcesBasePath()));
+  m_placeholder_image.load(QStringLiteral("%1/images/cover-placeholder.png").arg(QtHost::GetResourcesBasePath()));
   setCoverScale(1.0f);
 }
 
@@ -5,6 +5,7 @@
 #include "core/types.h"
 #include "frontend-common/game_list.h"
 #include <QtCore/QAbstractTableModel>
+#include <QtGui/QImage>
 #include <QtGui/QPixmap>
 #include <algorithm>
 #include <array>
@@ -49,6 +50,9 @@ public:
 
   void refresh();
 
+  /// Applies changes made to the game list since the last refresh, without resetting the model.
+  void applyGameListChanges();
+
   bool titlesLessThan(int left_row, int right_row) const;
 
   bool lessThan(const QModelIndex& left_index, const QModelIndex& right_index, int column) const;
@@ -62,6 +66,9 @@ public:
   int getCoverArtHeight() const;
   int getCoverArtSpacing() const;
   void refreshCovers();
+
+  /// Removes cover thumbnails for covers which have been replaced, or games which are no longer in the list.
+  void pruneCoverThumbnails();
   void updateCacheSize(int width, int height);
   void reloadCommonImages();
 
@@ -71,6 +78,9 @@ private:
   void loadOrGenerateCover(const GameList::Entry* ge);
   void invalidateCoverForPath(const std::string& path);
 
+  int m_row_count = 0;
+  u32 m_change_counter = 0;
+
   float m_cover_scale = 0.0f;
   bool m_show_titles_for_covers = false;
 
@@ -79,8 +89,11 @@ private:
   std::array<QPixmap, static_cast<int>(DiscRegion::Count)> m_region_pixmaps;
   std::array<QPixmap, static_cast<int>(GameDatabase::CompatibilityRating::Count)> m_compatibility_pixmaps;
 
-  QPixmap m_placeholder_pixmap;
+  QImage m_placeholder_image;
   QPixmap m_loading_pixmap;
+  std::string m_cover_thumbnail_directory;
+  int m_cover_thumbnail_width = 0;
+  int m_cover_thumbnail_height = 0;
 
   mutable LRUCache<std::string, QPixmap> m_cover_pixmap_cache;
 };
\ No newline at end of file
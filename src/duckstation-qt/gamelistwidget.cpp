@@ -24,7 +24,8 @@ static const char* SUPPORTED_FORMATS_STRING =
                                     ".ecm (Error Code Modeling Image)\n"
                                     ".mds (Media Descriptor Sidecar)\n"
                                     ".chd (Compressed Hunks of Data)\n"
-                                    ".pbp (PlayStation Portable, Only Decrypted)");
+                                    ".pbp (PlayStation Portable, Only Decrypted)\n"
+                                    ".zip (ZIP Archive containing a Disc Image)");
 
 class GameListSortModel final : public QSortFilterProxyModel
 {
@@ -53,6 +54,8 @@ public:
     {
       const auto lock = GameList::GetLock();
       const GameList::Entry* entry = GameList::GetEntryByIndex(source_row);
+      if (!entry)
+        return false;
       if (m_filter_type != GameList::EntryType::Count && entry->type != m_filter_type)
         return false;
       if (m_filter_region != DiscRegion::Count && entry->region != m_filter_region)
@@ -235,13 +238,14 @@ void GameListWidget::onRefreshProgress(const QString& status, int current, int t
   if (m_ui.stack->currentIndex() == 2)
     m_ui.stack->setCurrentIndex(Host::GetBaseBoolSettingValue("UI", "GameListGridView", false) ? 1 : 0);
 
-  m_model->refresh();
+  m_model->applyGameListChanges();
   emit refreshProgress(status, current, total);
 }
 
 void GameListWidget::onRefreshComplete()
 {
-  m_model->refresh();
+  m_model->applyGameListChanges();
+  m_model->pruneCoverThumbnails();
   emit refreshComplete();
 
   AssertMsg(m_refresh_thread, "Has a refresh thread");
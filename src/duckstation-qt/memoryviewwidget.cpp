@@ -1,6 +1,10 @@
 #include "memoryviewwidget.h"
+#include <QtGui/QPaintEvent>
 #include <QtGui/QPainter>
 #include <QtWidgets/QScrollBar>
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
 #include <cstring>
 
 MemoryViewWidget::MemoryViewWidget(QWidget* parent /* = nullptr */, size_t address_offset /* = 0 */,
@@ -48,6 +52,7 @@ void MemoryViewWidget::updateMetrics()
 
 void MemoryViewWidget::setData(size_t address_offset, const void* data_ptr, size_t data_size)
 {
+  m_snapshot.clear();
   m_data = data_ptr;
   m_data_size = data_size;
   m_address_offset = address_offset;
@@ -93,13 +98,66 @@ void MemoryViewWidget::resizeEvent(QResizeEvent*)
   adjustContent();
 }
 
+void MemoryViewWidget::startSnapshots()
+{
+  m_use_snapshot = true;
+  viewport()->update();
+}
+
+void MemoryViewWidget::updateSnapshot(size_t offset, const void* data, size_t size)
+{
+  const unsigned char* new_data = static_cast<const unsigned char*>(data);
+  if (offset != m_snapshot_offset || size != m_snapshot.size() || (offset % m_bytes_per_line) != 0)
+  {
+    m_snapshot.assign(new_data, new_data + size);
+    m_snapshot_offset = offset;
+    viewport()->update();
+    return;
+  }
+
+  for (size_t row_start = 0; row_start < size; row_start += m_bytes_per_line)
+  {
+    const size_t row_size = std::min<size_t>(m_bytes_per_line, size - row_start);
+    if (std::memcmp(&m_snapshot[row_start], &new_data[row_start], row_size) == 0)
+      continue;
+
+    std::memcpy(&m_snapshot[row_start], &new_data[row_start], row_size);
+    viewport()->update(getRowRect(offset + row_start));
+  }
+}
+
+void MemoryViewWidget::clearSnapshot()
+{
+  m_snapshot.clear();
+  m_use_snapshot = false;
+  viewport()->update();
+}
+
+QRect MemoryViewWidget::getRowRect(size_t offset) const
+{
+  // The first row's baseline is below the header, and text can descend a little below the baseline.
+  const int row = static_cast<int>((static_cast<std::ptrdiff_t>(offset) - static_cast<std::ptrdiff_t>(m_start_offset)) /
+                                   static_cast<std::ptrdiff_t>(m_bytes_per_line));
+  return QRect(0, (row + 1) * m_char_height, viewport()->width(), m_char_height + 4);
+}
+
+const unsigned char* MemoryViewWidget::getRowData(size_t offset) const
+{
+  if (offset >= m_snapshot_offset && offset < (m_snapshot_offset + m_snapshot.size()))
+    return &m_snapshot[offset - m_snapshot_offset];
+  else if (m_use_snapshot)
+    return nullptr;
+
+  return static_cast<const unsigned char*>(m_data) + offset;
+}
+
 template<typename T>
 static bool RangesOverlap(T x1, T x2, T y1, T y2)
 {
   return (x2 >= y1 && x1 < y2);
 }
 
-void MemoryViewWidget::paintEvent(QPaintEvent*)
+void MemoryViewWidget::paintEvent(QPaintEvent* event)
 {
   QPainter painter(viewport());
   painter.setFont(font());
@@ -108,37 +166,14 @@ void MemoryViewWidget::paintEvent(QPaintEvent*)
 
   const QColor highlight_color(100, 100, 0);
   const int offsetX = horizontalScrollBar()->value();
-
-  int y = m_char_height;
-  QString address;
+  const int HEX_CHAR_WIDTH = 4 * m_char_width;
+  const int address_x = m_char_width / 2 - offsetX;
+  const int hex_x = addressWidth() - offsetX + m_char_width;
+  const int ascii_x = addressWidth() + hexWidth() + m_char_width - offsetX;
 
   painter.setPen(viewport()->palette().color(QPalette::WindowText));
 
-  y += m_char_height;
-
-  const unsigned num_rows = static_cast<unsigned>(m_end_offset - m_start_offset) / m_bytes_per_line;
-  for (unsigned row = 0; row <= num_rows; row++)
-  {
-    const size_t data_offset = m_start_offset + (row * m_bytes_per_line);
-    const unsigned row_address = static_cast<unsigned>(m_address_offset + data_offset);
-    const int draw_x = m_char_width / 2 - offsetX;
-    if (RangesOverlap(data_offset, data_offset + m_bytes_per_line, m_highlight_start, m_highlight_end))
-      painter.fillRect(0, y - m_char_height + 3, addressWidth(), m_char_height, highlight_color);
-
-    const QString address_text(QString::asprintf("%08X", row_address));
-    painter.drawText(draw_x, y, address_text);
-    y += m_char_height;
-  }
-
-  int x;
-  int lx = addressWidth();
-  painter.drawLine(lx - offsetX, 0, lx - offsetX, height());
-  y = m_char_height;
-
-  // hex data
-  const int HEX_CHAR_WIDTH = 4 * m_char_width;
-
-  x = lx - offsetX;
+  int x = addressWidth() - offsetX;
   for (unsigned col = 0; col < m_bytes_per_line; col++)
   {
     if ((col % 2) != 0)
@@ -147,67 +182,71 @@ void MemoryViewWidget::paintEvent(QPaintEvent*)
     x += HEX_CHAR_WIDTH;
   }
 
-  y = m_char_height;
-  x = lx - offsetX + m_char_width;
+  painter.drawLine(addressWidth() - offsetX, 0, addressWidth() - offsetX, height());
+  painter.drawLine(addressWidth() + hexWidth() - offsetX, 0, addressWidth() + hexWidth() - offsetX, height());
+
+  int y = m_char_height;
   for (unsigned col = 0; col < m_bytes_per_line; col++)
   {
-    painter.drawText(x, y, QString::asprintf("%02X", col));
-    x += HEX_CHAR_WIDTH;
+    const QChar ch = (col < 0xA) ? (static_cast<QChar>('0' + col)) : (static_cast<QChar>('A' + (col - 0xA)));
+    painter.drawText(hex_x + static_cast<int>(col) * HEX_CHAR_WIDTH, y, QString::asprintf("%02X", col));
+    painter.drawText(ascii_x + static_cast<int>(col) * 2 * m_char_width, y, ch);
   }
 
   painter.drawLine(0, y + 3, width(), y + 3);
   y += m_char_height;
 
-  size_t offset = m_start_offset;
-  for (unsigned row = 0; row <= num_rows; row++)
+  // Each row is drawn as a single string per column, the font is fixed width. Rows outside the update region are
+  // skipped, which when the snapshot changes, is everything but the modified rows. Rows which haven't been copied from
+  // the emulation thread yet are left empty.
+  QString hex_text;
+  QString ascii_text;
+  const unsigned num_rows = static_cast<unsigned>(m_end_offset - m_start_offset) / m_bytes_per_line;
+  for (unsigned row = 0; row <= num_rows; row++, y += m_char_height)
   {
-    x = lx - offsetX + m_char_width;
-    for (unsigned col = 0; col < m_bytes_per_line && offset < m_data_size; col++, offset++)
-    {
-      unsigned char value;
-      std::memcpy(&value, static_cast<const unsigned char*>(m_data) + offset, sizeof(value));
-      if (offset >= m_highlight_start && offset < m_highlight_end)
-        painter.fillRect(x - m_char_width, y - m_char_height + 3, HEX_CHAR_WIDTH, m_char_height, highlight_color);
-
-      painter.drawText(x, y, QString::asprintf("%02X", value));
-      x += HEX_CHAR_WIDTH;
-    }
-    y += m_char_height;
-  }
-
-  lx = addressWidth() + hexWidth();
-  painter.drawLine(lx - offsetX, 0, lx - offsetX, height());
+    const size_t data_offset = m_start_offset + (row * m_bytes_per_line);
+    if (data_offset >= m_data_size || !event->region().intersects(getRowRect(data_offset)))
+      continue;
 
-  lx += m_char_width;
+    const unsigned char* row_data = getRowData(data_offset);
+    if (!row_data)
+      continue;
 
-  y = m_char_height;
-  x = (lx - offsetX);
-  for (unsigned col = 0; col < m_bytes_per_line; col++)
-  {
-    const QChar ch = (col < 0xA) ? (static_cast<QChar>('0' + col)) : (static_cast<QChar>('A' + (col - 0xA)));
-    painter.drawText(x, y, ch);
-    x += 2 * m_char_width;
-  }
+    const unsigned row_size = static_cast<unsigned>(std::min<size_t>(m_bytes_per_line, m_data_size - data_offset));
+    const unsigned row_address = static_cast<unsigned>(m_address_offset + data_offset);
+    if (RangesOverlap(data_offset, data_offset + m_bytes_per_line, m_highlight_start, m_highlight_end))
+    {
+      painter.fillRect(0, y - m_char_height + 3, addressWidth(), m_char_height, highlight_color);
 
-  y += m_char_height;
+      for (unsigned col = 0; col < row_size; col++)
+      {
+        const size_t offset = data_offset + col;
+        if (offset < m_highlight_start || offset >= m_highlight_end)
+          continue;
+
+        painter.fillRect(hex_x + static_cast<int>(col) * HEX_CHAR_WIDTH - m_char_width, y - m_char_height + 3,
+                         HEX_CHAR_WIDTH, m_char_height, highlight_color);
+        painter.fillRect(ascii_x + static_cast<int>(col) * 2 * m_char_width, y - m_char_height + 3, 2 * m_char_width,
+                         m_char_height, highlight_color);
+      }
+    }
 
-  offset = m_start_offset;
-  for (unsigned row = 0; row <= num_rows; row++)
-  {
-    x = lx - offsetX;
-    for (unsigned col = 0; col < m_bytes_per_line && offset < m_data_size; col++, offset++)
+    hex_text.clear();
+    ascii_text.clear();
+    for (unsigned col = 0; col < row_size; col++)
     {
-      unsigned char value;
-      std::memcpy(&value, static_cast<const unsigned char*>(m_data) + offset, sizeof(value));
-      if (offset >= m_highlight_start && offset < m_highlight_end)
-        painter.fillRect(x, y - m_char_height + 3, 2 * m_char_width, m_char_height, highlight_color);
-
-      if (!std::isprint(value))
-        value = '.';
-      painter.drawText(x, y, static_cast<QChar>(value));
-      x += 2 * m_char_width;
+      static constexpr char hex_digits[] = "0123456789ABCDEF";
+      const unsigned char value = row_data[col];
+      hex_text += QChar(hex_digits[value >> 4]);
+      hex_text += QChar(hex_digits[value & 0xF]);
+      hex_text += QStringLiteral("  ");
+      ascii_text += std::isprint(value) ? static_cast<QChar>(value) : QChar('.');
+      ascii_text += QChar(' ');
     }
-    y += m_char_height;
+
+    painter.drawText(address_x, y, QString::asprintf("%08X", row_address));
+    painter.drawText(hex_x, y, hex_text);
+    painter.drawText(ascii_x, y, ascii_text);
   }
 }
 
@@ -237,4 +276,5 @@ void MemoryViewWidget::adjustContent()
   verticalScrollBar()->setPageStep(m_rows_visible);
 
   viewport()->update();
+  emit visibleRangeChanged();
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include <QtWidgets/QAbstractScrollArea>
+#include <vector>
 
 // Based on https://stackoverflow.com/questions/46375673/how-can-realize-my-own-memory-viewer-by-qt
 
@@ -21,8 +22,23 @@ public:
   void scrollToAddress(size_t address);
   void setFont(const QFont& font);
 
+  /// Returns the range of offsets currently shown, in whole rows.
+  size_t visibleStartOffset() const { return m_start_offset; }
+  size_t visibleEndOffset() const { return m_end_offset + 1; }
+
+  /// Stops reading memory directly, for when the emulation thread is running. Only rows covered by copies passed to
+  /// updateSnapshot() are drawn, until clearSnapshot() is called.
+  void startSnapshots();
+
+  /// Replaces the bytes at offset with a copy taken by the emulation thread, and repaints only the rows which changed.
+  void updateSnapshot(size_t offset, const void* data, size_t size);
+  void clearSnapshot();
+
+Q_SIGNALS:
+  void visibleRangeChanged();
+
 protected:
-  void paintEvent(QPaintEvent*);
+  void paintEvent(QPaintEvent* event);
   void resizeEvent(QResizeEvent*);
 
 private Q_SLOTS:
@@ -33,6 +49,8 @@ private:
   int hexWidth() const;
   int asciiWidth() const;
   void updateMetrics();
+  QRect getRowRect(size_t offset) const;
+  const unsigned char* getRowData(size_t offset) const;
 
   const void* m_data;
   size_t m_data_size;
@@ -50,4 +68,8 @@ private:
   int m_char_height;
 
   int m_rows_visible;
+
+  std::vector<unsigned char> m_snapshot;
+  size_t m_snapshot_offset = 0;
+  bool m_use_snapshot = false;
 };
\ No newline at end of file
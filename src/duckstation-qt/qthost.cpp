@@ -5,7 +5,9 @@
 #include "common/file_system.h"
 #include "common/log.h"
 #include "common/path.h"
+#include "common/startup_trace.h"
 #include "common/string_util.h"
+#include "core/bus.h"
 #include "core/cheats.h"
 #include "core/controller.h"
 #include "core/game_database.h"
@@ -13,6 +15,7 @@
 #include "core/host.h"
 #include "core/host_settings.h"
 #include "core/memory_card.h"
+#include "core/netplay.h"
 #include "core/spu.h"
 #include "core/system.h"
 #include "displaywidget.h"
@@ -44,6 +47,7 @@
 #include <csignal>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <memory>
 Log_SetChannel(EmuThread);
 
@@ -1351,6 +1355,48 @@ void EmuThread::singleStepCPU()
   renderDisplay();
 }
 
+void EmuThread::setMemoryWatch(int region, quint32 offset, quint32 size)
+{
+  if (!isOnThread())
+  {
+    QMetaObject::invokeMethod(this, "setMemoryWatch", Qt::QueuedConnection, Q_ARG(int, region),
+                              Q_ARG(quint32, offset), Q_ARG(quint32, size));
+    return;
+  }
+
+  // Clearing the last copy forces the new range to be sent on the next frame.
+  m_memory_watch_region = region;
+  m_memory_watch_offset = offset;
+  m_memory_watch_size = size;
+  m_memory_watch_data = QByteArray();
+}
+
+void EmuThread::updateMemoryWatch()
+{
+  if (m_memory_watch_size == 0 || !System::IsValid())
+    return;
+
+  const Bus::MemoryRegion region = static_cast<Bus::MemoryRegion>(m_memory_watch_region);
+  const u8* ptr = Bus::GetMemoryRegionPointer(region);
+  const u32 region_size = Bus::GetMemoryRegionEnd(region) - Bus::GetMemoryRegionStart(region);
+
+  // Nothing is sent for ranges which can't be read. The memory view leaves rows empty until it receives a copy, rather
+  // than reading them from the UI thread.
+  if (!ptr || (m_memory_watch_offset + m_memory_watch_size) > region_size)
+    return;
+
+  // Only a copy of the visible rows is sent, and only when it differs, so this is cheap enough to do every frame.
+  ptr += m_memory_watch_offset;
+  if (static_cast<quint32>(m_memory_watch_data.size()) == m_memory_watch_size &&
+      std::memcmp(m_memory_watch_data.constData(), ptr, m_memory_watch_size) == 0)
+  {
+    return;
+  }
+
+  m_memory_watch_data = QByteArray(reinterpret_cast<const char*>(ptr), static_cast<int>(m_memory_watch_size));
+  emit memoryWatchUpdated(m_memory_watch_region, m_memory_watch_offset, m_memory_watch_data);
+}
+
 void EmuThread::dumpRAM(const QString& filename)
 {
   if (!isOnThread())
@@ -1860,6 +1906,7 @@ void Host::SetMouseMode(bool relative, bool hide_cursor)
 
 void Host::PumpMessagesOnCPUThread()
 {
+  g_emu_thread->updateMemoryWatch();
   g_emu_thread->getEventLoop()->processEvents(QEventLoop::AllEvents);
   CommonHost::PumpMessagesOnCPUThread(); // calls InputManager::PollSources()
 }
@@ -2038,6 +2085,15 @@ void QtHost::PrintCommandLineHelp(const char* progname)
   std::fprintf(stderr, "  -settings <filename>: Loads a custom settings configuration from the\n"
                        "    specified filename. Default settings applied if file not found.\n");
   std::fprintf(stderr, "  -earlyconsole: Creates console as early as possible, for logging.\n");
+  std::fprintf(stderr, "  -tracestartup <filename>: Writes the duration of each startup phase to\n"
+                       "    filename, in Chrome trace event format.\n");
+  std::fprintf(stderr, "  -netplay <player> <local port> <remote host:port>: Starts a rollback\n"
+                       "    netplay session as player 1 or 2 after booting, exchanging input\n"
+                       "    with the specified address over UDP.\n");
+  std::fprintf(stderr, "  -netplaydelay <frames>: Delays local input by the specified number of\n"
+                       "    frames in netplay sessions (0-%u, default %u). Both players must use\n"
+                       "    the same delay.\n",
+               static_cast<u32>(Netplay::MAX_INPUT_DELAY), static_cast<u32>(Netplay::DEFAULT_INPUT_DELAY));
   std::fprintf(stderr, "  --: Signals that no more arguments will follow and the remaining\n"
                        "    parameters make up the filename. Use when the filename contains\n"
                        "    spaces or starts with a dash.\n");
@@ -2173,6 +2229,42 @@ bool QtHost::ParseCommandLineParametersAndInitializeConfig(QApplication& app,
         InitializeEarlyConsole();
         continue;
       }
+      else if (CHECK_ARG_PARAM("-tracestartup"))
+      {
+        StartupTrace::Start(args[++i].toStdString());
+        continue;
+      }
+      else if (CHECK_ARG("-netplay") && (i + 3) < args.size())
+      {
+        const u32 player = args[++i].toUInt();
+        const u32 local_port = args[++i].toUInt();
+        AutoBoot(autoboot)->netplay_remote_address = args[++i].toStdString();
+        if (player < 1 || player > 2 || local_port == 0 || local_port > 65535)
+        {
+          QMessageBox::critical(nullptr, QStringLiteral("Error"), QStringLiteral("Invalid netplay parameters."));
+          return false;
+        }
+
+        autoboot->netplay_player = player - 1;
+        autoboot->netplay_local_port = static_cast<u16>(local_port);
+        Log_InfoPrintf("Command Line: Netplay as player %u on port %u with %s.", player, local_port,
+                       autoboot->netplay_remote_address.c_str());
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-netplaydelay"))
+      {
+        bool ok;
+        const u32 input_delay = args[++i].toUInt(&ok);
+        if (!ok || input_delay > Netplay::MAX_INPUT_DELAY)
+        {
+          QMessageBox::critical(nullptr, QStringLiteral("Error"), QStringLiteral("Invalid netplay input delay."));
+          return false;
+        }
+
+        AutoBoot(autoboot)->netplay_input_delay = input_delay;
+        Log_InfoPrintf("Command Line: Netplay input delay of %u frames.", input_delay);
+        continue;
+      }
       else if (CHECK_ARG("--"))
       {
         no_more_args = true;
@@ -110,6 +110,9 @@ public:
   void updatePerformanceCounters();
   void resetPerformanceCounters();
 
+  /// Publishes the watched memory range, if it has changed. Called at the end of each frame.
+  void updateMemoryWatch();
+
   /// Locks the system by pausing it, while a popup dialog is displayed.
   /// This version is **only** for the system thread. UI thread should use the MainWindow variant.
   SystemLock pauseAndLockSystem();
@@ -140,6 +143,7 @@ Q_SIGNALS:
   void achievementsRefreshed(quint32 id, const QString& game_info_string, quint32 total, quint32 points);
   void achievementsChallengeModeChanged();
   void cheatEnabled(quint32 index, bool enabled);
+  void memoryWatchUpdated(int region, quint32 offset, const QByteArray& data);
 
 public Q_SLOTS:
   void setDefaultSettings(bool system = true, bool controller = true);
@@ -182,6 +186,7 @@ public Q_SLOTS:
   void setCheatEnabled(quint32 index, bool enabled);
   void applyCheat(quint32 index);
   void reloadPostProcessingShaders();
+  void setMemoryWatch(int region, quint32 offset, quint32 size);
 
 private Q_SLOTS:
   void stopInThread();
@@ -227,6 +232,12 @@ private:
   u32 m_last_render_width = std::numeric_limits<u32>::max();
   u32 m_last_render_height = std::numeric_limits<u32>::max();
   GPURenderer m_last_renderer = GPURenderer::Count;
+
+  // Range of memory shown by the debugger while running, and the last copy sent to it.
+  int m_memory_watch_region = -1;
+  quint32 m_memory_watch_offset = 0;
+  quint32 m_memory_watch_size = 0;
+  QByteArray m_memory_watch_data;
 };
 
 extern EmuThread* g_emu_thread;
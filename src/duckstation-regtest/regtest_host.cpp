@@ -0,0 +1,734 @@
+#include "common/assert.h"
+#include "common/file_system.h"
+#include "common/log.h"
+#include "common/memory_settings_interface.h"
+#include "common/path.h"
+#include "common/startup_trace.h"
+#include "common/string_util.h"
+#include "common/timer.h"
+#include "core/host.h"
+#include "core/host_display.h"
+#include "core/host_settings.h"
+#include "core/psf_loader.h"
+#include "core/settings.h"
+#include "core/system.h"
+#include "fmt/format.h"
+#include "frontend-common/achievements.h"
+#include "frontend-common/common_host.h"
+#include "frontend-common/game_list.h"
+#include "frontend-common/input_manager.h"
+#include "regtest_host_display.h"
+#include "scmversion/scmversion.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+Log_SetChannel(RegTestHost);
+
+#ifdef _WIN32
+#include "frontend-common/d3d11_host_display.h"
+#include "frontend-common/d3d12_host_display.h"
+#endif
+
+#ifdef WITH_OPENGL
+#include "frontend-common/opengl_host_display.h"
+#endif
+
+#ifdef WITH_VULKAN
+#include "frontend-common/vulkan_host_display.h"
+#endif
+
+namespace RegTestHost {
+static bool SetFolders();
+static void SetSettings(SettingsInterface& si);
+static void PrintCommandLineVersion();
+static void PrintCommandLineHelp(const char* progname);
+static bool ParseCommandLineArgs(int argc, char* argv[]);
+static std::string GetFrameDumpFilename(u32 frame);
+static bool RunFrames(const std::string& filename);
+static bool RenderAudio(const std::string& filename);
+} // namespace RegTestHost
+
+static MemorySettingsInterface s_base_settings_interface;
+
+static std::vector<std::string> s_boot_filenames;
+static u32 s_frames_to_run = 60 * 60;
+static u32 s_frame_dump_interval = 0;
+static std::string s_dump_base_directory;
+static std::string s_dump_game_directory;
+static GPURenderer s_renderer_to_use = GPURenderer::Software;
+static LOGLEVEL s_log_level = LOGLEVEL_VERBOSE;
+
+// Audio rendering mode, see RenderAudio().
+static std::string s_wav_directory;
+static float s_audio_seconds = 0.0f;
+static double s_total_audio_seconds = 0.0;
+static double s_total_render_seconds = 0.0;
+
+bool RegTestHost::SetFolders()
+{
+  std::string program_path(FileSystem::GetProgramPath());
+  Log_InfoPrintf("Program Path: %s", program_path.c_str());
+
+  // Everything lives alongside the executable, like a portable install.
+  EmuFolders::AppRoot = Path::Canonicalize(Path::GetDirectory(program_path));
+  EmuFolders::DataRoot = EmuFolders::AppRoot;
+  EmuFolders::Resources = Path::Combine(EmuFolders::AppRoot, "resources");
+  EmuFolders::SetDefaults();
+
+  Log_DevPrintf("AppRoot Directory: %s", EmuFolders::AppRoot.c_str());
+  Log_DevPrintf("Resources Directory: %s", EmuFolders::Resources.c_str());
+  Log_DevPrintf("BIOS Directory: %s", EmuFolders::Bios.c_str());
+
+  if (!FileSystem::DirectoryExists(EmuFolders::Resources.c_str()))
+  {
+    Log_ErrorPrintf("Resources directory '%s' is missing.", EmuFolders::Resources.c_str());
+    return false;
+  }
+
+  return true;
+}
+
+void RegTestHost::SetSettings(SettingsInterface& si)
+{
+  System::SetDefaultSettings(si);
+  CommonHost::SetDefaultSettings(si);
+  EmuFolders::Save(si);
+
+  // Set the settings we need for testing.
+  si.SetStringValue("GPU", "Renderer", Settings::GetRendererName(s_renderer_to_use));
+  si.SetStringValue("Audio", "Backend", Settings::GetAudioBackendName(AudioBackend::Null));
+  si.SetStringValue("Pad1", "Type", Settings::GetControllerTypeName(ControllerType::DigitalController));
+  si.SetStringValue("Pad2", "Type", Settings::GetControllerTypeName(ControllerType::None));
+  si.SetStringValue("MemoryCards", "Card1Type", Settings::GetMemoryCardTypeName(MemoryCardType::NonPersistent));
+  si.SetStringValue("MemoryCards", "Card2Type", Settings::GetMemoryCardTypeName(MemoryCardType::None));
+  si.SetStringValue("ControllerPorts", "MultitapMode", Settings::GetMultitapModeName(MultitapMode::Disabled));
+  si.SetStringValue("Logging", "LogLevel", Settings::GetLogLevelName(s_log_level));
+  si.SetBoolValue("Logging", "LogToConsole", true);
+  si.SetBoolValue("Main", "StartPaused", false);
+  si.SetBoolValue("Main", "SaveStateOnExit", false);
+  si.SetBoolValue("Main", "InhibitScreensaver", false);
+  si.SetBoolValue("InputSources", "SDL", false);
+}
+
+void Host::ReportErrorAsync(const std::string_view& title, const std::string_view& message)
+{
+  if (!title.empty() && !message.empty())
+  {
+    Log_ErrorPrintf("ReportErrorAsync: %.*s: %.*s", static_cast<int>(title.size()), title.data(),
+                    static_cast<int>(message.size()), message.data());
+  }
+  else if (!message.empty())
+  {
+    Log_ErrorPrintf("ReportErrorAsync: %.*s", static_cast<int>(message.size()), message.data());
+  }
+}
+
+bool Host::ConfirmMessage(const std::string_view& title, const std::string_view& message)
+{
+  if (!title.empty() && !message.empty())
+  {
+    Log_ErrorPrintf("ConfirmMessage: %.*s: %.*s", static_cast<int>(title.size()), title.data(),
+                    static_cast<int>(message.size()), message.data());
+  }
+  else if (!message.empty())
+  {
+    Log_ErrorPrintf("ConfirmMessage: %.*s", static_cast<int>(message.size()), message.data());
+  }
+
+  return true;
+}
+
+void Host::ReportDebuggerMessage(const std::string_view& message)
+{
+  Log_ErrorPrintf("ReportDebuggerMessage: %.*s", static_cast<int>(message.size()), message.data());
+}
+
+TinyString Host::TranslateString(const char* context, const char* str, const char* disambiguation /*= nullptr*/,
+                                 int n /*= -1*/)
+{
+  return str;
+}
+
+std::string Host::TranslateStdString(const char* context, const char* str, const char* disambiguation /*= nullptr*/,
+                                     int n /*= -1*/)
+{
+  return str;
+}
+
+std::optional<std::vector<u8>> Host::ReadResourceFile(const char* filename)
+{
+  const std::string path(Path::Combine(EmuFolders::Resources, filename));
+  std::optional<std::vector<u8>> ret(FileSystem::ReadBinaryFile(path.c_str()));
+  if (!ret.has_value())
+    Log_ErrorPrintf("Failed to read resource file '%s'", filename);
+  return ret;
+}
+
+std::optional<std::string> Host::ReadResourceFileToString(const char* filename)
+{
+  const std::string path(Path::Combine(EmuFolders::Resources, filename));
+  std::optional<std::string> ret(FileSystem::ReadFileToString(path.c_str()));
+  if (!ret.has_value())
+    Log_ErrorPrintf("Failed to read resource file to string '%s'", filename);
+  return ret;
+}
+
+std::optional<std::time_t> Host::GetResourceFileTimestamp(const char* filename)
+{
+  const std::string path(Path::Combine(EmuFolders::Resources, filename));
+  FILESYSTEM_STAT_DATA sd;
+  if (!FileSystem::StatFile(path.c_str(), &sd))
+  {
+    Log_ErrorPrintf("Failed to stat resource file '%s'", filename);
+    return std::nullopt;
+  }
+
+  return sd.ModificationTime;
+}
+
+void Host::LoadSettings(SettingsInterface& si, std::unique_lock<std::mutex>& lock)
+{
+  CommonHost::LoadSettings(si, lock);
+}
+
+void Host::CheckForSettingsChanges(const Settings& old_settings)
+{
+  CommonHost::CheckForSettingsChanges(old_settings);
+}
+
+void Host::SetBaseStringSettingValue(const char* section, const char* key, const char* value)
+{
+  auto lock = Host::GetSettingsLock();
+  s_base_settings_interface.SetStringValue(section, key, value);
+}
+
+void Host::DeleteBaseSettingValue(const char* section, const char* key)
+{
+  auto lock = Host::GetSettingsLock();
+  s_base_settings_interface.DeleteValue(section, key);
+}
+
+void Host::CommitBaseSettingChanges()
+{
+  // noop, in memory
+}
+
+bool Host::AcquireHostDisplay(HostDisplay::RenderAPI api)
+{
+  switch (g_settings.gpu_renderer)
+  {
+#ifdef _WIN32
+    case GPURenderer::HardwareD3D11:
+      g_host_display = std::make_unique<FrontendCommon::D3D11HostDisplay>();
+      break;
+
+    case GPURenderer::HardwareD3D12:
+      g_host_display = std::make_unique<FrontendCommon::D3D12HostDisplay>();
+      break;
+#endif
+
+#ifdef WITH_OPENGL
+    case GPURenderer::HardwareOpenGL:
+      g_host_display = std::make_unique<FrontendCommon::OpenGLHostDisplay>();
+      break;
+#endif
+
+#ifdef WITH_VULKAN
+    case GPURenderer::HardwareVulkan:
+      g_host_display = std::make_unique<FrontendCommon::VulkanHostDisplay>();
+      break;
+#endif
+
+    case GPURenderer::Software:
+    default:
+      g_host_display = std::make_unique<RegTestHostDisplay>();
+      break;
+  }
+
+  WindowInfo wi;
+  wi.type = WindowInfo::Type::Surfaceless;
+  wi.surface_width = 640;
+  wi.surface_height = 480;
+  if (!g_host_display->CreateRenderDevice(wi, std::string_view(), false, false))
+  {
+    Log_ErrorPrintf("Failed to create render device");
+    g_host_display.reset();
+    return false;
+  }
+
+  if (!g_host_display->InitializeRenderDevice(std::string_view(), false, false))
+  {
+    Log_ErrorPrintf("Failed to initialize render device");
+    g_host_display->DestroyRenderDevice();
+    g_host_display.reset();
+    return false;
+  }
+
+  return true;
+}
+
+void Host::ReleaseHostDisplay()
+{
+  if (!g_host_display)
+    return;
+
+  g_host_display->DestroyRenderDevice();
+  g_host_display.reset();
+}
+
+void Host::RenderDisplay()
+{
+  if (g_host_display)
+    g_host_display->Render();
+}
+
+void Host::InvalidateDisplay()
+{
+  //
+}
+
+void Host::RequestResizeHostDisplay(s32 width, s32 height)
+{
+  //
+}
+
+bool Host::IsFullscreen()
+{
+  return false;
+}
+
+void Host::SetFullscreen(bool enabled) {}
+
+void Host::SetMouseMode(bool relative, bool hide_cursor) {}
+
+void Host::OnSystemStarting()
+{
+  CommonHost::OnSystemStarting();
+}
+
+void Host::OnSystemStarted()
+{
+  CommonHost::OnSystemStarted();
+}
+
+void Host::OnSystemPaused()
+{
+  CommonHost::OnSystemPaused();
+}
+
+void Host::OnSystemResumed()
+{
+  CommonHost::OnSystemResumed();
+}
+
+void Host::OnSystemDestroyed()
+{
+  CommonHost::OnSystemDestroyed();
+}
+
+void Host::OnPerformanceCountersUpdated()
+{
+  //
+}
+
+void Host::OnGameChanged(const std::string& disc_path, const std::string& game_serial, const std::string& game_name)
+{
+  CommonHost::OnGameChanged(disc_path, game_serial, game_name);
+
+  Log_InfoPrintf("Disc Path: %s", disc_path.c_str());
+  Log_InfoPrintf("Game Serial: %s", game_serial.c_str());
+  Log_InfoPrintf("Game Name: %s", game_name.c_str());
+
+  if (!s_dump_base_directory.empty())
+  {
+    s_dump_game_directory = Path::Combine(s_dump_base_directory, game_name);
+    if (!FileSystem::DirectoryExists(s_dump_game_directory.c_str()))
+    {
+      Log_InfoPrintf("Creating directory '%s'...", s_dump_game_directory.c_str());
+      if (!FileSystem::CreateDirectory(s_dump_game_directory.c_str(), false))
+        Panic("Failed to create dump directory.");
+    }
+
+    Log_InfoPrintf("Dumping frames to '%s'...", s_dump_game_directory.c_str());
+  }
+}
+
+void Host::OnAchievementsRefreshed()
+{
+  //
+}
+
+void Host::OnAchievementsChallengeModeChanged()
+{
+  //
+}
+
+void Host::PumpMessagesOnCPUThread()
+{
+  CommonHost::PumpMessagesOnCPUThread();
+}
+
+void Host::RunOnCPUThread(std::function<void()> function, bool block /* = false */)
+{
+  // only one thread in this version...
+  function();
+}
+
+void Host::RequestExit(bool save_state_if_running)
+{
+  //
+}
+
+void Host::RequestSystemShutdown(bool allow_confirm, bool allow_save_state)
+{
+  //
+}
+
+void Host::RefreshGameListAsync(bool invalidate_cache)
+{
+  //
+}
+
+void Host::CancelGameListRefresh()
+{
+  //
+}
+
+void* Host::GetTopLevelWindowHandle()
+{
+  return nullptr;
+}
+
+void Host::OnInputDeviceConnected(const std::string_view& identifier, const std::string_view& device_name)
+{
+  //
+}
+
+void Host::OnInputDeviceDisconnected(const std::string_view& identifier)
+{
+  //
+}
+
+std::optional<u32> InputManager::ConvertHostKeyboardStringToCode(const std::string_view& str)
+{
+  return std::nullopt;
+}
+
+std::optional<std::string> InputManager::ConvertHostKeyboardCodeToString(u32 code)
+{
+  return std::nullopt;
+}
+
+BEGIN_HOTKEY_LIST(g_host_hotkeys)
+END_HOTKEY_LIST()
+
+void RegTestHost::PrintCommandLineVersion()
+{
+  std::fprintf(stderr, "DuckStation Regression Test Runner Version %s (%s)\n", g_scm_tag_str, g_scm_branch_str);
+  std::fprintf(stderr, "https://github.com/stenzek/duckstation\n");
+  std::fprintf(stderr, "\n");
+}
+
+void RegTestHost::PrintCommandLineHelp(const char* progname)
+{
+  PrintCommandLineVersion();
+  std::fprintf(stderr, "Usage: %s [parameters] [--] [boot filename...]\n", progname);
+  std::fprintf(stderr, "\n");
+  std::fprintf(stderr, "  -help: Displays this information and exits.\n");
+  std::fprintf(stderr, "  -version: Displays version information and exits.\n");
+  std::fprintf(stderr, "  -dumpdir: Set frame dump base directory (will be dumped to basedir/gametitle).\n");
+  std::fprintf(stderr, "  -dumpinterval: Dumps every N frames.\n");
+  std::fprintf(stderr, "  -frames: Sets the number of frames to execute.\n");
+  std::fprintf(stderr, "  -log <level>: Sets the log level. Defaults to verbose.\n");
+  std::fprintf(stderr, "  -renderer <renderer>: Sets the graphics renderer. Default to software.\n");
+  std::fprintf(stderr, "  -wavdir <dir>: Renders the audio of each boot file (e.g. PSF rips) to dir/title.wav\n"
+                       "    as fast as possible, instead of running frames.\n");
+  std::fprintf(stderr, "  -seconds <seconds>: Sets the length of audio to render. Defaults to the length\n"
+                       "    and fade tags of PSF files, otherwise the number of frames to execute.\n");
+  std::fprintf(stderr, "  -tracestartup <filename>: Writes the duration of each startup phase to\n"
+                       "    filename, in Chrome trace event format.\n");
+  std::fprintf(stderr, "  --: Signals that no more arguments will follow and the remaining\n"
+                       "    parameters make up the filename. Use when the filename contains\n"
+                       "    spaces or starts with a dash.\n");
+  std::fprintf(stderr, "\n");
+}
+
+bool RegTestHost::ParseCommandLineArgs(int argc, char* argv[])
+{
+  std::string no_more_args_filename;
+  bool no_more_args = false;
+  for (int i = 1; i < argc; i++)
+  {
+    if (!no_more_args)
+    {
+#define CHECK_ARG(str) !std::strcmp(argv[i], str)
+#define CHECK_ARG_PARAM(str) (!std::strcmp(argv[i], str) && ((i + 1) < argc))
+
+      if (CHECK_ARG("-help"))
+      {
+        PrintCommandLineHelp(argv[0]);
+        return false;
+      }
+      else if (CHECK_ARG("-version"))
+      {
+        PrintCommandLineVersion();
+        return false;
+      }
+      else if (CHECK_ARG_PARAM("-dumpdir"))
+      {
+        s_dump_base_directory = argv[++i];
+        if (s_dump_base_directory.empty())
+        {
+          Log_ErrorPrintf("Invalid dump directory specified.");
+          return false;
+        }
+
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-dumpinterval"))
+      {
+        s_frame_dump_interval = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+        if (s_frame_dump_interval == 0)
+        {
+          Log_ErrorPrintf("Invalid dump interval specified: %s", argv[i]);
+          return false;
+        }
+
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-frames"))
+      {
+        s_frames_to_run = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+        if (s_frames_to_run == 0)
+        {
+          Log_ErrorPrintf("Invalid frame count specified: %s", argv[i]);
+          return false;
+        }
+
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-log"))
+      {
+        std::optional<LOGLEVEL> level = Settings::ParseLogLevelName(argv[++i]);
+        if (!level.has_value())
+        {
+          Log_ErrorPrintf("Invalid log level specified.");
+          return false;
+        }
+
+        s_log_level = level.value();
+        Log::SetConsoleOutputParams(true, nullptr, level.value());
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-renderer"))
+      {
+        std::optional<GPURenderer> renderer = Settings::ParseRendererName(argv[++i]);
+        if (!renderer.has_value())
+        {
+          Log_ErrorPrintf("Invalid renderer specified.");
+          return false;
+        }
+
+        s_renderer_to_use = renderer.value();
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-wavdir"))
+      {
+        s_wav_directory = argv[++i];
+        if (s_wav_directory.empty())
+        {
+          Log_ErrorPrintf("Invalid WAV directory specified.");
+          return false;
+        }
+
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-seconds"))
+      {
+        s_audio_seconds = StringUtil::FromChars<float>(argv[++i]).value_or(0.0f);
+        if (s_audio_seconds <= 0.0f)
+        {
+          Log_ErrorPrintf("Invalid length specified: %s", argv[i]);
+          return false;
+        }
+
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-tracestartup"))
+      {
+        StartupTrace::Start(argv[++i]);
+        continue;
+      }
+      else if (CHECK_ARG("--"))
+      {
+        no_more_args = true;
+        continue;
+      }
+      else if (argv[i][0] == '-')
+      {
+        Log_ErrorPrintf("Unknown parameter: '%s'", argv[i]);
+        return false;
+      }
+
+#undef CHECK_ARG
+#undef CHECK_ARG_PARAM
+
+      s_boot_filenames.emplace_back(argv[i]);
+      continue;
+    }
+
+    if (!no_more_args_filename.empty())
+      no_more_args_filename += ' ';
+    no_more_args_filename += argv[i];
+  }
+
+  if (!no_more_args_filename.empty())
+    s_boot_filenames.push_back(std::move(no_more_args_filename));
+
+  return true;
+}
+
+std::string RegTestHost::GetFrameDumpFilename(u32 frame)
+{
+  return Path::Combine(s_dump_game_directory, fmt::format("frame_{:05d}.png", frame));
+}
+
+bool RegTestHost::RunFrames(const std::string& filename)
+{
+  Log_InfoPrintf("Trying to boot '%s'...", filename.c_str());
+  if (!System::BootSystem(SystemBootParameters(filename)))
+  {
+    Log_ErrorPrintf("Failed to boot system.");
+    return false;
+  }
+
+  if (s_frame_dump_interval > 0)
+  {
+    if (s_dump_base_directory.empty())
+    {
+      Log_ErrorPrint("Dump directory not specified.");
+      System::ShutdownSystem(false);
+      return false;
+    }
+
+    Log_InfoPrintf("Dumping every %uth frame to '%s'.", s_frame_dump_interval, s_dump_base_directory.c_str());
+  }
+
+  Log_InfoPrintf("Running for %u frames...", s_frames_to_run);
+
+  for (u32 frame = 1; frame <= s_frames_to_run; frame++)
+  {
+    System::RunFrame();
+    Host::PumpMessagesOnCPUThread();
+
+    if (s_frame_dump_interval > 0 && (s_frame_dump_interval == 1 || (frame % s_frame_dump_interval) == 0))
+      g_host_display->WriteDisplayTextureToFile(GetFrameDumpFilename(frame));
+
+    Host::RenderDisplay();
+
+    System::UpdatePerformanceCounters();
+  }
+
+  Log_InfoPrintf("All done, shutting down system.");
+  System::ShutdownSystem(false);
+  return true;
+}
+
+bool RegTestHost::RenderAudio(const std::string& filename)
+{
+  // PSF rips carry their play time in tags, the fade is rendered but not applied.
+  float seconds = s_audio_seconds;
+  if (seconds <= 0.0f && System::IsPsfFileName(filename))
+  {
+    PSFLoader::File psf;
+    if (psf.Load(filename.c_str()))
+      seconds = psf.GetTagTime("length").value_or(0.0f) + psf.GetTagTime("fade").value_or(0.0f);
+  }
+
+  const std::string wav_filename(
+    Path::Combine(s_wav_directory, Path::ReplaceExtension(Path::GetFileName(filename), "wav")));
+
+  Log_InfoPrintf("Trying to boot '%s'...", filename.c_str());
+  if (!System::BootSystem(SystemBootParameters(filename)))
+  {
+    Log_ErrorPrintf("Failed to boot system.");
+    return false;
+  }
+
+  // Frame count depends on the region, so it can only be determined after booting.
+  const u32 frames_to_run = (seconds > 0.0f) ? static_cast<u32>(std::ceil(seconds * System::GetThrottleFrequency())) :
+                                               s_frames_to_run;
+  if (!System::StartDumpingAudio(wav_filename.c_str()))
+  {
+    System::ShutdownSystem(false);
+    return false;
+  }
+
+  Log_InfoPrintf("Rendering %u frames of audio to '%s'...", frames_to_run, wav_filename.c_str());
+
+  Common::Timer timer;
+  for (u32 frame = 0; frame < frames_to_run; frame++)
+  {
+    System::RunFrame();
+    Host::PumpMessagesOnCPUThread();
+  }
+
+  const double render_seconds = timer.GetTimeSeconds();
+  const double audio_seconds = static_cast<double>(frames_to_run) / System::GetThrottleFrequency();
+  s_total_render_seconds += render_seconds;
+  s_total_audio_seconds += audio_seconds;
+  Log_InfoPrintf("Rendered %.2f seconds of audio in %.2f seconds (%.1fx realtime).", audio_seconds, render_seconds,
+                 audio_seconds / render_seconds);
+
+  System::StopDumpingAudio();
+  System::ShutdownSystem(false);
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  Log::SetConsoleOutputParams(true, nullptr, LOGLEVEL_VERBOSE);
+
+  if (!RegTestHost::ParseCommandLineArgs(argc, argv))
+    return EXIT_FAILURE;
+
+  if (s_boot_filenames.empty())
+  {
+    Log_ErrorPrintf("No boot path specified.");
+    return EXIT_FAILURE;
+  }
+
+  if (!s_wav_directory.empty() && !FileSystem::DirectoryExists(s_wav_directory.c_str()) &&
+      !FileSystem::CreateDirectory(s_wav_directory.c_str(), false))
+  {
+    Log_ErrorPrintf("Failed to create WAV directory '%s'.", s_wav_directory.c_str());
+    return EXIT_FAILURE;
+  }
+
+  Log_InfoPrintf("Initializing...");
+  if (!RegTestHost::SetFolders())
+    return EXIT_FAILURE;
+
+  RegTestHost::SetSettings(s_base_settings_interface);
+  Host::Internal::SetBaseSettingsLayer(&s_base_settings_interface);
+  CommonHost::Initialize();
+
+  int result = EXIT_SUCCESS;
+  for (const std::string& filename : s_boot_filenames)
+  {
+    const bool ok = s_wav_directory.empty() ? RegTestHost::RunFrames(filename) : RegTestHost::RenderAudio(filename);
+    if (!ok)
+      result = EXIT_FAILURE;
+  }
+
+  if (!s_wav_directory.empty() && s_total_render_seconds > 0.0)
+  {
+    Log_InfoPrintf("Rendered %.2f seconds of audio in %.2f seconds in total (%.1fx realtime).", s_total_audio_seconds,
+                   s_total_render_seconds, s_total_audio_seconds / s_total_render_seconds);
+  }
+
+  CommonHost::Shutdown();
+  Log_InfoPrintf("Exiting with %s.", (result == EXIT_SUCCESS) ? "success" : "failure");
+  return result;
+}
@@ -199,7 +199,7 @@ void RegTestHostDisplay::DumpFrame(const std::string& filename)
   while (pixels != pixels_end)
     *(pixels++) |= 0xFF000000u;
 
-  if (!Common::WriteImageToFile(image, filename.c_str()))
+  if (!image.SaveToFile(filename.c_str()))
     Log_ErrorPrintf("Failed to dump frame '%s'", filename.c_str());
 }
 
@@ -6,6 +6,7 @@
 #include "common/md5_digest.h"
 #include "common/path.h"
 #include "common/platform.h"
+#include "common/startup_trace.h"
 #include "common/string_util.h"
 #include "core/bios.h"
 #include "core/bus.h"
@@ -400,6 +401,7 @@ void Achievements::Initialize()
   if (IsUsingRAIntegration())
     return;
 
+  StartupTrace::Phase trace_phase("Initialize achievements");
   std::unique_lock lock(s_achievements_mutex);
   AssertMsg(g_settings.achievements_enabled, "Achievements are enabled");
 
@@ -1276,6 +1278,7 @@ void Achievements::GameChanged(const std::string& path, CDImage* image)
   if (!IsActive() || s_game_path == path)
     return;
 
+  StartupTrace::Phase trace_phase("Identify achievements game");
   std::unique_ptr<CDImage> temp_image;
   if (!path.empty() && (!image || (g_settings.achievements_use_first_disc_from_playlist && image->HasSubImages() &&
                                    image->GetCurrentSubImage() != 0)))
@@ -6,12 +6,14 @@
 #include "common/file_system.h"
 #include "common/log.h"
 #include "common/path.h"
+#include "common/startup_trace.h"
 #include "common/string_util.h"
 #include "core/cdrom.h"
 #include "core/cheats.h"
 #include "core/controller.h"
 #include "core/cpu_code_cache.h"
 #include "core/dma.h"
+#include "core/game_database.h"
 #include "core/gpu.h"
 #include "core/gte.h"
 #include "core/host.h"
@@ -60,6 +62,8 @@
 Log_SetChannel(CommonHostInterface);
 
 namespace CommonHost {
+static void RunDeferredInitialization();
+
 #ifdef WITH_DISCORD_PRESENCE
 static void SetDiscordPresenceEnabled(bool enabled);
 static void InitializeDiscordPresence();
@@ -69,6 +73,9 @@ static void PollDiscordPresence();
 #endif
 } // namespace CommonHost
 
+// Work which isn't needed to get the first frame on screen, see RunDeferredInitialization().
+static bool s_deferred_initialization_pending = false;
+
 #ifdef WITH_DISCORD_PRESENCE
 // discord rich presence
 bool m_discord_presence_enabled = false;
@@ -80,6 +87,12 @@ std::string m_discord_presence_cheevos_string;
 
 void CommonHost::Initialize()
 {
+  StartupTrace::Phase trace_phase("Initialize host");
+  s_deferred_initialization_pending = true;
+
+  // The database is only needed once a game is identified, so it can load while everything else starts up.
+  GameDatabase::LoadAsync();
+
   // This will call back to Host::LoadSettings() -> ReloadSources().
   System::LoadSettings(false);
   UpdateLogSettings();
@@ -89,13 +102,32 @@ void CommonHost::Initialize()
   if (Host::GetBaseBoolSettingValue("Cheevos", "UseRAIntegration", false))
     Achievements::SwitchToRAIntegration();
 #endif
-  if (g_settings.achievements_enabled)
+  // Hardcore mode has to be known before the game boots, so it can't wait.
+  if (g_settings.achievements_enabled && g_settings.achievements_challenge_mode)
     Achievements::Initialize();
 #endif
 }
 
+void CommonHost::RunDeferredInitialization()
+{
+  StartupTrace::Phase trace_phase("Deferred initialization");
+  s_deferred_initialization_pending = false;
+
+#ifdef WITH_CHEEVOS
+  if (g_settings.achievements_enabled && !Achievements::IsActive())
+    Achievements::Initialize();
+#endif
+
+#ifdef WITH_DISCORD_PRESENCE
+  if (m_discord_presence_enabled)
+    InitializeDiscordPresence();
+#endif
+}
+
 void CommonHost::Shutdown()
 {
+  StartupTrace::Finish();
+
 #ifdef WITH_DISCORD_PRESENCE
   CommonHost::ShutdownDiscordPresence();
 #endif
@@ -109,6 +141,17 @@ void CommonHost::Shutdown()
 
 void CommonHost::PumpMessagesOnCPUThread()
 {
+  // Wait until the first frame has been emulated when booting, otherwise run it as soon as we're idle.
+  if (s_deferred_initialization_pending && (System::IsShutdown() || System::GetFrameNumber() > 1))
+  {
+    RunDeferredInitialization();
+  }
+  else if (StartupTrace::IsActive() && !s_deferred_initialization_pending && System::IsValid() &&
+           System::GetFrameNumber() > 1)
+  {
+    StartupTrace::Finish();
+  }
+
   InputManager::PollSources();
 
 #ifdef WITH_DISCORD_PRESENCE
@@ -421,7 +464,7 @@ void CommonHost::SetDiscordPresenceEnabled(bool enabled)
     return;
 
   m_discord_presence_enabled = enabled;
-  if (enabled)
+  if (enabled && !s_deferred_initialization_pending)
     InitializeDiscordPresence();
   else
     ShutdownDiscordPresence();
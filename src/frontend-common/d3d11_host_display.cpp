@@ -1017,6 +1017,8 @@ bool D3D11HostDisplay::SetPostProcessingChain(const std::string_view& config)
   if (!m_post_processing_chain.CreateFromString(config))
     return false;
 
+  m_post_processing_chain.FuseStages();
+
   m_post_processing_stages.clear();
 
   D3D11::ShaderCache shader_cache;
@@ -371,7 +371,8 @@ static std::string GetNotificationImageForGame(const std::string& game_path);
 
 // Lazily populated cover images.
 static std::unordered_map<std::string, std::string> s_cover_image_map;
-static std::vector<const GameList::Entry*> s_game_list_sorted_entries;
+static std::vector<u32> s_game_list_sorted_entries;
+static std::optional<u32> s_game_list_change_counter;
 
 #ifdef WITH_CHEEVOS
 //////////////////////////////////////////////////////////////////////////
@@ -550,6 +551,7 @@ void FullscreenUI::Shutdown()
   CloseSaveStateSelector();
   s_cover_image_map.clear();
   s_game_list_sorted_entries = {};
+  s_game_list_change_counter.reset();
   s_game_list_directories_cache = {};
   s_fullscreen_mode_list_cache = {};
   s_graphics_adapter_list_cache = {};
@@ -668,7 +670,7 @@ void FullscreenUI::DestroyResources()
 ImGuiFullscreen::FileSelectorFilters FullscreenUI::GetDiscImageFilters()
 {
   return {"*.bin",   "*.cue",    "*.iso", "*.img", "*.chd",     "*.ecm", "*.mds",
-          "*.psexe", "*.ps-exe", "*.exe", "*.psf", "*.minipsf", "*.m3u", "*.pbp"};
+          "*.psexe", "*.ps-exe", "*.exe", "*.psf", "*.minipsf", "*.m3u", "*.pbp", "*.zip"};
 }
 
 void FullscreenUI::DoStartPath(std::string path, std::string state, std::optional<bool> fast_boot)
@@ -2501,6 +2503,10 @@ void FullscreenUI::DrawEmulationSettingsPage()
   DrawIntRangeSetting("Rewind Save Slots",
                       "How many saves will be kept for rewinding. Higher values have greater memory requirements.",
                       "Main", "RewindSaveSlots", 10, 1, 10000, "%d Frames");
+  DrawToggleSetting("Store Rewind VRAM At Native Resolution",
+                    "Keeps rewind VRAM unscaled in system memory instead of GPU memory. Reduces GPU memory usage at "
+                    "high resolutions, but upscaled detail is lost on rewind.",
+                    "Main", "RewindNativeVRAM", false);
 
   const s32 runahead_frames =
     IsEditingGameSettings() ?
@@ -2537,12 +2543,16 @@ void FullscreenUI::DrawEmulationSettingsPage()
       IsEditingGameSettings() ?
         GetEditingSettingsInterface()->GetIntValue("Main", "RunaheadFrameCount", g_settings.rewind_save_slots) :
         g_settings.rewind_save_slots;
+    const bool rewind_native_vram =
+      IsEditingGameSettings() ?
+        GetEditingSettingsInterface()->GetBoolValue("Main", "RewindNativeVRAM", g_settings.rewind_native_vram) :
+        g_settings.rewind_native_vram;
     const float duration =
       ((rewind_frequency <= std::numeric_limits<float>::epsilon()) ? (1.0f / 60.0f) : rewind_frequency) *
       static_cast<float>(rewind_save_slots);
 
     u64 ram_usage, vram_usage;
-    System::CalculateRewindMemoryUsage(rewind_save_slots, &ram_usage, &vram_usage);
+    System::CalculateRewindMemoryUsage(rewind_save_slots, rewind_native_vram, &ram_usage, &vram_usage);
     rewind_summary.Format("Rewind for %u frames, lasting %.2f seconds will require up to %" PRIu64
                           "MB of RAM and %" PRIu64 "MB of VRAM.",
                           rewind_save_slots, duration, ram_usage / 1048576, vram_usage / 1048576);
@@ -2953,6 +2963,9 @@ void FullscreenUI::DrawDisplaySettingsPage()
       DrawToggleSetting("Threaded Presentation",
                         "Presents frames on a background thread when fast forwarding or vsync is disabled.", "GPU",
                         "ThreadedPresentation", true);
+      DrawToggleSetting("Drop Late Frames",
+                        "Skips displaying a frame instead of waiting for the previous frame to be presented.",
+                        "Display", "DropLateFrames", false);
     }
     break;
 #endif
@@ -3363,6 +3376,11 @@ void FullscreenUI::DrawAdvancedSettingsPage()
                     "Enable debugging when supported by the host's renderer API. Only for developer use.", "GPU",
                     "UseDebugDevice", false);
 
+  DrawIntRangeSetting("Vulkan Frames In Flight",
+                      "Number of frames the CPU can queue ahead of the GPU. Higher values can improve throughput, at "
+                      "the cost of latency.",
+                      "GPU", "VulkanFramesInFlight", Settings::DEFAULT_GPU_VULKAN_FRAMES_IN_FLIGHT, 2, 4, "%d Frames");
+
 #ifdef _WIN32
   DrawToggleSetting("Increase Timer Resolution", "Enables more precise frame pacing at the cost of battery life.",
                     "Main", "IncreaseTimerResolution", true);
@@ -3977,14 +3995,69 @@ void FullscreenUI::DoSaveState(s32 slot, bool global)
 
 void FullscreenUI::PopulateGameListEntryList()
 {
-  const u32 count = GameList::GetEntryCount();
-  s_game_list_sorted_entries.resize(count);
-  for (u32 i = 0; i < count; i++)
-    s_game_list_sorted_entries[i] = GameList::GetEntryByIndex(i);
+  const u32 change_counter = GameList::GetChangeCounter();
+  if (s_game_list_change_counter == change_counter)
+    return;
+
+  std::optional<std::vector<GameList::Change>> changes;
+  if (s_game_list_change_counter.has_value())
+    changes = GameList::GetChangesSince(s_game_list_change_counter.value());
+  s_game_list_change_counter = change_counter;
 
   // TODO: Custom sort types
-  std::sort(s_game_list_sorted_entries.begin(), s_game_list_sorted_entries.end(),
-            [](const GameList::Entry* lhs, const GameList::Entry* rhs) { return lhs->title < rhs->title; });
+  const auto title_less = [](u32 lhs, u32 rhs) {
+    return GameList::GetEntryByIndex(lhs)->title < GameList::GetEntryByIndex(rhs)->title;
+  };
+
+  if (!changes.has_value())
+  {
+    const u32 count = GameList::GetEntryCount();
+    s_game_list_sorted_entries.resize(count);
+    for (u32 i = 0; i < count; i++)
+      s_game_list_sorted_entries[i] = i;
+
+    std::sort(s_game_list_sorted_entries.begin(), s_game_list_sorted_entries.end(), title_less);
+    return;
+  }
+
+  // Removed entries are dropped, and the indices of those after them shifted down, which doesn't change the order.
+  const GameList::ChangeSummary summary(
+    GameList::SummarizeChanges(changes.value(), static_cast<u32>(s_game_list_sorted_entries.size())));
+  if (!summary.removed.empty())
+  {
+    s_game_list_sorted_entries.erase(std::remove_if(s_game_list_sorted_entries.begin(),
+                                                    s_game_list_sorted_entries.end(),
+                                                    [&summary](u32 index) {
+                                                      return std::binary_search(summary.removed.begin(),
+                                                                                summary.removed.end(), index);
+                                                    }),
+                                     s_game_list_sorted_entries.end());
+    for (u32& index : s_game_list_sorted_entries)
+    {
+      index -= static_cast<u32>(std::lower_bound(summary.removed.begin(), summary.removed.end(), index) -
+                                summary.removed.begin());
+    }
+  }
+
+  // Added and updated entries are merged in.
+  std::vector<u32> changed_indices(summary.updated);
+  for (u32 i = summary.first_added; i < GameList::GetEntryCount(); i++)
+    changed_indices.push_back(i);
+
+  // Updated entries may have been renamed, so take them out before merging.
+  s_game_list_sorted_entries.erase(std::remove_if(s_game_list_sorted_entries.begin(),
+                                                  s_game_list_sorted_entries.end(),
+                                                  [&changed_indices](u32 index) {
+                                                    return std::binary_search(changed_indices.begin(),
+                                                                              changed_indices.end(), index);
+                                                  }),
+                                   s_game_list_sorted_entries.end());
+
+  std::sort(changed_indices.begin(), changed_indices.end(), title_less);
+  const size_t unchanged_count = s_game_list_sorted_entries.size();
+  s_game_list_sorted_entries.insert(s_game_list_sorted_entries.end(), changed_indices.begin(), changed_indices.end());
+  std::inplace_merge(s_game_list_sorted_entries.begin(), s_game_list_sorted_entries.begin() + unchanged_count,
+                     s_game_list_sorted_entries.end(), title_less);
 }
 
 void FullscreenUI::DrawGameListWindow()
@@ -4010,8 +4083,9 @@ void FullscreenUI::DrawGameListWindow()
     // TODO: replace with something not heap alllocating
     SmallString summary;
 
-    for (const GameList::Entry* entry : s_game_list_sorted_entries)
+    for (const u32 entry_index : s_game_list_sorted_entries)
     {
+      const GameList::Entry* entry = GameList::GetEntryByIndex(entry_index);
       ImRect bb;
       bool visible, hovered;
       bool pressed =
@@ -2,6 +2,7 @@
 #include "common/assert.h"
 #include "common/byte_stream.h"
 #include "common/file_system.h"
+#include "common/heterogeneous_containers.h"
 #include "common/log.h"
 #include "common/make_array.h"
 #include "common/path.h"
@@ -38,10 +39,12 @@ static bool GetPsfListEntry(const std::string& path, Entry* entry);
 static bool GetDiscListEntry(const std::string& path, Entry* entry);
 
 static bool GetGameListEntryFromCache(const std::string& path, Entry* entry);
-static void ScanDirectory(const char* path, bool recursive, bool only_cache,
+static void ScanDirectory(const char* path, bool recursive, bool only_cache, bool invalidate_cache,
                           const std::vector<std::string>& excluded_paths, ProgressCallback* progress);
 static bool AddFileFromCache(const std::string& path, std::time_t timestamp);
 static bool ScanFile(std::string path, std::time_t timestamp);
+static void AddOrUpdateEntry(Entry entry);
+static void RemoveUnseenEntries();
 
 static std::string GetCacheFilename();
 static void LoadCache();
@@ -53,7 +56,16 @@ static void DeleteCacheFile();
 } // namespace GameList
 
 static std::vector<GameList::Entry> m_entries;
+static UnorderedStringMap<u32> s_entry_indices;
 static std::recursive_mutex s_mutex;
+
+// Entries found by the current refresh. Anything not found by the end of it is removed.
+static std::vector<bool> s_entry_seen;
+
+// Changes made by the current refresh, so views can be updated incrementally instead of being rebuilt.
+static std::vector<GameList::Change> s_changes;
+static u32 s_change_counter = 0;
+static u32 s_changes_start_counter = 0;
 static GameList::CacheMap m_cache_map;
 static std::unique_ptr<ByteStream> m_cache_write_stream;
 
@@ -421,18 +433,20 @@ static bool IsPathExcluded(const std::vector<std::string>& excluded_paths, const
   return (std::find(excluded_paths.begin(), excluded_paths.end(), path) != excluded_paths.end());
 }
 
-void GameList::ScanDirectory(const char* path, bool recursive, bool only_cache,
+void GameList::ScanDirectory(const char* path, bool recursive, bool only_cache, bool invalidate_cache,
                              const std::vector<std::string>& excluded_paths, ProgressCallback* progress)
 {
   Log_InfoPrintf("Scanning %s%s", path, recursive ? " (recursively)" : "");
 
   progress->SetFormattedStatusText("Scanning directory '%s'%s...", path, recursive ? " (recursively)" : "");
 
-  FileSystem::FindResultsArray files;
-  FileSystem::FindFiles(path, "*",
-                        recursive ? (FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_HIDDEN_FILES | FILESYSTEM_FIND_RECURSIVE) :
-                                    (FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_HIDDEN_FILES),
-                        &files);
+  // only the timestamp is needed to check against the cache, and only for files which could be games
+  FileSystem::FindTimestampsArray files;
+  FileSystem::FindFileTimestamps(path, "*",
+                                 recursive ? (FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_HIDDEN_FILES |
+                                              FILESYSTEM_FIND_RECURSIVE | FILESYSTEM_FIND_PARALLEL) :
+                                             (FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_HIDDEN_FILES),
+                                 &files, &GameList::IsScannableFilename);
   if (files.empty())
     return;
 
@@ -441,22 +455,30 @@ void GameList::ScanDirectory(const char* path, bool recursive, bool only_cache,
   progress->SetProgressValue(0);
 
   u32 files_scanned = 0;
-  for (FILESYSTEM_FIND_DATA& ffd : files)
+  for (FILESYSTEM_FIND_TIMESTAMP_DATA& ffd : files)
   {
     files_scanned++;
 
-    if (progress->IsCancelled() || !GameList::IsScannableFilename(ffd.FileName) ||
-        IsPathExcluded(excluded_paths, ffd.FileName))
+    if (progress->IsCancelled() || IsPathExcluded(excluded_paths, ffd.FileName))
     {
       continue;
     }
 
     {
       std::unique_lock lock(s_mutex);
-      if (GetEntryForPath(ffd.FileName.c_str()) || AddFileFromCache(ffd.FileName, ffd.ModificationTime) || only_cache)
+
+      // Already found in another directory, or unchanged since the last refresh.
+      const auto iter = UnorderedStringMapFind(s_entry_indices, ffd.FileName);
+      if (iter != s_entry_indices.end() &&
+          (s_entry_seen[iter->second] ||
+           (!invalidate_cache && m_entries[iter->second].last_modified_time == ffd.ModificationTime)))
       {
+        s_entry_seen[iter->second] = true;
         continue;
       }
+
+      if (AddFileFromCache(ffd.FileName, ffd.ModificationTime) || only_cache)
+        continue;
     }
 
     // ownership of fp is transferred
@@ -471,17 +493,11 @@ void GameList::ScanDirectory(const char* path, bool recursive, bool only_cache,
 
 bool GameList::AddFileFromCache(const std::string& path, std::time_t timestamp)
 {
-  if (std::any_of(m_entries.begin(), m_entries.end(), [&path](const Entry& other) { return other.path == path; }))
-  {
-    // already exists
-    return true;
-  }
-
   Entry entry;
   if (!GetGameListEntryFromCache(path, &entry) || entry.last_modified_time != timestamp)
     return false;
 
-  m_entries.push_back(std::move(entry));
+  AddOrUpdateEntry(std::move(entry));
   return true;
 }
 
@@ -503,10 +519,67 @@ bool GameList::ScanFile(std::string path, std::time_t timestamp)
   }
 
   std::unique_lock lock(s_mutex);
-  m_entries.push_back(std::move(entry));
+  AddOrUpdateEntry(std::move(entry));
   return true;
 }
 
+void GameList::AddOrUpdateEntry(Entry entry)
+{
+  const auto iter = UnorderedStringMapFind(s_entry_indices, entry.path);
+  if (iter != s_entry_indices.end())
+  {
+    // Replaced in place, so the entry keeps its position in the list.
+    const u32 index = iter->second;
+    m_entries[index] = std::move(entry);
+    s_entry_seen[index] = true;
+    s_changes.push_back(Change{ChangeType::Updated, index, m_entries[index].path});
+    s_change_counter++;
+    return;
+  }
+
+  const u32 index = static_cast<u32>(m_entries.size());
+  s_entry_indices.emplace(entry.path, index);
+  m_entries.push_back(std::move(entry));
+  s_entry_seen.push_back(true);
+  s_changes.push_back(Change{ChangeType::Added, index, m_entries[index].path});
+  s_change_counter++;
+}
+
+void GameList::RemoveUnseenEntries()
+{
+  std::unique_lock lock(s_mutex);
+
+  // Highest index first, so that each removal applies to the list as it is after the previous one.
+  const u32 count = static_cast<u32>(m_entries.size());
+  for (u32 i = count; i > 0; i--)
+  {
+    if (!s_entry_seen[i - 1])
+    {
+      s_changes.push_back(Change{ChangeType::Removed, i - 1, m_entries[i - 1].path});
+      s_change_counter++;
+    }
+  }
+
+  u32 new_count = 0;
+  for (u32 i = 0; i < count; i++)
+  {
+    if (!s_entry_seen[i])
+      continue;
+
+    if (new_count != i)
+      m_entries[new_count] = std::move(m_entries[i]);
+    new_count++;
+  }
+  if (new_count == count)
+    return;
+
+  m_entries.erase(m_entries.begin() + new_count, m_entries.end());
+  s_entry_seen.assign(new_count, true);
+  s_entry_indices.clear();
+  for (u32 i = 0; i < new_count; i++)
+    s_entry_indices.emplace(m_entries[i].path, i);
+}
+
 std::unique_lock<std::recursive_mutex> GameList::GetLock()
 {
   return std::unique_lock<std::recursive_mutex>(s_mutex);
@@ -548,6 +621,73 @@ u32 GameList::GetEntryCount()
   return static_cast<u32>(m_entries.size());
 }
 
+u32 GameList::GetChangeCounter()
+{
+  std::unique_lock lock(s_mutex);
+  return s_change_counter;
+}
+
+std::optional<std::vector<GameList::Change>> GameList::GetChangesSince(u32 counter)
+{
+  std::unique_lock lock(s_mutex);
+  if (counter < s_changes_start_counter || counter > s_change_counter)
+    return std::nullopt;
+
+  return std::vector<Change>(s_changes.begin() + (counter - s_changes_start_counter), s_changes.end());
+}
+
+GameList::ChangeSummary GameList::SummarizeChanges(const std::vector<Change>& changes, u32 old_count)
+{
+  // Replay the changes on the old indices, with UINT32_MAX standing in for new entries.
+  std::vector<u32> old_indices(old_count);
+  for (u32 i = 0; i < old_count; i++)
+    old_indices[i] = i;
+
+  std::vector<bool> old_removed(old_count);
+  std::vector<bool> old_updated(old_count);
+  for (const Change& change : changes)
+  {
+    switch (change.type)
+    {
+      case ChangeType::Added:
+        old_indices.insert(old_indices.begin() + std::min<size_t>(change.index, old_indices.size()), UINT32_MAX);
+        break;
+
+      case ChangeType::Updated:
+        if (change.index < old_indices.size() && old_indices[change.index] != UINT32_MAX)
+          old_updated[old_indices[change.index]] = true;
+        break;
+
+      case ChangeType::Removed:
+        if (change.index < old_indices.size())
+        {
+          if (old_indices[change.index] != UINT32_MAX)
+            old_removed[old_indices[change.index]] = true;
+          old_indices.erase(old_indices.begin() + change.index);
+        }
+        break;
+    }
+  }
+
+  ChangeSummary summary;
+  u32 new_index = 0;
+  for (u32 i = 0; i < old_count; i++)
+  {
+    if (old_removed[i])
+    {
+      summary.removed.push_back(i);
+      continue;
+    }
+
+    if (old_updated[i])
+      summary.updated.push_back(new_index);
+    new_index++;
+  }
+
+  summary.first_added = new_index;
+  return summary;
+}
+
 void GameList::Refresh(bool invalidate_cache, bool only_cache, ProgressCallback* progress /* = nullptr */)
 {
   m_game_list_loaded = true;
@@ -560,11 +700,12 @@ void GameList::Refresh(bool invalidate_cache, bool only_cache, ProgressCallback*
   else
     LoadCache();
 
-  // don't delete the old entries, since the frontend might still access them
-  std::vector<Entry> old_entries;
+  // Existing entries are kept, so that views don't have to be rebuilt. Only what changed is recorded.
   {
     std::unique_lock lock(s_mutex);
-    old_entries.swap(m_entries);
+    s_entry_seen.assign(m_entries.size(), false);
+    s_changes.clear();
+    s_changes_start_counter = s_change_counter;
   }
 
   const std::vector<std::string> excluded_paths(Host::GetStringListSetting("GameList", "ExcludedPaths"));
@@ -583,7 +724,7 @@ void GameList::Refresh(bool invalidate_cache, bool only_cache, ProgressCallback*
       if (progress->IsCancelled())
         break;
 
-      ScanDirectory(dir.c_str(), false, only_cache, excluded_paths, progress);
+      ScanDirectory(dir.c_str(), false, only_cache, invalidate_cache, excluded_paths, progress);
       progress->SetProgressValue(++directory_counter);
     }
     for (const std::string& dir : recursive_dirs)
@@ -591,7 +732,7 @@ void GameList::Refresh(bool invalidate_cache, bool only_cache, ProgressCallback*
       if (progress->IsCancelled())
         break;
 
-      ScanDirectory(dir.c_str(), true, only_cache, excluded_paths, progress);
+      ScanDirectory(dir.c_str(), true, only_cache, invalidate_cache, excluded_paths, progress);
       progress->SetProgressValue(++directory_counter);
     }
   }
@@ -599,6 +740,10 @@ void GameList::Refresh(bool invalidate_cache, bool only_cache, ProgressCallback*
   // don't need unused cache entries
   CloseCacheFileStream();
   m_cache_map.clear();
+
+  // If the scan was cancelled, we don't know whether the remaining entries still exist, so keep them.
+  if (!progress->IsCancelled())
+    RemoveUnseenEntries();
 }
 
 std::string GameList::GetCoverImagePathForEntry(const Entry* entry)
@@ -4,7 +4,9 @@
 #include "util/cd_image.h"
 #include <ctime>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <vector>
 
 class ByteStream;
 class ProgressCallback;
@@ -51,6 +53,22 @@ struct Entry
   static_assert(sizeof(std::time_t) == sizeof(u64));
 };
 
+enum class ChangeType
+{
+  Added,
+  Updated,
+  Removed
+};
+
+struct Change
+{
+  ChangeType type;
+  u32 index;
+
+  /// Path of the entry, since the index may be shifted by later removals.
+  std::string path;
+};
+
 const char* GetEntryTypeName(EntryType type);
 const char* GetEntryTypeDisplayName(EntryType type);
 
@@ -67,6 +85,31 @@ const Entry* GetEntryForPath(const char* path);
 const Entry* GetEntryBySerial(const std::string_view& serial);
 u32 GetEntryCount();
 
+/// Returns a counter which is incremented every time an entry is added, updated or removed.
+u32 GetChangeCounter();
+
+/// Returns the changes made since GetChangeCounter() returned counter, in the order they were made. Entries are only
+/// ever appended, updated in place, or removed from the highest index down. Removals compact the list as soon as the
+/// scan finishes, so the indices of earlier changes are only valid if there are no removals after them. Changes are
+/// only kept for the most recent refresh; if they're no longer available, nullopt is returned and the view should be
+/// rebuilt. Hold GetLock() across both calls to get a consistent list.
+std::optional<std::vector<Change>> GetChangesSince(u32 counter);
+
+/// Net effect of a series of changes on a view of the list which had old_count entries. Since entries are only ever
+/// appended and removals keep the order, the surviving old entries come first, followed by the new entries.
+struct ChangeSummary
+{
+  /// Indices of the removed entries in the old list, in ascending order.
+  std::vector<u32> removed;
+
+  /// Indices of the updated entries in the new list, in ascending order. New entries aren't included.
+  std::vector<u32> updated;
+
+  /// Index of the first new entry in the new list, i.e. the number of surviving old entries.
+  u32 first_added;
+};
+ChangeSummary SummarizeChanges(const std::vector<Change>& changes, u32 old_count);
+
 bool IsGameListLoaded();
 
 /// Populates the game list with files in the configured directories.
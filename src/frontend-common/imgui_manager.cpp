@@ -3,6 +3,7 @@
 #include "common/assert.h"
 #include "common/file_system.h"
 #include "common/log.h"
+#include "common/startup_trace.h"
 #include "common/string_util.h"
 #include "common/timer.h"
 #include "common_host.h"
@@ -74,6 +75,8 @@ void ImGuiManager::SetFontRange(const u16* range)
 
 bool ImGuiManager::Initialize()
 {
+  StartupTrace::Phase trace_phase("Initialize ImGui");
+
   if (!LoadFontData())
   {
     Panic("Failed to load font data");
@@ -387,6 +390,8 @@ void ImGuiManager::SetKeyMap()
 
 bool ImGuiManager::LoadFontData()
 {
+  StartupTrace::Phase trace_phase("Load font data");
+
   if (s_standard_font_data.empty())
   {
     std::optional<std::vector<u8>> font_data = s_font_path.empty() ?
@@ -473,6 +478,8 @@ bool ImGuiManager::AddIconFonts(float size)
 
 bool ImGuiManager::AddImGuiFonts(bool fullscreen_fonts)
 {
+  StartupTrace::Phase trace_phase("Build font atlas");
+
   const float standard_font_size = std::ceil(15.0f * s_global_scale);
 
   ImGuiIO& io = ImGui::GetIO();
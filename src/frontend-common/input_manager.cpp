@@ -3,22 +3,24 @@
 #include "common/file_system.h"
 #include "common/log.h"
 #include "common/path.h"
+#include "common/startup_trace.h"
 #include "common/string_util.h"
 #include "common/timer.h"
 #include "core/controller.h"
 #include "core/host.h"
+#include "core/netplay.h"
 #include "core/system.h"
 #include "imgui_manager.h"
 #include "input_source.h"
 
 #include "fmt/core.h"
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <memory>
 #include <mutex>
 #include <sstream>
-#include <unordered_map>
 #include <variant>
 #include <vector>
 
@@ -32,6 +34,7 @@ enum : u32
 {
   MAX_KEYS_PER_BINDING = 4,
   MAX_MOTORS_PER_PAD = 2,
+  MAX_DENSE_KEY_CODE = 256,
   FIRST_EXTERNAL_INPUT_SOURCE = static_cast<u32>(InputSourceType::Pointer) + 1u,
   LAST_EXTERNAL_INPUT_SOURCE = static_cast<u32>(InputSourceType::Count),
 };
@@ -56,9 +59,48 @@ struct InputBinding
 {
   InputBindingKey keys[MAX_KEYS_PER_BINDING] = {};
   InputEventHandler handler;
+  u32 first_cancel = 0; ///< Index into cancel list of bindings with shorter chords sharing our keys.
+  u32 num_cancel = 0;
   u8 num_keys = 0;
   u8 full_mask = 0;
   u8 current_mask = 0;
+  bool is_axis = false;
+};
+
+// ------------------------------------------------------------------------
+// Dispatch Table
+// ------------------------------------------------------------------------
+// Bindings are compiled into a flat table when they are reloaded, so that
+// dispatching an event is an array lookup for the source and key code,
+// followed by a walk over a contiguous list of references. Each reference
+// knows which chord bit it sets, so there's no searching at event time.
+
+struct InputBindingRef
+{
+  u32 binding_index;
+  u8 bit;
+  bool negative;
+};
+
+struct InputKeyBindings
+{
+  u32 first_ref;
+  u32 num_refs;
+};
+
+struct InputSourceBindings
+{
+  InputBindingKey source_key; ///< Key with data and direction cleared.
+  std::vector<InputKeyBindings> dense;
+  std::vector<std::pair<u32, InputKeyBindings>> sparse; ///< Sorted by key code, for codes >= MAX_DENSE_KEY_CODE.
+};
+
+struct InputDispatchTable
+{
+  std::vector<InputBinding> bindings;
+  std::vector<InputBindingRef> refs;
+  std::vector<u32> cancel_list;
+  std::vector<InputSourceBindings> sources;
 };
 
 struct PadVibrationBinding
@@ -110,6 +152,8 @@ static void AddBindings(const std::vector<std::string>& bindings, const InputEve
 static bool ParseBindingAndGetSource(const std::string_view& binding, InputBindingKey* key, InputSource** source);
 
 static bool IsAxisHandler(const InputEventHandler& handler);
+static void CompileBindings();
+static const InputKeyBindings* FindKeyBindings(InputBindingKey masked_key);
 
 static void AddHotkeyBindings(SettingsInterface& si);
 static void AddPadBindings(SettingsInterface& si, const std::string& section, u32 pad,
@@ -130,12 +174,11 @@ static void UpdateMacroButtons();
 // Local Variables
 // ------------------------------------------------------------------------
 
-// This is a multimap containing any binds related to the specified key.
-using BindingMap = std::unordered_multimap<InputBindingKey, std::shared_ptr<InputBinding>, InputBindingKeyHash>;
+// Compiled bindings. Only modified on the CPU thread with the write lock held, so event dispatch doesn't lock.
 using VibrationBindingArray = std::vector<PadVibrationBinding>;
-static BindingMap s_binding_map;
+static InputDispatchTable s_dispatch;
 static VibrationBindingArray s_pad_vibration_array;
-static std::mutex s_binding_map_write_lock;
+static std::mutex s_binding_write_lock;
 
 // Hooks/intercepting (for setting bindings)
 static std::mutex m_event_intercept_mutex;
@@ -342,7 +385,8 @@ void InputManager::AddBindings(const std::vector<std::string>& bindings, const I
 {
   for (const std::string& binding : bindings)
   {
-    std::shared_ptr<InputBinding> ibinding;
+    InputBinding ibinding;
+    bool valid = true;
     const std::vector<std::string_view> chord_bindings(SplitChord(binding));
 
     for (const std::string_view& chord_binding : chord_bindings)
@@ -351,35 +395,158 @@ void InputManager::AddBindings(const std::vector<std::string>& bindings, const I
       if (!key.has_value())
       {
         Log_ErrorPrintf("Invalid binding: '%s'", binding.c_str());
-        ibinding.reset();
+        valid = false;
         break;
       }
 
-      if (!ibinding)
+      if (ibinding.num_keys == MAX_KEYS_PER_BINDING)
       {
-        ibinding = std::make_shared<InputBinding>();
-        ibinding->handler = handler;
+        Log_ErrorPrintf("Too many chord parts, max is %u (%s)", MAX_KEYS_PER_BINDING, binding.c_str());
+        valid = false;
+        break;
       }
 
-      if (ibinding->num_keys == MAX_KEYS_PER_BINDING)
+      ibinding.keys[ibinding.num_keys] = key.value();
+      ibinding.full_mask |= (static_cast<u8>(1) << ibinding.num_keys);
+      ibinding.num_keys++;
+    }
+
+    if (!valid || ibinding.num_keys == 0)
+      continue;
+
+    ibinding.handler = handler;
+    ibinding.is_axis = IsAxisHandler(handler);
+    s_dispatch.bindings.push_back(std::move(ibinding));
+  }
+}
+
+void InputManager::CompileBindings()
+{
+  struct PendingRef
+  {
+    InputBindingKey key;
+    InputBindingRef ref;
+  };
+
+  std::vector<InputBinding>& bindings = s_dispatch.bindings;
+  std::vector<PendingRef> pending;
+  for (u32 i = 0; i < static_cast<u32>(bindings.size()); i++)
+  {
+    const InputBinding& binding = bindings[i];
+    for (u32 j = 0; j < binding.num_keys; j++)
+    {
+      // we shouldn't have the same key twice in the chord, only the first one is used
+      const InputBindingKey masked_key = binding.keys[j].MaskDirection();
+      if (std::any_of(binding.keys, binding.keys + j,
+                      [&masked_key](const InputBindingKey& k) { return k.MaskDirection() == masked_key; }))
       {
-        Log_ErrorPrintf("Too many chord parts, max is %u (%s)", MAX_KEYS_PER_BINDING, binding.c_str());
-        ibinding.reset();
-        break;
+        continue;
       }
 
-      ibinding->keys[ibinding->num_keys] = key.value();
-      ibinding->full_mask |= (static_cast<u8>(1) << ibinding->num_keys);
-      ibinding->num_keys++;
+      pending.push_back(
+        PendingRef{masked_key, InputBindingRef{i, static_cast<u8>(1u << j), static_cast<bool>(binding.keys[j].negative)}});
+    }
+  }
+
+  // Group references by key, with longer chords first, so they can suppress shorter chords sharing the same keys.
+  std::stable_sort(pending.begin(), pending.end(), [&bindings](const PendingRef& lhs, const PendingRef& rhs) {
+    if (lhs.key.bits != rhs.key.bits)
+      return lhs.key.bits < rhs.key.bits;
+    return bindings[lhs.ref.binding_index].num_keys > bindings[rhs.ref.binding_index].num_keys;
+  });
+
+  s_dispatch.refs.clear();
+  s_dispatch.refs.reserve(pending.size());
+  s_dispatch.sources.clear();
+  for (size_t i = 0; i < pending.size();)
+  {
+    const InputBindingKey key = pending[i].key;
+    const InputKeyBindings kb{static_cast<u32>(s_dispatch.refs.size()), 0};
+    for (; i < pending.size() && pending[i].key == key; i++)
+      s_dispatch.refs.push_back(pending[i].ref);
+
+    InputBindingKey source_key = key;
+    source_key.data = 0;
+    auto source = std::find_if(s_dispatch.sources.begin(), s_dispatch.sources.end(),
+                               [&source_key](const InputSourceBindings& sb) { return sb.source_key == source_key; });
+    if (source == s_dispatch.sources.end())
+    {
+      source = s_dispatch.sources.emplace(s_dispatch.sources.end());
+      source->source_key = source_key;
     }
 
-    if (!ibinding)
+    const InputKeyBindings new_kb{kb.first_ref, static_cast<u32>(s_dispatch.refs.size()) - kb.first_ref};
+    if (key.data < MAX_DENSE_KEY_CODE)
+    {
+      if (source->dense.size() <= key.data)
+        source->dense.resize(key.data + 1, InputKeyBindings{0, 0});
+      source->dense[key.data] = new_kb;
+    }
+    else
+    {
+      // keys are sorted by data before source, so this stays sorted
+      source->sparse.emplace_back(key.data, new_kb);
+    }
+  }
+
+  // Precompute which shorter chords get cancelled when a multi-key chord activates.
+  s_dispatch.cancel_list.clear();
+  for (InputBinding& binding : bindings)
+  {
+    binding.first_cancel = static_cast<u32>(s_dispatch.cancel_list.size());
+    binding.num_cancel = 0;
+    if (binding.is_axis || binding.num_keys <= 1)
       continue;
 
-    // plop it in the input map for all the keys
-    for (u32 i = 0; i < ibinding->num_keys; i++)
-      s_binding_map.emplace(ibinding->keys[i].MaskDirection(), ibinding);
+    for (u32 i = 0; i < static_cast<u32>(bindings.size()); i++)
+    {
+      const InputBinding& other = bindings[i];
+      if (&other == &binding || other.is_axis || other.num_keys >= binding.num_keys)
+        continue;
+
+      bool shares_key = false;
+      for (u32 j = 0; j < binding.num_keys && !shares_key; j++)
+      {
+        const InputBindingKey masked_key = binding.keys[j].MaskDirection();
+        for (u32 k = 0; k < other.num_keys && !shares_key; k++)
+          shares_key = (other.keys[k].MaskDirection() == masked_key);
+      }
+
+      if (shares_key)
+      {
+        s_dispatch.cancel_list.push_back(i);
+        binding.num_cancel++;
+      }
+    }
   }
+
+  Log_DevPrintf("Compiled %zu bindings into %zu sources, %zu references", bindings.size(), s_dispatch.sources.size(),
+                s_dispatch.refs.size());
+}
+
+const InputKeyBindings* InputManager::FindKeyBindings(InputBindingKey masked_key)
+{
+  InputBindingKey source_key = masked_key;
+  source_key.data = 0;
+
+  for (const InputSourceBindings& source : s_dispatch.sources)
+  {
+    if (source.source_key != source_key)
+      continue;
+
+    if (masked_key.data < source.dense.size())
+    {
+      const InputKeyBindings& kb = source.dense[masked_key.data];
+      return (kb.num_refs > 0) ? &kb : nullptr;
+    }
+
+    const auto it = std::lower_bound(
+      source.sparse.begin(), source.sparse.end(), masked_key.data,
+      [](const std::pair<u32, InputKeyBindings>& it, u32 data) { return it.first < data; });
+    return (it != source.sparse.end() && it->first == masked_key.data) ? &it->second : nullptr;
+  }
+
+  return nullptr;
 }
 
 // ------------------------------------------------------------------------
@@ -611,6 +778,14 @@ void InputManager::AddPadBindings(SettingsInterface& si, const std::string& sect
                     if (!System::IsValid())
                       return;
 
+                    // Netplay owns the controllers, and sends our first pad to the other player.
+                    if (Netplay::IsActive())
+                    {
+                      if (pad_index == 0)
+                        Netplay::SetLocalBindState(bind_index, value);
+                      return;
+                    }
+
                     Controller* c = System::GetController(pad_index);
                     if (c)
                       c->SetBindState(bind_index, value);
@@ -672,16 +847,16 @@ void InputManager::AddPadBindings(SettingsInterface& si, const std::string& sect
 
 bool InputManager::HasAnyBindingsForKey(InputBindingKey key)
 {
-  std::unique_lock lock(s_binding_map_write_lock);
-  return (s_binding_map.find(key.MaskDirection()) != s_binding_map.end());
+  std::unique_lock lock(s_binding_write_lock);
+  return (FindKeyBindings(key.MaskDirection()) != nullptr);
 }
 
 bool InputManager::HasAnyBindingsForSource(InputBindingKey key)
 {
-  std::unique_lock lock(s_binding_map_write_lock);
-  for (const auto& it : s_binding_map)
+  std::unique_lock lock(s_binding_write_lock);
+  for (const InputSourceBindings& source : s_dispatch.sources)
   {
-    const InputBindingKey& okey = it.first;
+    const InputBindingKey& okey = source.source_key;
     if (okey.source_type == key.source_type && okey.source_index == key.source_index &&
         okey.source_subtype == key.source_subtype)
     {
@@ -706,93 +881,71 @@ bool InputManager::InvokeEvents(InputBindingKey key, float value, GenericInputBi
   const bool skip_button_handlers = PreprocessEvent(key, value, generic_key);
 
   // find all the bindings associated with this key
-  const InputBindingKey masked_key = key.MaskDirection();
-  const auto range = s_binding_map.equal_range(masked_key);
-  if (range.first == s_binding_map.end())
+  const InputKeyBindings* kb = FindKeyBindings(key.MaskDirection());
+  if (!kb)
     return false;
 
-  // Now we can actually fire/activate bindings.
+  // Now we can actually fire/activate bindings. References are sorted by chord length, longest first.
   u32 min_num_keys = 0;
-  for (auto it = range.first; it != range.second; ++it)
+  const InputBindingRef* refs = &s_dispatch.refs[kb->first_ref];
+  for (u32 r = 0; r < kb->num_refs; r++)
   {
-    InputBinding* binding = it->second.get();
-
-    // find the key which matches us
-    for (u32 i = 0; i < binding->num_keys; i++)
-    {
-      if (binding->keys[i].MaskDirection() != masked_key)
-        continue;
+    const InputBindingRef& ref = refs[r];
+    InputBinding* binding = &s_dispatch.bindings[ref.binding_index];
 
-      const u8 bit = static_cast<u8>(1) << i;
-      const bool negative = binding->keys[i].negative;
-      const bool new_state = (negative ? (value < 0.0f) : (value > 0.0f));
+    const bool negative = ref.negative;
+    const bool new_state = (negative ? (value < 0.0f) : (value > 0.0f));
 
-      // invert if we're negative, since the handler expects 0..1
-      const float value_to_pass = (negative ? ((value < 0.0f) ? -value : 0.0f) : (value > 0.0f) ? value : 0.0f);
+    // invert if we're negative, since the handler expects 0..1
+    const float value_to_pass = (negative ? ((value < 0.0f) ? -value : 0.0f) : (value > 0.0f) ? value : 0.0f);
 
-      // axes are fired regardless of a state change, unless they're zero
-      // (but going from not-zero to zero will still fire, because of the full state)
-      // for buttons, we can use the state of the last chord key, because it'll be 1 on press,
-      // and 0 on release (when the full state changes).
-      if (IsAxisHandler(binding->handler))
-      {
-        if (value_to_pass >= 0.0f)
-          std::get<InputAxisEventHandler>(binding->handler)(value_to_pass);
-      }
-      else if (binding->num_keys >= min_num_keys)
+    // axes are fired regardless of a state change, unless they're zero
+    // (but going from not-zero to zero will still fire, because of the full state)
+    // for buttons, we can use the state of the last chord key, because it'll be 1 on press,
+    // and 0 on release (when the full state changes).
+    if (binding->is_axis)
+    {
+      if (value_to_pass >= 0.0f)
+        std::get<InputAxisEventHandler>(binding->handler)(value_to_pass);
+    }
+    else if (binding->num_keys >= min_num_keys)
+    {
+      // update state based on whether the whole chord was activated
+      const u8 new_mask = (new_state ? (binding->current_mask | ref.bit) : (binding->current_mask & ~ref.bit));
+      const bool prev_full_state = (binding->current_mask == binding->full_mask);
+      const bool new_full_state = (new_mask == binding->full_mask);
+      binding->current_mask = new_mask;
+
+      // Workaround for multi-key bindings that share the same keys.
+      if (binding->num_keys > 1 && new_full_state && prev_full_state != new_full_state)
       {
-        // update state based on whether the whole chord was activated
-        const u8 new_mask = (new_state ? (binding->current_mask | bit) : (binding->current_mask & ~bit));
-        const bool prev_full_state = (binding->current_mask == binding->full_mask);
-        const bool new_full_state = (new_mask == binding->full_mask);
-        binding->current_mask = new_mask;
-
-        // Workaround for multi-key bindings that share the same keys.
-        if (binding->num_keys > 1 && new_full_state && prev_full_state != new_full_state && range.first != range.second)
+        // If we bind say, F1 and Shift+F1, and press shift and then F1, we'll fire bindings for both F1
+        // and Shift+F1, when we really only want to fire the binding for Shift+F1. So, skip activating any
+        // later bindings with a fewer number of keys for this event.
+        min_num_keys = std::max<u32>(min_num_keys, binding->num_keys);
+
+        // And cancel any shorter chords sharing our keys, which were precomputed when the bindings were
+        // compiled. If they're longer, they could still activate and take precedence over us.
+        for (u32 i = 0; i < binding->num_cancel; i++)
         {
-          // Because the binding map isn't ordered, we could iterate in the order of Shift+F1 and then
-          // F1, which would mean that F1 wouldn't get cancelled and still activate. So, to handle this
-          // case, we skip activating any future bindings with a fewer number of keys.
-          min_num_keys = std::max<u32>(min_num_keys, binding->num_keys);
-
-          // Basically, if we bind say, F1 and Shift+F1, and press shift and then F1, we'll fire bindings
-          // for both F1 and Shift+F1, when we really only want to fire the binding for Shift+F1. So,
-          // when we activate a multi-key chord (key press), we go through the binding map for all the
-          // other keys in the chord, and cancel them if they have a shorter chord. If they're longer,
-          // they could still activate and take precedence over us, so we leave them alone.
-          for (u32 j = 0; j < binding->num_keys; j++)
-          {
-            const auto range2 = s_binding_map.equal_range(binding->keys[j].MaskDirection());
-            for (auto it2 = range2.first; it2 != range2.second; ++it2)
-            {
-              InputBinding* other_binding = it2->second.get();
-              if (other_binding == binding || IsAxisHandler(other_binding->handler) ||
-                  other_binding->num_keys >= binding->num_keys)
-              {
-                continue;
-              }
-
-              // We only need to cancel the binding if it was fully active before. Which in the above
-              // case of Shift+F1 / F1, it will be.
-              if (other_binding->current_mask == other_binding->full_mask)
-                std::get<InputButtonEventHandler>(other_binding->handler)(-1);
-
-              // Zero out the current bits so that we don't release this binding, if the other part
-              // of the chord releases first.
-              other_binding->current_mask = 0;
-            }
-          }
-        }
+          InputBinding* other_binding = &s_dispatch.bindings[s_dispatch.cancel_list[binding->first_cancel + i]];
 
-        if (prev_full_state != new_full_state && binding->num_keys >= min_num_keys)
-        {
-          const s32 pressed = skip_button_handlers ? -1 : static_cast<s32>(value_to_pass > 0.0f);
-          std::get<InputButtonEventHandler>(binding->handler)(pressed);
+          // We only need to cancel the binding if it was fully active before. Which in the above
+          // case of Shift+F1 / F1, it will be.
+          if (other_binding->current_mask == other_binding->full_mask)
+            std::get<InputButtonEventHandler>(other_binding->handler)(-1);
+
+          // Zero out the current bits so that we don't release this binding, if the other part
+          // of the chord releases first.
+          other_binding->current_mask = 0;
         }
       }
 
-      // bail out, since we shouldn't have the same key twice in the chord
-      break;
+      if (prev_full_state != new_full_state)
+      {
+        const s32 pressed = skip_button_handlers ? -1 : static_cast<s32>(value_to_pass > 0.0f);
+        std::get<InputButtonEventHandler>(binding->handler)(pressed);
+      }
     }
   }
 
@@ -881,14 +1034,17 @@ bool InputManager::IsUsingRawInput()
 
 bool InputManager::HasPointerAxisBinds()
 {
-  std::unique_lock lock(s_binding_map_write_lock);
-  for (const auto& it : s_binding_map)
+  std::unique_lock lock(s_binding_write_lock);
+  for (const InputSourceBindings& source : s_dispatch.sources)
   {
-    const InputBindingKey& key = it.first;
-    if (key.source_type == InputSourceType::Pointer && key.source_subtype == InputSubclass::PointerAxis &&
-        key.data >= static_cast<u32>(InputPointerAxis::X) && key.data <= static_cast<u32>(InputPointerAxis::Y))
+    const InputBindingKey& key = source.source_key;
+    if (key.source_type != InputSourceType::Pointer || key.source_subtype != InputSubclass::PointerAxis)
+      continue;
+
+    for (u32 axis = static_cast<u32>(InputPointerAxis::X); axis <= static_cast<u32>(InputPointerAxis::Y); axis++)
     {
-      return true;
+      if (axis < source.dense.size() && source.dense[axis].num_refs > 0)
+        return true;
     }
   }
 
@@ -1240,11 +1396,22 @@ void InputManager::SetMacroButtonState(u32 pad, u32 index, bool state)
 
 void InputManager::ApplyMacroButton(u32 pad, const MacroButton& mb)
 {
+  const float value = mb.toggle_state ? 1.0f : 0.0f;
+  if (Netplay::IsActive())
+  {
+    if (pad == 0)
+    {
+      for (const u32 btn : mb.buttons)
+        Netplay::SetLocalBindState(btn, value);
+    }
+
+    return;
+  }
+
   Controller* const controller = System::GetController(pad);
   if (!controller)
     return;
 
-  const float value = mb.toggle_state ? 1.0f : 0.0f;
   for (const u32 btn : mb.buttons)
     controller->SetBindState(btn, value);
 }
@@ -1316,9 +1483,9 @@ void InputManager::ReloadBindings(SettingsInterface& si, SettingsInterface& bind
 {
   PauseVibration();
 
-  std::unique_lock lock(s_binding_map_write_lock);
+  std::unique_lock lock(s_binding_write_lock);
 
-  s_binding_map.clear();
+  s_dispatch.bindings.clear();
   s_pad_vibration_array.clear();
 
   // Hotkeys use the base configuration, except if the custom hotkeys option is enabled.
@@ -1339,6 +1506,8 @@ void InputManager::ReloadBindings(SettingsInterface& si, SettingsInterface& bind
     LoadMacroButtonConfig(si, section, pad, cinfo);
   }
 
+  CompileBindings();
+
   for (u32 axis = 0; axis < static_cast<u32>(InputPointerAxis::Count); axis++)
   {
     // From lilypad: 1 mouse pixel = 1/8th way down.
@@ -1517,6 +1686,8 @@ static void UpdateInputSourceState(SettingsInterface& si, std::unique_lock<std::
 
 void InputManager::ReloadSources(SettingsInterface& si, std::unique_lock<std::mutex>& settings_lock)
 {
+  StartupTrace::Phase trace_phase("Initialize input sources");
+
 #ifdef _WIN32
   UpdateInputSourceState(si, settings_lock, InputSourceType::DInput, &InputSource::CreateDInputSource, false);
   UpdateInputSourceState(si, settings_lock, InputSourceType::XInput, &InputSource::CreateXInputSource, false);
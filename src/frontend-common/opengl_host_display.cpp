@@ -214,7 +214,7 @@ bool OpenGLHostDisplay::BeginSetDisplayPixels(HostDisplayPixelFormat format, u32
 {
   const u32 pixel_size = GetDisplayPixelFormatSize(format);
   const u32 stride = Common::AlignUpPow2(width * pixel_size, 4);
-  const u32 size_required = stride * height * pixel_size;
+  const u32 size_required = stride * height;
 
   if (m_use_pbo_for_pixels)
   {
@@ -945,6 +945,8 @@ bool OpenGLHostDisplay::SetPostProcessingChain(const std::string_view& config)
   if (!m_post_processing_chain.CreateFromString(config))
     return false;
 
+  m_post_processing_chain.FuseStages();
+
   m_post_processing_stages.clear();
 
   FrontendCommon::PostProcessingShaderGen shadergen(HostDisplay::RenderAPI::OpenGL, false);
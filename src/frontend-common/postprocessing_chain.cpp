@@ -7,6 +7,7 @@
 #include "core/host.h"
 #include "core/settings.h"
 #include "fmt/format.h"
+#include "postprocessing_shadergen.h"
 #include <sstream>
 Log_SetChannel(PostProcessingChain);
 
@@ -179,4 +180,29 @@ void PostProcessingChain::ClearStages()
   m_shaders.clear();
 }
 
+void PostProcessingChain::FuseStages()
+{
+  std::vector<PostProcessingShader> fused_shaders;
+
+  const u32 num_shaders = static_cast<u32>(m_shaders.size());
+  for (u32 start = 0; start < num_shaders;)
+  {
+    u32 count = 1;
+    while ((start + count) < num_shaders && m_shaders[start + count].SamplesOnlyCurrentPixel())
+      count++;
+
+    if (count == 1)
+      fused_shaders.push_back(std::move(m_shaders[start]));
+    else
+      fused_shaders.push_back(PostProcessingShaderGen::FuseShaders(&m_shaders[start], count));
+
+    start += count;
+  }
+
+  if (fused_shaders.size() != m_shaders.size())
+    Log_InfoPrintf("Fused postprocessing chain of %zu shaders into %zu passes", m_shaders.size(), fused_shaders.size());
+
+  m_shaders = std::move(fused_shaders);
+}
+
 } // namespace FrontendCommon
\ No newline at end of file
@@ -23,6 +23,10 @@ public:
   void MoveStageDown(u32 index);
   void ClearStages();
 
+  /// Merges runs of shaders which only sample the current pixel into the preceding stage, reducing the number of
+  /// passes. The resulting stages are only suitable for rendering, not for configuration.
+  void FuseStages();
+
   std::string GetConfigString() const;
 
   bool CreateFromString(const std::string_view& chain_config);
@@ -127,6 +127,18 @@ bool PostProcessingShader::IsValid() const
   return !m_name.empty() && !m_code.empty();
 }
 
+bool PostProcessingShader::SamplesOnlyCurrentPixel() const
+{
+  // Conservative, a mention in a comment will also disable fusing.
+  for (const char* token : {"SampleLocation", "SampleOffset", "texture", "texelFetch", "samp0"})
+  {
+    if (m_code.find(token) != std::string::npos)
+      return false;
+  }
+
+  return true;
+}
+
 const PostProcessingShader::Option* PostProcessingShader::GetOptionByName(const std::string_view& name) const
 {
   for (const Option& option : m_options)
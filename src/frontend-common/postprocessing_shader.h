@@ -70,6 +70,10 @@ public:
 
   bool IsValid() const;
 
+  /// Returns true if the shader only reads its input at the pixel being shaded, through Sample(). Consecutive shaders
+  /// of this kind can be fused into a single pass.
+  bool SamplesOnlyCurrentPixel() const;
+
   const Option* GetOptionByName(const std::string_view& name) const;
   Option* GetOptionByName(const std::string_view& name);
 
@@ -1,7 +1,105 @@
 #include "postprocessing_shadergen.h"
+#include "fmt/format.h"
+#include <algorithm>
+#include <cctype>
 
 namespace FrontendCommon {
 
+// Finds the names declared at global scope in shader code, i.e. functions, constants and structs, as well as any macros
+// it defines. This is a simple scan which only looks at the last identifier before the first '(', '=', '[', '{' or ';'
+// of each top-level statement, which is sufficient for the shaders we ship.
+static void GetTopLevelDeclarations(const std::string_view& code, std::vector<std::string>* names,
+                                    std::vector<std::string>* macros)
+{
+  u32 depth = 0;
+  bool statement_done = false;
+  std::string_view last_identifier;
+
+  for (size_t pos = 0; pos < code.size();)
+  {
+    const char ch = code[pos];
+    if (ch == '/' && (pos + 1) < code.size() && code[pos + 1] == '/')
+    {
+      pos = code.find('\n', pos);
+      continue;
+    }
+    else if (ch == '/' && (pos + 1) < code.size() && code[pos + 1] == '*')
+    {
+      pos = code.find("*/", pos + 2);
+      pos = (pos == std::string_view::npos) ? code.size() : (pos + 2);
+      continue;
+    }
+    else if (ch == '#')
+    {
+      size_t end = code.find('\n', pos);
+      if (end == std::string_view::npos)
+        end = code.size();
+
+      const std::string_view line = code.substr(pos, end - pos);
+      size_t name_start = line.find("define");
+      if (name_start != std::string_view::npos)
+      {
+        name_start += 6;
+        while (name_start < line.size() && std::isspace(line[name_start]))
+          name_start++;
+
+        size_t name_end = name_start;
+        while (name_end < line.size() && (std::isalnum(line[name_end]) || line[name_end] == '_'))
+          name_end++;
+
+        if (name_end > name_start)
+          macros->emplace_back(line.substr(name_start, name_end - name_start));
+      }
+
+      pos = end;
+      continue;
+    }
+    else if (std::isalpha(ch) || ch == '_')
+    {
+      const size_t start = pos;
+      while (pos < code.size() && (std::isalnum(code[pos]) || code[pos] == '_'))
+        pos++;
+
+      if (depth == 0 && !statement_done)
+        last_identifier = code.substr(start, pos - start);
+
+      continue;
+    }
+
+    if (ch == '{')
+    {
+      if (depth == 0 && !statement_done && !last_identifier.empty())
+        names->emplace_back(last_identifier);
+      depth++;
+      statement_done = false;
+      last_identifier = {};
+    }
+    else if (ch == '}')
+    {
+      if (depth > 0)
+        depth--;
+      statement_done = false;
+      last_identifier = {};
+    }
+    else if (depth == 0)
+    {
+      if (ch == '(' || ch == '=' || ch == '[' || ch == ';')
+      {
+        if (!statement_done && !last_identifier.empty())
+          names->emplace_back(last_identifier);
+
+        statement_done = (ch != ';');
+        last_identifier = {};
+      }
+    }
+
+    pos++;
+  }
+
+  std::sort(names->begin(), names->end());
+  names->erase(std::unique(names->begin(), names->end()), names->end());
+}
+
 PostProcessingShaderGen::PostProcessingShaderGen(HostDisplay::RenderAPI render_api, bool supports_dual_source_blend)
   : ShaderGen(render_api, supports_dual_source_blend)
 {
@@ -137,6 +235,73 @@ void main(in float2 v_tex0_ : TEXCOORD0, in float4 v_pos_ : SV_Position, out flo
   return ss.str();
 }
 
+PostProcessingShader PostProcessingShaderGen::FuseShaders(const PostProcessingShader* shaders, u32 count)
+{
+  std::string name;
+  std::vector<PostProcessingShader::Option> options;
+  std::stringstream ss;
+
+  // Sample() returns the previous shader's output for all but the first shader, which gets the source texture.
+  ss << "GLOBAL float4 pp_stage_input;\n";
+  ss << "#define Sample() (pp_stage_input)\n";
+  ss << "#undef main\n";
+
+  for (u32 i = 0; i < count; i++)
+  {
+    const PostProcessingShader& shader = shaders[i];
+    const std::string prefix(fmt::format("pp{}_", i));
+    if (i > 0)
+      name += " + ";
+    name += shader.GetName();
+
+    std::vector<std::string> names, macros;
+    GetTopLevelDeclarations(shader.GetCode(), &names, &macros);
+    for (const PostProcessingShader::Option& option : shader.GetOptions())
+      names.push_back(option.name);
+
+    ss << "\n// " << shader.GetName() << "\n";
+    for (const std::string& decl : names)
+      ss << "#define " << decl << " " << prefix << decl << "\n";
+
+    ss << shader.GetCode() << "\n";
+
+    for (const std::string& decl : names)
+      ss << "#undef " << decl << "\n";
+    for (const std::string& macro : macros)
+      ss << "#undef " << macro << "\n";
+
+    for (const PostProcessingShader::Option& option : shader.GetOptions())
+    {
+      PostProcessingShader::Option& new_option = options.emplace_back(option);
+      new_option.name = prefix + option.name;
+      if (!new_option.dependent_option.empty())
+        new_option.dependent_option = prefix + new_option.dependent_option;
+    }
+  }
+
+  ss << R"(
+#undef Sample
+#ifdef HLSL
+#define main real_main
+#endif
+void main()
+{
+  pp_stage_input = texture(samp0, v_tex0);
+)";
+  for (u32 i = 0; i < count; i++)
+  {
+    if (i > 0)
+      ss << "  pp_stage_input = o_col0;\n";
+    ss << "  pp" << i << "_main();\n";
+  }
+  ss << "}\n";
+
+  PostProcessingShader fused;
+  fused.LoadFromString(std::move(name), ss.str());
+  fused.GetOptions() = std::move(options);
+  return fused;
+}
+
 void PostProcessingShaderGen::WriteUniformBuffer(std::stringstream& ss, const PostProcessingShader& shader,
                                                  bool use_push_constants)
 {
@@ -14,6 +14,11 @@ public:
   std::string GeneratePostProcessingVertexShader(const PostProcessingShader& shader);
   std::string GeneratePostProcessingFragmentShader(const PostProcessingShader& shader);
 
+  /// Combines several shaders into one, which runs each shader's main() in turn, feeding the output of one shader into
+  /// Sample() of the next. All but the first shader must only sample the current pixel. Options and top-level
+  /// declarations are prefixed per-shader to avoid collisions.
+  static PostProcessingShader FuseShaders(const PostProcessingShader* shaders, u32 count);
+
 private:
   void WriteUniformBuffer(std::stringstream& ss, const PostProcessingShader& shader, bool use_push_constants);
 };
@@ -1,4 +1,5 @@
 ﻿#include "vulkan_host_display.h"
+#include "common/align.h"
 #include "common/assert.h"
 #include "common/log.h"
 #include "common/scoped_guard.h"
@@ -10,6 +11,7 @@
 #include "common/vulkan/swap_chain.h"
 #include "common/vulkan/util.h"
 #include "common_host.h"
+#include "core/settings.h"
 #include "core/shader_cache_version.h"
 #include "imgui.h"
 #include "imgui_impl_vulkan.h"
@@ -218,28 +220,78 @@ void VulkanHostDisplay::UpdateTexture(HostDisplayTexture* texture, u32 x, u32 y,
 {
   VulkanHostDisplayTexture* vk_texture = static_cast<VulkanHostDisplayTexture*>(texture);
 
-  Vulkan::StagingTexture* staging_texture;
   if (vk_texture->GetStagingTexture().IsValid())
   {
-    staging_texture = &vk_texture->GetStagingTexture();
+    Vulkan::StagingTexture& staging_texture = vk_texture->GetStagingTexture();
+    staging_texture.WriteTexels(0, 0, width, height, data, data_stride);
+    staging_texture.CopyToTexture(0, 0, vk_texture->GetTexture(), x, y, 0, 0, width, height);
+    return;
   }
-  else
+
+  Vulkan::Texture& dst_texture = vk_texture->GetTexture();
+  void* map_ptr;
+  u32 map_pitch;
+  if (!MapUploadBuffer(dst_texture.GetFormat(), width, height, &map_ptr, &map_pitch))
+    Panic("Failed to map upload buffer");
+
+  const u32 copy_size = width * Vulkan::Util::GetTexelSize(dst_texture.GetFormat());
+  const u8* src_ptr = static_cast<const u8*>(data);
+  u8* dst_ptr = static_cast<u8*>(map_ptr);
+  for (u32 row = 0; row < height; row++)
   {
-    // TODO: This should use a stream buffer instead for speed.
-    if (m_upload_staging_texture.IsValid())
-      m_upload_staging_texture.Flush();
+    std::memcpy(dst_ptr, src_ptr, copy_size);
+    src_ptr += data_stride;
+    dst_ptr += map_pitch;
+  }
+
+  UnmapUploadBuffer(dst_texture, x, y, width, height);
+}
 
-    if ((m_upload_staging_texture.GetWidth() < width || m_upload_staging_texture.GetHeight() < height) &&
-        !m_upload_staging_texture.Create(Vulkan::StagingBuffer::Type::Upload, VK_FORMAT_R8G8B8A8_UNORM, width, height))
+bool VulkanHostDisplay::MapUploadBuffer(VkFormat format, u32 width, u32 height, void** out_buffer, u32* out_pitch)
+{
+  // vkCmdCopyBufferToImage() needs the rows to be tightly packed, and the offset to be a multiple of the texel size
+  const u32 texel_size = Vulkan::Util::GetTexelSize(format);
+  const u32 pitch = width * texel_size;
+  const u32 upload_size = pitch * height;
+  const u32 alignment = std::max<u32>(texel_size, 4);
+
+  // Sized for a couple of frames, so we're not waiting on the GPU to finish with the last upload.
+  if (m_upload_stream_buffer.GetCurrentSize() < (upload_size * 2))
+  {
+    m_upload_stream_buffer.Destroy(true);
+    if (!m_upload_stream_buffer.Create(VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                       Common::AlignUpPow2(upload_size * 2, UPLOAD_STREAM_BUFFER_GRANULARITY)))
     {
-      Panic("Failed to create upload staging texture");
+      Log_ErrorPrintf("Failed to allocate %u byte upload stream buffer", upload_size * 2);
+      return false;
     }
+  }
 
-    staging_texture = &m_upload_staging_texture;
+  if (!m_upload_stream_buffer.ReserveMemory(upload_size, alignment))
+  {
+    Log_PerfPrintf("Executing command buffer while waiting for %u bytes (%ux%u) in upload buffer", upload_size, width,
+                   height);
+    g_vulkan_context->ExecuteCommandBuffer(false);
+    if (!m_upload_stream_buffer.ReserveMemory(upload_size, alignment))
+    {
+      Log_ErrorPrintf("Failed to reserve %u bytes for %ux%u upload", upload_size, width, height);
+      return false;
+    }
   }
 
-  staging_texture->WriteTexels(0, 0, width, height, data, data_stride);
-  staging_texture->CopyToTexture(0, 0, vk_texture->GetTexture(), x, y, 0, 0, width, height);
+  *out_buffer = m_upload_stream_buffer.GetCurrentHostPointer();
+  *out_pitch = pitch;
+  return true;
+}
+
+void VulkanHostDisplay::UnmapUploadBuffer(Vulkan::Texture& texture, u32 x, u32 y, u32 width, u32 height)
+{
+  const u32 upload_size = width * height * Vulkan::Util::GetTexelSize(texture.GetFormat());
+  const u32 buffer_offset = m_upload_stream_buffer.GetCurrentOffset();
+  m_upload_stream_buffer.CommitMemory(upload_size);
+
+  texture.UpdateFromBuffer(g_vulkan_context->GetCurrentCommandBuffer(), 0, 0, x, y, width, height,
+                           m_upload_stream_buffer.GetBuffer(), buffer_offset);
 }
 
 bool VulkanHostDisplay::DownloadTexture(const void* texture_handle, HostDisplayPixelFormat texture_format, u32 x, u32 y,
@@ -287,25 +339,19 @@ bool VulkanHostDisplay::BeginSetDisplayPixels(HostDisplayPixelFormat format, u32
     }
   }
 
-  if ((m_upload_staging_texture.GetWidth() < width || m_upload_staging_texture.GetHeight() < height) &&
-      !m_upload_staging_texture.Create(Vulkan::StagingBuffer::Type::Upload, vk_format, width, height))
-  {
+  // the caller writes straight into the stream buffer, which is then copied to the texture on the GPU timeline
+  if (!MapUploadBuffer(vk_format, width, height, out_buffer, out_pitch))
     return false;
-  }
 
   SetDisplayTexture(&m_display_pixels_texture, format, m_display_pixels_texture.GetWidth(),
                     m_display_pixels_texture.GetHeight(), 0, 0, width, height);
-
-  *out_buffer = m_upload_staging_texture.GetMappedPointer();
-  *out_pitch = m_upload_staging_texture.GetMappedStride();
   return true;
 }
 
 void VulkanHostDisplay::EndSetDisplayPixels()
 {
-  m_upload_staging_texture.CopyToTexture(0, 0, m_display_pixels_texture, 0, 0, 0, 0,
-                                         static_cast<u32>(m_display_texture_view_width),
-                                         static_cast<u32>(m_display_texture_view_height));
+  UnmapUploadBuffer(m_display_pixels_texture, 0, 0, static_cast<u32>(m_display_texture_view_width),
+                    static_cast<u32>(m_display_texture_view_height));
 }
 
 void VulkanHostDisplay::SetVSync(bool enabled)
@@ -322,7 +368,8 @@ bool VulkanHostDisplay::CreateRenderDevice(const WindowInfo& wi, std::string_vie
                                            bool threaded_presentation)
 {
   WindowInfo local_wi(wi);
-  if (!Vulkan::Context::Create(adapter_name, &local_wi, &m_swap_chain, threaded_presentation, debug_device, false))
+  if (!Vulkan::Context::Create(adapter_name, &local_wi, &m_swap_chain, threaded_presentation, debug_device, false,
+                               g_settings.gpu_vulkan_frames_in_flight))
   {
     Log_ErrorPrintf("Failed to create Vulkan context");
     m_window_info = {};
@@ -520,7 +567,7 @@ void VulkanHostDisplay::DestroyResources()
 
   m_display_pixels_texture.Destroy(false);
   m_readback_staging_texture.Destroy(false);
-  m_upload_staging_texture.Destroy(false);
+  m_upload_stream_buffer.Destroy(false);
 
   Vulkan::Util::SafeDestroyPipeline(m_display_pipeline);
   Vulkan::Util::SafeDestroyPipeline(m_cursor_pipeline);
@@ -582,11 +629,29 @@ bool VulkanHostDisplay::Render()
     return false;
   }
 
-  // Previous frame needs to be presented before we can acquire the swap chain.
+  // Previous frame needs to be presented before we can acquire the swap chain. If we're allowed to drop frames, skip
+  // this one instead of blocking, and let the present thread carry on showing the previous frame.
+  const bool drop_late_frame = m_drop_late_frames;
+  if (drop_late_frame && g_vulkan_context->IsPresentPending())
+  {
+    if (ImGui::GetCurrentContext())
+      ImGui::Render();
+
+    return false;
+  }
+
   g_vulkan_context->WaitForPresentComplete();
 
-  VkResult res = m_swap_chain->AcquireNextImage();
-  if (res != VK_SUCCESS)
+  VkResult res = m_swap_chain->AcquireNextImage(!drop_late_frame);
+  if (res == VK_NOT_READY || res == VK_TIMEOUT)
+  {
+    // all images are queued for presentation
+    if (ImGui::GetCurrentContext())
+      ImGui::Render();
+
+    return false;
+  }
+  else if (res != VK_SUCCESS)
   {
     if (res == VK_SUBOPTIMAL_KHR || res == VK_ERROR_OUT_OF_DATE_KHR)
     {
@@ -642,7 +707,8 @@ bool VulkanHostDisplay::Render()
 
   g_vulkan_context->SubmitCommandBuffer(m_swap_chain->GetImageAvailableSemaphore(),
                                         m_swap_chain->GetRenderingFinishedSemaphore(), m_swap_chain->GetSwapChain(),
-                                        m_swap_chain->GetCurrentImageIndex(), !m_swap_chain->IsVSyncEnabled());
+                                        m_swap_chain->GetCurrentImageIndex(),
+                                        !m_swap_chain->IsVSyncEnabled() || drop_late_frame);
   g_vulkan_context->MoveToNextCommandBuffer();
 
   return true;
@@ -948,6 +1014,8 @@ bool VulkanHostDisplay::SetPostProcessingChain(const std::string_view& config)
   if (!m_post_processing_chain.CreateFromString(config))
     return false;
 
+  m_post_processing_chain.FuseStages();
+
   m_post_processing_stages.clear();
 
   FrontendCommon::PostProcessingShaderGen shadergen(HostDisplay::RenderAPI::Vulkan, false);
@@ -70,6 +70,11 @@ public:
   static AdapterAndModeList StaticGetAdapterAndModeList(const WindowInfo* wi);
 
 protected:
+  enum : u32
+  {
+    UPLOAD_STREAM_BUFFER_GRANULARITY = 4 * 1024 * 1024,
+  };
+
   struct PushConstants
   {
     float src_rect_left;
@@ -116,6 +121,12 @@ protected:
                      s32 texture_view_height, bool linear_filter);
   void RenderSoftwareCursor(s32 left, s32 top, s32 width, s32 height, HostDisplayTexture* texture_handle);
 
+  /// Reserves space for a tightly-packed upload of width*height texels in the upload stream buffer.
+  bool MapUploadBuffer(VkFormat format, u32 width, u32 height, void** out_buffer, u32* out_pitch);
+
+  /// Commits the space reserved by MapUploadBuffer(), and copies it to the texture in the current command buffer.
+  void UnmapUploadBuffer(Vulkan::Texture& texture, u32 x, u32 y, u32 width, u32 height);
+
   std::unique_ptr<Vulkan::SwapChain> m_swap_chain;
 
   VkDescriptorSetLayout m_descriptor_set_layout = VK_NULL_HANDLE;
@@ -126,7 +137,7 @@ protected:
   VkSampler m_linear_sampler = VK_NULL_HANDLE;
 
   Vulkan::Texture m_display_pixels_texture;
-  Vulkan::StagingTexture m_upload_staging_texture;
+  Vulkan::StreamBuffer m_upload_stream_buffer;
   Vulkan::StagingTexture m_readback_staging_texture;
 
   VkDescriptorSetLayout m_post_process_descriptor_set_layout = VK_NULL_HANDLE;
@@ -66,6 +66,10 @@ std::unique_ptr<CDImage> CDImage::Open(const char* filename, Common::Error* erro
   {
     return OpenM3uImage(filename, error);
   }
+  else if (StringUtil::Strcasecmp(extension, ".zip") == 0)
+  {
+    return OpenZipImage(filename, error);
+  }
 
   if (IsDeviceName(filename))
     return OpenDeviceImage(filename, error);
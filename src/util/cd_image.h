@@ -3,6 +3,7 @@
 #include "common/progress_callback.h"
 #include "common/types.h"
 #include <array>
+#include <functional>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -12,6 +13,10 @@ namespace Common {
 class Error;
 }
 
+namespace CueParser {
+class File;
+}
+
 class CDImage
 {
 public:
@@ -225,12 +230,17 @@ public:
   static std::unique_ptr<CDImage> OpenMdsImage(const char* filename, Common::Error* error);
   static std::unique_ptr<CDImage> OpenPBPImage(const char* filename, Common::Error* error);
   static std::unique_ptr<CDImage> OpenM3uImage(const char* filename, Common::Error* error);
+  static std::unique_ptr<CDImage> OpenZipImage(const char* filename, Common::Error* error);
   static std::unique_ptr<CDImage> OpenDeviceImage(const char* filename, Common::Error* error);
   static std::unique_ptr<CDImage>
   CreateMemoryImage(CDImage* image, ProgressCallback* progress = ProgressCallback::NullProgressCallback);
   static std::unique_ptr<CDImage> OverlayPPFPatch(const char* filename, std::unique_ptr<CDImage> parent_image,
                                                   ProgressCallback* progress = ProgressCallback::NullProgressCallback);
 
+  /// Sets the directory where seek indices for compressed archives are stored. If empty, indices are rebuilt every time
+  /// an archive is opened.
+  static void SetArchiveIndexDirectory(std::string directory);
+
   // Accessors.
   const std::string& GetFileName() const { return m_filename; }
   LBA GetPositionOnDisc() const { return m_position_on_disc; }
@@ -321,6 +331,15 @@ protected:
   /// Synthesis of lead-out data.
   void AddLeadOutIndex();
 
+  /// Opens a file referenced by a cue sheet. file_index is the order the file is first referenced in. Returns false if
+  /// the file could not be opened, otherwise stores the size of the file in bytes to file_size and returns true.
+  using CueSheetFileOpenCallback =
+    std::function<bool(const std::string& filename, u32 file_index, u64* file_size, Common::Error* error)>;
+
+  /// Fills in the tracks and indices from a parsed cue sheet.
+  bool LoadCueSheetTracks(const CueParser::File& parser, const char* filename,
+                          const CueSheetFileOpenCallback& open_file, Common::Error* error);
+
   std::string m_filename;
   u32 m_lba_count = 0;
 
@@ -68,6 +68,95 @@ bool CDImageCueSheet::OpenAndParse(const char* filename, Common::Error* error)
 
   m_filename = filename;
 
+  const auto open_file = [this, filename](const std::string& track_filename, u32 file_index, u64* file_size,
+                                          Common::Error* error) {
+    const std::string track_full_filename(
+      !Path::IsAbsolute(track_filename) ? Path::BuildRelativePath(m_filename, track_filename) : track_filename);
+    std::FILE* track_fp = FileSystem::OpenCFile(track_full_filename.c_str(), "rb");
+    if (!track_fp && file_index == 0)
+    {
+      // many users have bad cuesheets, or they're renamed the files without updating the cuesheet.
+      // so, try searching for a bin with the same name as the cue, but only for the first referenced file.
+      const std::string alternative_filename(Path::ReplaceExtension(filename, "bin"));
+      track_fp = FileSystem::OpenCFile(alternative_filename.c_str(), "rb");
+      if (track_fp)
+      {
+        Log_WarningPrintf("Your cue sheet references an invalid file '%s', but this was found at '%s' instead.",
+                          track_filename.c_str(), alternative_filename.c_str());
+      }
+    }
+
+    if (!track_fp)
+    {
+      Log_ErrorPrintf("Failed to open track filename '%s' (from '%s' and '%s'): errno %d", track_full_filename.c_str(),
+                      track_filename.c_str(), filename, errno);
+      if (error)
+      {
+        error->SetFormattedMessage("Failed to open track filename '%s' (from '%s' and '%s'): errno %d",
+                                   track_full_filename.c_str(), track_filename.c_str(), filename, errno);
+      }
+
+      return false;
+    }
+
+    FileSystem::FSeek64(track_fp, 0, SEEK_END);
+    *file_size = static_cast<u64>(FileSystem::FTell64(track_fp));
+    FileSystem::FSeek64(track_fp, 0, SEEK_SET);
+
+    m_files.push_back(TrackFile{track_filename, track_fp, 0});
+    return true;
+  };
+
+  if (!LoadCueSheetTracks(parser, filename, open_file, error))
+    return false;
+
+  m_sbi.LoadSBIFromImagePath(filename);
+
+  return Seek(1, Position{0, 0, 0});
+}
+
+bool CDImageCueSheet::ReadSubChannelQ(SubChannelQ* subq, const Index& index, LBA lba_in_index)
+{
+  if (m_sbi.GetReplacementSubChannelQ(index.start_lba_on_disc + lba_in_index, subq))
+    return true;
+
+  return CDImage::ReadSubChannelQ(subq, index, lba_in_index);
+}
+
+bool CDImageCueSheet::HasNonStandardSubchannel() const
+{
+  return (m_sbi.GetReplacementSectorCount() > 0);
+}
+
+bool CDImageCueSheet::ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index)
+{
+  DebugAssert(index.file_index < m_files.size());
+
+  TrackFile& tf = m_files[index.file_index];
+  const u64 file_position = index.file_offset + (static_cast<u64>(lba_in_index) * index.file_sector_size);
+  if (tf.file_position != file_position)
+  {
+    if (std::fseek(tf.file, static_cast<long>(file_position), SEEK_SET) != 0)
+      return false;
+
+    tf.file_position = file_position;
+  }
+
+  if (std::fread(buffer, index.file_sector_size, 1, tf.file) != 1)
+  {
+    std::fseek(tf.file, static_cast<long>(tf.file_position), SEEK_SET);
+    return false;
+  }
+
+  tf.file_position += index.file_sector_size;
+  return true;
+}
+
+bool CDImage::LoadCueSheetTracks(const CueParser::File& parser, const char* filename,
+                                 const CueSheetFileOpenCallback& open_file, Common::Error* error)
+{
+  // filename, size in bytes
+  std::vector<std::pair<std::string, u64>> files;
   u32 disc_lba = 0;
 
   // for each track..
@@ -81,44 +170,18 @@ bool CDImageCueSheet::OpenAndParse(const char* filename, Common::Error* error)
     LBA track_start = track->start.ToLBA();
 
     u32 track_file_index = 0;
-    for (; track_file_index < m_files.size(); track_file_index++)
+    for (; track_file_index < files.size(); track_file_index++)
     {
-      const TrackFile& t = m_files[track_file_index];
-      if (t.filename == track_filename)
+      if (files[track_file_index].first == track_filename)
         break;
     }
-    if (track_file_index == m_files.size())
+    if (track_file_index == files.size())
     {
-      const std::string track_full_filename(
-        !Path::IsAbsolute(track_filename) ? Path::BuildRelativePath(m_filename, track_filename) : track_filename);
-      std::FILE* track_fp = FileSystem::OpenCFile(track_full_filename.c_str(), "rb");
-      if (!track_fp && track_file_index == 0)
-      {
-        // many users have bad cuesheets, or they're renamed the files without updating the cuesheet.
-        // so, try searching for a bin with the same name as the cue, but only for the first referenced file.
-        const std::string alternative_filename(Path::ReplaceExtension(filename, "bin"));
-        track_fp = FileSystem::OpenCFile(alternative_filename.c_str(), "rb");
-        if (track_fp)
-        {
-          Log_WarningPrintf("Your cue sheet references an invalid file '%s', but this was found at '%s' instead.",
-                            track_filename.c_str(), alternative_filename.c_str());
-        }
-      }
-
-      if (!track_fp)
-      {
-        Log_ErrorPrintf("Failed to open track filename '%s' (from '%s' and '%s'): errno %d",
-                        track_full_filename.c_str(), track_filename.c_str(), filename, errno);
-        if (error)
-        {
-          error->SetFormattedMessage("Failed to open track filename '%s' (from '%s' and '%s'): errno %d",
-                                     track_full_filename.c_str(), track_filename.c_str(), filename, errno);
-        }
-
+      u64 file_size;
+      if (!open_file(track_filename, track_file_index, &file_size, error))
         return false;
-      }
 
-      m_files.push_back(TrackFile{std::move(track_filename), track_fp, 0});
+      files.emplace_back(track_filename, file_size);
     }
 
     // data type determines the sector size
@@ -136,11 +199,7 @@ bool CDImageCueSheet::OpenAndParse(const char* filename, Common::Error* error)
     LBA track_length;
     if (!track->length.has_value())
     {
-      FileSystem::FSeek64(m_files[track_file_index].file, 0, SEEK_END);
-      u64 file_size = static_cast<u64>(FileSystem::FTell64(m_files[track_file_index].file));
-      FileSystem::FSeek64(m_files[track_file_index].file, 0, SEEK_SET);
-
-      file_size /= track_sector_size;
+      const u64 file_size = files[track_file_index].second / track_sector_size;
       if (track_start >= file_size)
       {
         Log_ErrorPrintf("Failed to open track %u in '%s': track start is out of range (%u vs %" PRIu64 ")", track_num,
@@ -288,45 +347,6 @@ bool CDImageCueSheet::OpenAndParse(const char* filename, Common::Error* error)
   m_lba_count = disc_lba;
   AddLeadOutIndex();
 
-  m_sbi.LoadSBIFromImagePath(filename);
-
-  return Seek(1, Position{0, 0, 0});
-}
-
-bool CDImageCueSheet::ReadSubChannelQ(SubChannelQ* subq, const Index& index, LBA lba_in_index)
-{
-  if (m_sbi.GetReplacementSubChannelQ(index.start_lba_on_disc + lba_in_index, subq))
-    return true;
-
-  return CDImage::ReadSubChannelQ(subq, index, lba_in_index);
-}
-
-bool CDImageCueSheet::HasNonStandardSubchannel() const
-{
-  return (m_sbi.GetReplacementSectorCount() > 0);
-}
-
-bool CDImageCueSheet::ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index)
-{
-  DebugAssert(index.file_index < m_files.size());
-
-  TrackFile& tf = m_files[index.file_index];
-  const u64 file_position = index.file_offset + (static_cast<u64>(lba_in_index) * index.file_sector_size);
-  if (tf.file_position != file_position)
-  {
-    if (std::fseek(tf.file, static_cast<long>(file_position), SEEK_SET) != 0)
-      return false;
-
-    tf.file_position = file_position;
-  }
-
-  if (std::fread(buffer, index.file_sector_size, 1, tf.file) != 1)
-  {
-    std::fseek(tf.file, static_cast<long>(tf.file_position), SEEK_SET);
-    return false;
-  }
-
-  tf.file_position += index.file_sector_size;
   return true;
 }
 
@@ -0,0 +1,765 @@
+#include "cd_image.h"
+#include "common/assert.h"
+#include "common/error.h"
+#include "common/file_system.h"
+#include "common/log.h"
+#include "common/minizip_helpers.h"
+#include "common/path.h"
+#include "common/string_util.h"
+#include "cue_parser.h"
+#include "zlib.h"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cinttypes>
+#include <cstring>
+#include <optional>
+#include <vector>
+Log_SetChannel(CDImageZip);
+
+static std::string s_archive_index_directory;
+
+void CDImage::SetArchiveIndexDirectory(std::string directory)
+{
+  s_archive_index_directory = std::move(directory);
+}
+
+namespace {
+
+class CDImageZip final : public CDImage
+{
+public:
+  CDImageZip();
+  ~CDImageZip() override;
+
+  bool Open(const char* filename, Common::Error* error);
+
+protected:
+  bool ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index) override;
+
+private:
+  enum : u32
+  {
+    // Uncompressed distance between seek points, which is also the size of the chunks we decompress.
+    SEEK_POINT_SPAN = 2 * 1024 * 1024,
+
+    // Deflate window, which has to be restored to resume decompression at a seek point.
+    WINDOW_SIZE = 32768,
+
+    INPUT_BUFFER_SIZE = 64 * 1024,
+    MAX_CACHED_CHUNKS = 8,
+
+    INDEX_FILE_MAGIC = 0x58495A44, // DZIX
+    INDEX_FILE_VERSION = 1,
+  };
+
+  struct SeekPoint
+  {
+    u64 in;  // offset in the compressed data of the first full byte after a deflate block boundary
+    u64 out; // offset in the uncompressed data
+    u8 bits; // number of bits from the byte before in, if the boundary isn't byte aligned
+    std::vector<u8> window; // zlib-compressed copy of the preceding window, empty for the start of the stream
+  };
+
+  struct ArchiveFile
+  {
+    std::string name;
+    u64 data_offset;
+    u64 compressed_size;
+    u64 uncompressed_size;
+    u32 crc32;
+    bool deflated;
+
+    // Built as the file is read, unless it was loaded from the index directory. index_crc32 covers the data up to the
+    // last seek point, so the file can still be verified once the end is reached.
+    std::vector<SeekPoint> seek_points;
+    u32 index_crc32;
+    bool index_complete;
+  };
+
+  struct Chunk
+  {
+    u32 file_index;
+    u32 point_index;
+    u64 last_used;
+    std::vector<u8> data;
+  };
+
+  struct IndexFileHeader
+  {
+    u32 magic;
+    u32 version;
+    u32 crc32;
+    u32 span;
+    u64 compressed_size;
+    u64 uncompressed_size;
+    u32 num_points;
+    u32 reserved;
+  };
+
+  bool ScanArchive(const char* filename, Common::Error* error);
+  bool OpenArchiveFile(const std::string& name, u32* file_index, u64* file_size);
+  std::optional<u32> FindEntry(const std::string& name) const;
+
+  void LoadOrStartIndex(ArchiveFile& af);
+  bool ExtendIndex(ArchiveFile& af, u64 offset);
+  bool LoadIndex(ArchiveFile& af, const std::string& path);
+  void SaveIndex(const ArchiveFile& af, const std::string& path);
+  std::string GetIndexPath(const ArchiveFile& af) const;
+
+  bool ReadFileData(u32 file_index, u64 offset, void* buffer, u32 size);
+  const Chunk* GetChunk(u32 file_index, u32 point_index);
+  bool DecompressChunk(const ArchiveFile& af, u32 point_index, std::vector<u8>& data);
+
+  std::FILE* m_fp = nullptr;
+
+  // all entries in the archive, and the ones which the image references
+  std::vector<ArchiveFile> m_entries;
+  std::vector<ArchiveFile> m_files;
+
+  std::vector<Chunk> m_chunks;
+  u64 m_chunk_counter = 0;
+
+  z_stream m_inflate_stream = {};
+  bool m_inflate_stream_initialized = false;
+  std::array<u8, INPUT_BUFFER_SIZE> m_input_buffer;
+};
+
+} // namespace
+
+CDImageZip::CDImageZip() = default;
+
+CDImageZip::~CDImageZip()
+{
+  if (m_inflate_stream_initialized)
+    inflateEnd(&m_inflate_stream);
+
+  if (m_fp)
+    std::fclose(m_fp);
+}
+
+bool CDImageZip::Open(const char* filename, Common::Error* error)
+{
+  m_filename = filename;
+  if (!ScanArchive(filename, error))
+    return false;
+
+  m_fp = FileSystem::OpenCFile(filename, "rb");
+  if (!m_fp)
+  {
+    Log_ErrorPrintf("Failed to open '%s': errno %d", filename, errno);
+    if (error)
+      error->SetErrno(errno);
+
+    return false;
+  }
+
+  if (inflateInit2(&m_inflate_stream, -MAX_WBITS) != Z_OK)
+  {
+    Log_ErrorPrintf("inflateInit2() failed");
+    if (error)
+      error->SetMessage("Failed to initialize decompressor");
+
+    return false;
+  }
+  m_inflate_stream_initialized = true;
+
+  // Prefer a cue sheet, otherwise the largest single track image.
+  std::string cue_name;
+  std::string bin_name;
+  u64 bin_size = 0;
+  for (const ArchiveFile& af : m_entries)
+  {
+    if (StringUtil::EndsWithNoCase(af.name, ".cue"))
+    {
+      if (cue_name.empty())
+        cue_name = af.name;
+    }
+    else if ((StringUtil::EndsWithNoCase(af.name, ".bin") || StringUtil::EndsWithNoCase(af.name, ".img") ||
+              StringUtil::EndsWithNoCase(af.name, ".iso")) &&
+             af.uncompressed_size > bin_size)
+    {
+      bin_name = af.name;
+      bin_size = af.uncompressed_size;
+    }
+  }
+
+  std::string cue_directory;
+  std::string cue_data;
+  if (!cue_name.empty())
+  {
+    u32 cue_index;
+    u64 cue_size;
+    if (!OpenArchiveFile(cue_name, &cue_index, &cue_size) || cue_size > (1024 * 1024))
+    {
+      Log_ErrorPrintf("Failed to read cue sheet '%s' from '%s'", cue_name.c_str(), filename);
+      if (error)
+        error->SetFormattedMessage("Failed to read cue sheet '%s' from '%s'", cue_name.c_str(), filename);
+
+      return false;
+    }
+
+    cue_data.resize(static_cast<size_t>(cue_size));
+    if (cue_size > 0 && !ReadFileData(cue_index, 0, cue_data.data(), static_cast<u32>(cue_size)))
+    {
+      Log_ErrorPrintf("Failed to decompress cue sheet '%s' from '%s'", cue_name.c_str(), filename);
+      if (error)
+        error->SetFormattedMessage("Failed to decompress cue sheet '%s' from '%s'", cue_name.c_str(), filename);
+
+      return false;
+    }
+
+    // the cue sheet isn't part of the disc, so don't keep it around
+    m_files.clear();
+    m_chunks.clear();
+
+    const std::string::size_type pos = cue_name.rfind('/');
+    if (pos != std::string::npos)
+      cue_directory = cue_name.substr(0, pos + 1);
+  }
+  else if (!bin_name.empty())
+  {
+    // same layout as a standalone bin file
+    cue_data = StringUtil::StdStringFromFormat("FILE \"%s\" BINARY\nTRACK 01 MODE2/2352\nINDEX 01 00:00:00\n",
+                                               bin_name.c_str());
+  }
+  else
+  {
+    Log_ErrorPrintf("No disc image found in '%s'", filename);
+    if (error)
+      error->SetFormattedMessage("No disc image found in '%s'", filename);
+
+    return false;
+  }
+
+  CueParser::File parser;
+  if (!parser.Parse(cue_data, error))
+    return false;
+
+  const auto open_file = [this, &cue_directory, &cue_name, error](const std::string& track_filename, u32 file_index,
+                                                                  u64* file_size, Common::Error*) {
+    // Paths in the cue sheet are relative to it. Entries in zips always use forward slashes.
+    std::string entry_name(cue_directory);
+    entry_name += track_filename;
+    std::replace(entry_name.begin(), entry_name.end(), '\\', '/');
+
+    u32 opened_index;
+    if (OpenArchiveFile(entry_name, &opened_index, file_size) ||
+        (file_index == 0 && !cue_name.empty() &&
+         OpenArchiveFile(Path::ReplaceExtension(cue_name, "bin"), &opened_index, file_size)))
+    {
+      DebugAssert(opened_index == file_index);
+      LoadOrStartIndex(m_files[opened_index]);
+      return true;
+    }
+
+    Log_ErrorPrintf("Track file '%s' was not found in '%s'", entry_name.c_str(), m_filename.c_str());
+    if (error)
+      error->SetFormattedMessage("Track file '%s' was not found in '%s'", entry_name.c_str(), m_filename.c_str());
+
+    return false;
+  };
+
+  if (!LoadCueSheetTracks(parser, filename, open_file, error))
+    return false;
+
+  return Seek(1, Position{0, 0, 0});
+}
+
+bool CDImageZip::ScanArchive(const char* filename, Common::Error* error)
+{
+  unzFile zf = MinizipHelpers::OpenUnzFile(filename);
+  if (!zf)
+  {
+    Log_ErrorPrintf("Failed to open archive '%s'", filename);
+    if (error)
+      error->SetFormattedMessage("Failed to open archive '%s'", filename);
+
+    return false;
+  }
+
+  for (int res = unzGoToFirstFile(zf); res == UNZ_OK; res = unzGoToNextFile(zf))
+  {
+    unz_file_info64 info;
+    char name[512];
+    if (unzGetCurrentFileInfo64(zf, &info, name, sizeof(name), nullptr, 0, nullptr, 0) != UNZ_OK)
+      break;
+
+    // skip directories, encrypted files and anything we can't decompress ourselves
+    const size_t name_length = std::strlen(name);
+    if (name_length == 0 || name[name_length - 1] == '/' || (info.flag & 1) != 0 ||
+        (info.compression_method != 0 && info.compression_method != Z_DEFLATED))
+    {
+      continue;
+    }
+
+    // the local header has a variable length, so let minizip find the start of the data
+    if (unzOpenCurrentFile2(zf, nullptr, nullptr, 1) != UNZ_OK)
+      continue;
+
+    ArchiveFile af;
+    af.name = name;
+    af.data_offset = unzGetCurrentFileZStreamPos64(zf);
+    af.compressed_size = info.compressed_size;
+    af.uncompressed_size = info.uncompressed_size;
+    af.crc32 = static_cast<u32>(info.crc);
+    af.deflated = (info.compression_method == Z_DEFLATED);
+    af.index_crc32 = 0;
+    af.index_complete = true;
+    unzCloseCurrentFile(zf);
+
+    m_entries.push_back(std::move(af));
+  }
+
+  unzClose(zf);
+  return true;
+}
+
+std::optional<u32> CDImageZip::FindEntry(const std::string& name) const
+{
+  for (u32 i = 0; i < static_cast<u32>(m_entries.size()); i++)
+  {
+    if (m_entries[i].name == name)
+      return i;
+  }
+
+  // fall back to a case-insensitive match, cue sheets created on Windows often have the wrong case
+  for (u32 i = 0; i < static_cast<u32>(m_entries.size()); i++)
+  {
+    if (StringUtil::Strcasecmp(m_entries[i].name.c_str(), name.c_str()) == 0)
+      return i;
+  }
+
+  return std::nullopt;
+}
+
+bool CDImageZip::OpenArchiveFile(const std::string& name, u32* file_index, u64* file_size)
+{
+  const std::optional<u32> entry = FindEntry(name);
+  if (!entry.has_value())
+    return false;
+
+  *file_index = static_cast<u32>(m_files.size());
+  *file_size = m_entries[entry.value()].uncompressed_size;
+  m_files.push_back(m_entries[entry.value()]);
+
+  // small files don't need an index, the start of the stream is enough
+  ArchiveFile& af = m_files.back();
+  if (af.deflated && af.uncompressed_size <= SEEK_POINT_SPAN)
+    af.seek_points.push_back(SeekPoint{0, 0, 0, {}});
+
+  return true;
+}
+
+std::string CDImageZip::GetIndexPath(const ArchiveFile& af) const
+{
+  if (s_archive_index_directory.empty())
+    return {};
+
+  // keyed by content rather than path, so renaming or moving the archive doesn't invalidate the index
+  return Path::Combine(s_archive_index_directory,
+                       StringUtil::StdStringFromFormat("%08X-%016" PRIX64 "-%016" PRIX64 ".idx", af.crc32,
+                                                       af.compressed_size, af.uncompressed_size));
+}
+
+void CDImageZip::LoadOrStartIndex(ArchiveFile& af)
+{
+  if (!af.deflated || !af.seek_points.empty())
+    return;
+
+  const std::string index_path(GetIndexPath(af));
+  if (!index_path.empty() && LoadIndex(af, index_path))
+    return;
+
+  // the rest of the index is built as the file is read
+  af.seek_points.push_back(SeekPoint{0, 0, 0, {}});
+  af.index_crc32 = static_cast<u32>(crc32(0L, Z_NULL, 0));
+  af.index_complete = false;
+}
+
+bool CDImageZip::ExtendIndex(ArchiveFile& af, u64 offset)
+{
+  // Decompress from the last seek point, remembering the decompressor state at block boundaries roughly every span
+  // bytes, until there's a seek point past the offset or the end of the file is reached. That way only the part of the
+  // file which is read gets decompressed, e.g. the first few sectors when scanning the game list.
+  const SeekPoint start_point = af.seek_points.back();
+  std::vector<u8> window(WINDOW_SIZE);
+  std::vector<u8> point_window(WINDOW_SIZE);
+  u64 total_in = start_point.in;
+  u64 total_out = start_point.out;
+  u64 last_point_out = start_point.out;
+  u32 crc = af.index_crc32;
+
+  z_stream& strm = m_inflate_stream;
+  inflateReset(&strm);
+  strm.avail_in = 0;
+  strm.avail_out = 0;
+
+  const u64 start_in = start_point.in - (start_point.bits ? 1 : 0);
+  FileSystem::FSeek64(m_fp, static_cast<s64>(af.data_offset + start_in), SEEK_SET);
+  u64 compressed_remaining = af.compressed_size - start_in;
+  if (start_point.bits)
+  {
+    const int value = std::fgetc(m_fp);
+    if (value == EOF)
+      return false;
+
+    compressed_remaining--;
+    inflatePrime(&strm, start_point.bits, value >> (8 - start_point.bits));
+  }
+
+  if (!start_point.window.empty())
+  {
+    uLongf window_size = WINDOW_SIZE;
+    if (uncompress(window.data(), &window_size, start_point.window.data(),
+                   static_cast<uLong>(start_point.window.size())) != Z_OK ||
+        window_size != WINDOW_SIZE || inflateSetDictionary(&strm, window.data(), WINDOW_SIZE) != Z_OK)
+    {
+      Log_ErrorPrintf("Corrupted seek point %zu in '%s'", af.seek_points.size() - 1, af.name.c_str());
+      return false;
+    }
+  }
+
+  int ret = Z_OK;
+  bool passed_offset = false;
+  do
+  {
+    // Z_BLOCK stops at the end of the final block, so the end of the stream may be reported without any input left.
+    if (strm.avail_in == 0 && compressed_remaining > 0)
+    {
+      const u32 size = static_cast<u32>(std::min<u64>(compressed_remaining, m_input_buffer.size()));
+      if (std::fread(m_input_buffer.data(), size, 1, m_fp) != 1)
+      {
+        ret = Z_ERRNO;
+        break;
+      }
+
+      compressed_remaining -= size;
+      strm.next_in = m_input_buffer.data();
+      strm.avail_in = size;
+    }
+    else if (strm.avail_in == 0 && ret == Z_BUF_ERROR)
+    {
+      // truncated stream
+      break;
+    }
+
+    do
+    {
+      if (strm.avail_out == 0)
+      {
+        strm.next_out = window.data();
+        strm.avail_out = WINDOW_SIZE;
+      }
+
+      Bytef* const out_start = strm.next_out;
+      total_in += strm.avail_in;
+      total_out += strm.avail_out;
+      ret = inflate(&strm, Z_BLOCK);
+      total_in -= strm.avail_in;
+      total_out -= strm.avail_out;
+      crc = static_cast<u32>(crc32(crc, out_start, static_cast<uInt>(strm.next_out - out_start)));
+      if (ret == Z_NEED_DICT || ret == Z_MEM_ERROR || ret == Z_DATA_ERROR)
+        break;
+      if (ret == Z_STREAM_END)
+        break;
+
+      // at the end of a block which isn't the last?
+      if ((strm.data_type & 128) && !(strm.data_type & 64) && (total_out - last_point_out) > SEEK_POINT_SPAN)
+      {
+        // the window is circular, so unroll it
+        const u32 left = strm.avail_out;
+        if (left > 0)
+          std::memcpy(point_window.data(), window.data() + WINDOW_SIZE - left, left);
+        if (left < WINDOW_SIZE)
+          std::memcpy(point_window.data() + left, window.data(), WINDOW_SIZE - left);
+
+        SeekPoint sp;
+        sp.in = total_in;
+        sp.out = total_out;
+        sp.bits = static_cast<u8>(strm.data_type & 7);
+        uLongf compressed_length = compressBound(WINDOW_SIZE);
+        sp.window.resize(compressed_length);
+        if (compress2(sp.window.data(), &compressed_length, point_window.data(), WINDOW_SIZE, Z_BEST_SPEED) != Z_OK)
+        {
+          ret = Z_MEM_ERROR;
+          break;
+        }
+        sp.window.resize(compressed_length);
+        af.seek_points.push_back(std::move(sp));
+        af.index_crc32 = crc;
+        last_point_out = total_out;
+        if (total_out > offset)
+        {
+          passed_offset = true;
+          break;
+        }
+      }
+    } while (strm.avail_in != 0);
+  } while (!passed_offset && (ret == Z_OK || ret == Z_BUF_ERROR));
+
+  if (passed_offset)
+    return true;
+
+  if (ret != Z_STREAM_END || total_out != af.uncompressed_size || crc != af.crc32)
+  {
+    Log_ErrorPrintf("Failed to decompress '%s' from '%s' (%d)", af.name.c_str(), m_filename.c_str(), ret);
+    return false;
+  }
+
+  af.index_complete = true;
+  Log_InfoPrintf("Indexed '%s' with %zu seek points", af.name.c_str(), af.seek_points.size());
+
+  const std::string index_path(GetIndexPath(af));
+  if (!index_path.empty())
+    SaveIndex(af, index_path);
+
+  return true;
+}
+
+bool CDImageZip::LoadIndex(ArchiveFile& af, const std::string& path)
+{
+  std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(path.c_str());
+  if (!data.has_value() || data->size() < sizeof(IndexFileHeader))
+    return false;
+
+  IndexFileHeader header;
+  std::memcpy(&header, data->data(), sizeof(header));
+  if (header.magic != INDEX_FILE_MAGIC || header.version != INDEX_FILE_VERSION || header.crc32 != af.crc32 ||
+      header.span != SEEK_POINT_SPAN || header.compressed_size != af.compressed_size ||
+      header.uncompressed_size != af.uncompressed_size || header.num_points == 0)
+  {
+    Log_WarningPrintf("Index '%s' does not match '%s', rebuilding", path.c_str(), af.name.c_str());
+    return false;
+  }
+
+  size_t pos = sizeof(header);
+  std::vector<SeekPoint> points;
+  points.reserve(header.num_points);
+  for (u32 i = 0; i < header.num_points; i++)
+  {
+    SeekPoint sp;
+    u32 window_size;
+    if ((pos + sizeof(sp.in) + sizeof(sp.out) + sizeof(sp.bits) + sizeof(window_size)) > data->size())
+      return false;
+
+    std::memcpy(&sp.in, data->data() + pos, sizeof(sp.in));
+    pos += sizeof(sp.in);
+    std::memcpy(&sp.out, data->data() + pos, sizeof(sp.out));
+    pos += sizeof(sp.out);
+    std::memcpy(&sp.bits, data->data() + pos, sizeof(sp.bits));
+    pos += sizeof(sp.bits);
+    std::memcpy(&window_size, data->data() + pos, sizeof(window_size));
+    pos += sizeof(window_size);
+    if ((pos + window_size) > data->size() || sp.in > af.compressed_size || sp.out > af.uncompressed_size ||
+        sp.bits > 7 || (!points.empty() && sp.out <= points.back().out))
+    {
+      return false;
+    }
+
+    sp.window.assign(data->data() + pos, data->data() + pos + window_size);
+    pos += window_size;
+    points.push_back(std::move(sp));
+  }
+
+  af.seek_points = std::move(points);
+  af.index_complete = true;
+  return true;
+}
+
+void CDImageZip::SaveIndex(const ArchiveFile& af, const std::string& path)
+{
+  std::vector<u8> data(sizeof(IndexFileHeader));
+  const IndexFileHeader header = {INDEX_FILE_MAGIC,
+                                  INDEX_FILE_VERSION,
+                                  af.crc32,
+                                  SEEK_POINT_SPAN,
+                                  af.compressed_size,
+                                  af.uncompressed_size,
+                                  static_cast<u32>(af.seek_points.size()),
+                                  0};
+  std::memcpy(data.data(), &header, sizeof(header));
+
+  for (const SeekPoint& sp : af.seek_points)
+  {
+    const u32 window_size = static_cast<u32>(sp.window.size());
+    const size_t pos = data.size();
+    data.resize(pos + sizeof(sp.in) + sizeof(sp.out) + sizeof(sp.bits) + sizeof(window_size) + window_size);
+
+    u8* ptr = data.data() + pos;
+    std::memcpy(ptr, &sp.in, sizeof(sp.in));
+    ptr += sizeof(sp.in);
+    std::memcpy(ptr, &sp.out, sizeof(sp.out));
+    ptr += sizeof(sp.out);
+    std::memcpy(ptr, &sp.bits, sizeof(sp.bits));
+    ptr += sizeof(sp.bits);
+    std::memcpy(ptr, &window_size, sizeof(window_size));
+    ptr += sizeof(window_size);
+    if (window_size > 0)
+      std::memcpy(ptr, sp.window.data(), window_size);
+  }
+
+  if (!FileSystem::WriteBinaryFile(path.c_str(), data.data(), data.size()))
+    Log_WarningPrintf("Failed to write archive index '%s'", path.c_str());
+}
+
+bool CDImageZip::DecompressChunk(const ArchiveFile& af, u32 point_index, std::vector<u8>& data)
+{
+  const SeekPoint& sp = af.seek_points[point_index];
+  const u64 end_out =
+    ((point_index + 1) < af.seek_points.size()) ? af.seek_points[point_index + 1].out : af.uncompressed_size;
+  data.resize(static_cast<size_t>(end_out - sp.out));
+
+  z_stream& strm = m_inflate_stream;
+  inflateReset(&strm);
+
+  const u64 start_in = sp.in - (sp.bits ? 1 : 0);
+  if (FileSystem::FSeek64(m_fp, static_cast<s64>(af.data_offset + start_in), SEEK_SET) != 0)
+    return false;
+
+  u64 compressed_remaining = af.compressed_size - start_in;
+  if (sp.bits)
+  {
+    const int value = std::fgetc(m_fp);
+    if (value == EOF)
+      return false;
+
+    compressed_remaining--;
+    inflatePrime(&strm, sp.bits, value >> (8 - sp.bits));
+  }
+
+  if (!sp.window.empty())
+  {
+    std::array<u8, WINDOW_SIZE> window;
+    uLongf window_size = WINDOW_SIZE;
+    if (uncompress(window.data(), &window_size, sp.window.data(), static_cast<uLong>(sp.window.size())) != Z_OK ||
+        window_size != WINDOW_SIZE || inflateSetDictionary(&strm, window.data(), WINDOW_SIZE) != Z_OK)
+    {
+      Log_ErrorPrintf("Corrupted seek point %u in '%s'", point_index, af.name.c_str());
+      return false;
+    }
+  }
+
+  strm.next_in = nullptr;
+  strm.avail_in = 0;
+  strm.next_out = data.data();
+  strm.avail_out = static_cast<uInt>(data.size());
+  while (strm.avail_out > 0)
+  {
+    if (strm.avail_in == 0)
+    {
+      const u32 size = static_cast<u32>(std::min<u64>(compressed_remaining, m_input_buffer.size()));
+      if (size == 0 || std::fread(m_input_buffer.data(), size, 1, m_fp) != 1)
+        return false;
+
+      compressed_remaining -= size;
+      strm.next_in = m_input_buffer.data();
+      strm.avail_in = size;
+    }
+
+    const int ret = inflate(&strm, Z_NO_FLUSH);
+    if (ret == Z_STREAM_END)
+      break;
+    if (ret != Z_OK && ret != Z_BUF_ERROR)
+    {
+      Log_ErrorPrintf("inflate() failed in '%s' at seek point %u: %d", af.name.c_str(), point_index, ret);
+      return false;
+    }
+  }
+
+  return (strm.avail_out == 0);
+}
+
+const CDImageZip::Chunk* CDImageZip::GetChunk(u32 file_index, u32 point_index)
+{
+  for (Chunk& chunk : m_chunks)
+  {
+    if (chunk.file_index == file_index && chunk.point_index == point_index)
+    {
+      chunk.last_used = ++m_chunk_counter;
+      return &chunk;
+    }
+  }
+
+  // evict the least recently used chunk, reusing its buffer
+  Chunk* chunk;
+  if (m_chunks.size() < MAX_CACHED_CHUNKS)
+  {
+    chunk = &m_chunks.emplace_back();
+  }
+  else
+  {
+    chunk = &*std::min_element(m_chunks.begin(), m_chunks.end(),
+                               [](const Chunk& lhs, const Chunk& rhs) { return lhs.last_used < rhs.last_used; });
+  }
+
+  if (!DecompressChunk(m_files[file_index], point_index, chunk->data))
+  {
+    // don't leave a partially decompressed chunk in the cache
+    chunk->file_index = static_cast<u32>(m_files.size());
+    chunk->last_used = 0;
+    return nullptr;
+  }
+
+  chunk->file_index = file_index;
+  chunk->point_index = point_index;
+  chunk->last_used = ++m_chunk_counter;
+  return chunk;
+}
+
+bool CDImageZip::ReadFileData(u32 file_index, u64 offset, void* buffer, u32 size)
+{
+  ArchiveFile& af = m_files[file_index];
+  if ((offset + size) > af.uncompressed_size)
+    return false;
+
+  if (!af.deflated)
+  {
+    return (FileSystem::FSeek64(m_fp, static_cast<s64>(af.data_offset + offset), SEEK_SET) == 0 &&
+            std::fread(buffer, size, 1, m_fp) == 1);
+  }
+
+  u8* dst = static_cast<u8*>(buffer);
+  while (size > 0)
+  {
+    // the last chunk of an incomplete index would run to the end of the file
+    if (!af.index_complete && offset >= af.seek_points.back().out && !ExtendIndex(af, offset))
+      return false;
+
+    // last seek point at or before the offset
+    const auto it = std::upper_bound(af.seek_points.begin(), af.seek_points.end(), offset,
+                                     [](u64 value, const SeekPoint& sp) { return value < sp.out; });
+    DebugAssert(it != af.seek_points.begin());
+    const u32 point_index = static_cast<u32>(std::distance(af.seek_points.begin(), it) - 1);
+
+    const Chunk* chunk = GetChunk(file_index, point_index);
+    if (!chunk)
+      return false;
+
+    const u64 offset_in_chunk = offset - af.seek_points[point_index].out;
+    const u32 copy_size = static_cast<u32>(std::min<u64>(size, chunk->data.size() - offset_in_chunk));
+    std::memcpy(dst, chunk->data.data() + offset_in_chunk, copy_size);
+    dst += copy_size;
+    offset += copy_size;
+    size -= copy_size;
+  }
+
+  return true;
+}
+
+bool CDImageZip::ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index)
+{
+  DebugAssert(index.file_index < m_files.size());
+
+  const u64 file_position = index.file_offset + (static_cast<u64>(lba_in_index) * index.file_sector_size);
+  return ReadFileData(index.file_index, file_position, buffer, index.file_sector_size);
+}
+
+std::unique_ptr<CDImage> CDImage::OpenZipImage(const char* filename, Common::Error* error)
+{
+  std::unique_ptr<CDImageZip> image = std::make_unique<CDImageZip>();
+  if (!image->Open(filename, error))
+    return {};
+
+  return image;
+}
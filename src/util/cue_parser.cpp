@@ -2,7 +2,9 @@
 #include "common/error.h"
 #include "common/log.h"
 #include "common/string_util.h"
+#include <algorithm>
 #include <cstdarg>
+#include <cstring>
 Log_SetChannel(CueParser);
 
 namespace CueParser {
@@ -54,6 +56,36 @@ bool File::Parse(std::FILE* fp, Common::Error* error)
     line_number++;
   }
 
+  return CompleteParse(line_number, error);
+}
+
+bool File::Parse(const std::string_view& data, Common::Error* error)
+{
+  char line[1024];
+  u32 line_number = 1;
+  for (size_t pos = 0; pos < data.size();)
+  {
+    size_t line_end = data.find('\n', pos);
+    if (line_end == std::string_view::npos)
+      line_end = data.size();
+
+    // same truncation as fgets() for overly long lines
+    const size_t line_length = std::min<size_t>(line_end - pos, sizeof(line) - 1);
+    std::memcpy(line, data.data() + pos, line_length);
+    line[line_length] = '\0';
+    pos = line_end + 1;
+
+    if (!ParseLine(line, line_number, error))
+      return false;
+
+    line_number++;
+  }
+
+  return CompleteParse(line_number, error);
+}
+
+bool File::CompleteParse(u32 line_number, Common::Error* error)
+{
   if (!CompleteLastTrack(line_number, error))
     return false;
 
@@ -58,6 +58,7 @@ public:
   const Track* GetTrack(u32 n) const;
 
   bool Parse(std::FILE* fp, Common::Error* error);
+  bool Parse(const std::string_view& data, Common::Error* error);
 
 private:
   Track* GetMutableTrack(u32 n);
@@ -68,6 +69,7 @@ private:
   static std::optional<MSF> GetMSF(const std::string_view& token);
 
   bool ParseLine(const char* line, u32 line_number, Common::Error* error);
+  bool CompleteParse(u32 line_number, Common::Error* error);
 
   bool HandleFileCommand(const char* line, u32 line_number, Common::Error* error);
   bool HandleTrackCommand(const char* line, u32 line_number, Common::Error* error);